@@ -0,0 +1,73 @@
+// Writes a generated table with ofstream and with JsonFileWriter, in both styles, and prints
+// the best time of several runs and the file size. Usage: jsonFileWriterBench [rows] [runs]
+#include "storageManager/jsonFileWriter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+json makeRows(size_t count) {
+    json rows = json::array();
+    for (size_t i = 0; i < count; ++i) {
+        rows.push_back({
+            {"id", i + 1},
+            {"name", "user" + std::to_string(i)},
+            {"email", "user" + std::to_string(i) + "@example.com"},
+            {"score", static_cast<long long>(i % 1000)}
+        });
+    }
+    return rows;
+}
+
+void measure(const std::string& label, const std::string& path, int runs, const std::function<bool()>& write) {
+    double best = 0;
+    for (int run = 0; run < runs; ++run) {
+        auto start = std::chrono::steady_clock::now();
+        if (!write()) {
+            std::cerr << label << ": write failed" << std::endl;
+            return;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (run == 0 || ms < best) {
+            best = ms;
+        }
+    }
+    double megabytes = static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+    std::printf("%-24s %8.1f ms %8.1f MB\n", label.c_str(), best, megabytes);
+}
+
+}
+
+int main(int argc, char** argv) {
+    size_t rowCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 200000;
+    int runs = argc > 2 ? std::atoi(argv[2]) : 5;
+    json rows = makeRows(rowCount);
+    std::string path = (std::filesystem::temp_directory_path() / "jsonFileWriterBench.json").string();
+
+    std::printf("%zu rows, best of %d\n", rowCount, runs);
+    measure("ofstream << setw(4)", path, runs, [&] {
+        std::ofstream file(path, std::ios::trunc);
+        file << std::setw(4) << rows << '\n';
+        return static_cast<bool>(file);
+    });
+    measure("ofstream << compact", path, runs, [&] {
+        std::ofstream file(path, std::ios::trunc);
+        file << rows << '\n';
+        return static_cast<bool>(file);
+    });
+    measure("JsonFileWriter pretty", path, runs, [&] {
+        return JsonFileWriter::writeFile(path, rows, JsonStyle::PRETTY);
+    });
+    measure("JsonFileWriter compact", path, runs, [&] {
+        return JsonFileWriter::writeFile(path, rows, JsonStyle::COMPACT);
+    });
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -14,6 +14,14 @@
 #include "commands/metacommands/viewAllDatabasePermissionsCommand/headers/viewAllDatabasePermissionsCommand.h"
 #include "commands/metacommands/deleteDatabaseCommand/headers/deleteDatabaseCommand.h"
 #include "commands/metacommands/useDatabaseCommand/headers/useDatabaseCommand.h"
+#include "commands/metacommands/setStorageCommand/headers/setStorageCommand.h"
+#include "commands/metacommands/setBufferPoolCommand/headers/setBufferPoolCommand.h"
+#include "commands/metacommands/setJsonStyleCommand/headers/setJsonStyleCommand.h"
+#include "commands/metacommands/setCompactionCommand/headers/setCompactionCommand.h"
+#include "commands/metacommands/setFilterKernelCommand/headers/setFilterKernelCommand.h"
+#include "commands/metacommands/setLogCommand/headers/setLogCommand.h"
+#include "commands/metacommands/importCommand/headers/importCommand.h"
+#include "commands/metacommands/exportCommand/headers/exportCommand.h"
 
 #include "commands/sqlcommands/selectCommand/headers/selectCommand.h"
 #include "commands/sqlcommands/insertCommand/headers/insertCommand.h"
@@ -23,6 +31,9 @@
 #include "commands/sqlcommands/dropTableCommand/headers/dropTableCommand.h"
 #include "commands/sqlcommands/showTablesCommand/headers/showTablesCommand.h"
 #include "commands/sqlcommands/updateCommand/headers/updateCommand.h"
+#include "commands/sqlcommands/vacuumCommand/headers/vacuumCommand.h"
+#include "commands/sqlcommands/prepareCommand/headers/prepareCommand.h"
+#include "commands/sqlcommands/executeCommand/headers/executeCommand.h"
 
 
 CommandFactory::CommandFactory(std::string& currentUser, std::string& currentDatabase)
@@ -34,6 +45,18 @@ CommandFactory::CommandFactory(std::string& currentUser, std::string& currentDat
 
     metaCommandFuture.get();
     sqlCommandFuture.get();
+    buildCommandTrie();
+}
+
+// Primary names go in first, so an alias spelled like its command in another case does
+// not replace the registered name.
+void CommandFactory::buildCommandTrie() {
+    for (const auto& commandName : primaryCommands) {
+        commandTrie.insert(commandName, commands.at(commandName));
+    }
+    for (const auto& [commandName, command] : commands) {
+        commandTrie.insert(commandName, command);
+    }
 }
 
 void CommandFactory::checkAndCreateFileSystem() const {
@@ -68,6 +91,12 @@ void CommandFactory::checkAndCreateFileSystem() const {
             newFile.close();
         }
     }
+
+    INIT_DB_MANAGER
+    dbManager.loadJsonStyle();
+    INIT_SQL_MANAGER
+    sqlManager.migrateLegacyDatabaseFiles();
+    sqlManager.normalizeStoredStrings();
 }
 void CommandFactory::registerCommandAsync(const std::string& name, std::shared_ptr<Command> command, const std::string& description, const std::vector<std::string>& aliases) {
     std::async(std::launch::async, &CommandFactory::registerCommand, this, name, command, description, aliases);
@@ -90,7 +119,15 @@ void CommandFactory::registerMetaCommands(std::string& currentUser, std::string&
         {".remove permission", std::make_shared<RemovePermissionCommand>(currentUser), "Remove permission from database, .remove permission <databaseName> <username> <permission>", {".rm p"}},
         {".view database permissions", std::make_shared<ViewAllDatabasePermissionsCommand>(currentUser), "View permissions for database, .view database permissions <databaseName>", {".ls db p"}},
         {".delete database", std::make_shared<DeleteDatabaseCommand>(currentUser), "Delete a database, .delete database <databaseName>", {".rm db"}},
-        {".use", std::make_shared<UseDatabaseCommand>(currentUser, currentDatabase), "use database command, .use <database name>"}
+        {".set storage", std::make_shared<SetStorageCommand>(currentUser), "Set database storage format, .set storage <databaseName> <json|columnar|paged>"},
+        {".set buffer pool", std::make_shared<SetBufferPoolCommand>(currentUser), "Set the page buffer pool memory budget, .set buffer pool <kilobytes>"},
+        {".set json", std::make_shared<SetJsonStyleCommand>(currentUser), "Set the layout of written JSON files, .set json <pretty|compact>"},
+        {".set compaction", std::make_shared<SetCompactionCommand>(currentUser), "Set the background compaction threshold and I/O budget, .set compaction <ratio> <kilobytes per second>"},
+        {".set filter kernel", std::make_shared<SetFilterKernelCommand>(currentUser), "Pick the kernel that filters int columns, .set filter kernel <auto|avx2|sse4.2|scalar>"},
+        {".set log", std::make_shared<SetLogCommand>(currentUser), "Set the log level and flush interval, format or rotation, .set log <info|warning|error> [flush milliseconds] | format <text|binary> | rotate <kilobytes> <seconds> [compress]"},
+        {".use", std::make_shared<UseDatabaseCommand>(currentUser, currentDatabase, sessionPermissions), "use database command, .use <database name>"},
+        {".import", std::make_shared<ImportCommand>(currentUser, currentDatabase, sessionPermissions), "Import rows from a CSV or JSON lines file, .import <table> <file> [csv|jsonl]"},
+        {".export", std::make_shared<ExportCommand>(currentUser, currentDatabase, sessionPermissions), "Export the rows of a table to a file, .export <table> <file> [csv|jsonl|binary]"}
     };
 
     REGISTER_COMMANDS_ASYNC(commands, this);
@@ -98,14 +135,17 @@ void CommandFactory::registerMetaCommands(std::string& currentUser, std::string&
 
 void CommandFactory::registerSQLCommands(std::string& currentUser, std::string& currentDatabase) {
     std::vector<CommandInfo> commands = {
-        {"SELECT", std::make_shared<SelectCommand>(currentUser, currentDatabase), "Select command", {"select"}},
-        {"INSERT", std::make_shared<InsertCommand>(currentUser, currentDatabase), "Insert command", {"insert"}},
-        {"UPDATE", std::make_shared<UpdateCommand>(currentUser, currentDatabase), "Update command", {"update"}},
-        {"DELETE", std::make_shared<DeleteCommand>(currentUser, currentDatabase), "Delete command", {"delete"}},
-        {"CREATE TABLE", std::make_shared<CreateTableCommand>(currentUser, currentDatabase), "Create table command", {"create tbl", "create table"}},
-        {"DROP TABLE", std::make_shared<DropTableCommand>(currentUser, currentDatabase), "Drop table command", {"drop tbl", "drop table"}},
-        {"SHOW TABLES", std::make_shared<ShowTablesCommand>(currentUser, currentDatabase), "Show tables command", {"show tables"}},
-        {"DESCRIBE", std::make_shared<DescribeCommand>(currentUser, currentDatabase), "Describe command", {"desc", "describe"}}
+        {"SELECT", std::make_shared<SelectCommand>(currentUser, currentDatabase, sessionPermissions), "Select command", {"select"}},
+        {"INSERT", std::make_shared<InsertCommand>(currentUser, currentDatabase, sessionPermissions), "Insert command", {"insert"}},
+        {"UPDATE", std::make_shared<UpdateCommand>(currentUser, currentDatabase, sessionPermissions), "Update command", {"update"}},
+        {"DELETE", std::make_shared<DeleteCommand>(currentUser, currentDatabase, sessionPermissions), "Delete command", {"delete"}},
+        {"CREATE TABLE", std::make_shared<CreateTableCommand>(currentUser, currentDatabase, sessionPermissions), "Create table command", {"create tbl", "create table"}},
+        {"DROP TABLE", std::make_shared<DropTableCommand>(currentUser, currentDatabase, sessionPermissions), "Drop table command", {"drop tbl", "drop table"}},
+        {"SHOW TABLES", std::make_shared<ShowTablesCommand>(currentUser, currentDatabase, sessionPermissions), "Show tables command", {"show tables"}},
+        {"DESCRIBE", std::make_shared<DescribeCommand>(currentUser, currentDatabase, sessionPermissions), "Describe command", {"desc", "describe"}},
+        {"VACUUM", std::make_shared<VacuumCommand>(currentUser, currentDatabase, sessionPermissions), "Vacuum command", {"vacuum"}},
+        {"PREPARE", std::make_shared<PrepareCommand>(preparedStatements), "Prepare command", {"prepare"}},
+        {"EXECUTE", std::make_shared<ExecuteCommand>(*this, preparedStatements), "Execute command", {"execute"}}
     };
 
     REGISTER_COMMANDS_ASYNC(commands, this);
@@ -128,6 +168,10 @@ std::shared_ptr<Command> CommandFactory::getCommand(const std::string& commandNa
     return (it != commands.end()) ? it->second : nullptr;
 }
 
+std::shared_ptr<Command> CommandFactory::findCommand(const std::vector<std::string>& tokens, size_t& consumed, std::string& commandName) const {
+    return commandTrie.match(tokens, consumed, commandName);
+}
+
 std::vector<std::string> CommandFactory::getAllCommands() const {
     std::vector<std::string> allCommands;
     for (const auto& command : commands) {
@@ -0,0 +1,53 @@
+#include "headers/commandTrie.h"
+#include <cctype>
+#include <sstream>
+
+namespace {
+
+void toUpper(const std::string& word, std::string& upper) {
+    upper.resize(word.size());
+    for (size_t i = 0; i < word.size(); ++i) {
+        upper[i] = static_cast<char>(std::toupper(static_cast<unsigned char>(word[i])));
+    }
+}
+
+}
+
+void CommandTrie::insert(const std::string& commandName, std::shared_ptr<Command> command) {
+    Node* node = &root;
+    std::istringstream words(commandName);
+    std::string word;
+    std::string key;
+    while (words >> word) {
+        toUpper(word, key);
+        std::unique_ptr<Node>& child = node->children[key];
+        if (!child) {
+            child = std::make_unique<Node>();
+        }
+        node = child.get();
+    }
+    if (node != &root && !node->command) {
+        node->command = std::move(command);
+        node->commandName = commandName;
+    }
+}
+
+std::shared_ptr<Command> CommandTrie::match(const std::vector<std::string>& tokens, size_t& consumed, std::string& commandName) const {
+    const Node* node = &root;
+    std::string key;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        toUpper(tokens[i], key);
+        auto it = node->children.find(key);
+        if (it == node->children.end()) {
+            break;
+        }
+        node = it->second.get();
+        if (node->command) {
+            consumed = i + 1;
+            commandName = node->commandName;
+            return node->command;
+        }
+    }
+    consumed = 0;
+    return nullptr;
+}
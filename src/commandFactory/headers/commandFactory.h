@@ -7,7 +7,10 @@
 #include <unordered_set>
 #include <memory>
 #include "commands/command.h"
+#include "commandFactory/headers/commandTrie.h"
+#include "parser/planCache.h"
 #include "userManager/userManager.h"
+#include "databaseManager/databaseManager.h"
 #include <filesystem>
 #include <fstream>
 #include <nlohmann/json.hpp>
@@ -26,6 +29,7 @@ public:
     void registerMetaCommands(std::string& currentUser,std::string& currentDatabase);
     void registerSQLCommands(std::string& currentUser,std::string& currentDatabase);
     std::shared_ptr<Command> getCommand(const std::string& commandName) const;
+    std::shared_ptr<Command> findCommand(const std::vector<std::string>& tokens, size_t& consumed, std::string& commandName) const;
     std::vector<std::string> getAllMetaCommands() const;
     std::vector<std::string> getMetaCommands(const std::string& searchPattern) const;
     std::string getCommandDescription(const std::string& commandName) const;
@@ -34,15 +38,19 @@ public:
     void checkAndCreateFileSystem() const;
     void registerCommandAsync(const std::string& name, std::shared_ptr<Command> command, const std::string& description, const std::vector<std::string>& aliases);
 private:
+    void buildCommandTrie();
+
     std::vector<std::future<void>> futures;
     std::unordered_map<std::string, std::shared_ptr<Command>> commands;
     std::unordered_map<std::string, std::string> users;
     std::unordered_map<std::string, std::string> commandDescriptions;
     std::unordered_map<std::string, std::vector<std::string>> commandAliasMap;
     std::unordered_set<std::string> primaryCommands;
+    CommandTrie commandTrie;
     std::string& currentUser;
     std::string& currentDatabase;
-
+    SessionPermissions sessionPermissions;
+    PreparedStatements preparedStatements;
 };
 #define REGISTER_COMMANDS_ASYNC(commandsVector, factoryInstance) \
     std::vector<std::future<void>> futures; \
@@ -0,0 +1,31 @@
+#ifndef COMMAND_TRIE_H
+#define COMMAND_TRIE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "commands/command.h"
+
+// Command names and aliases split into words, one trie level per word. Words are compared
+// case-insensitively, so "select", "SELECT" and "Select" reach the same node. A statement
+// is dispatched with a single walk over its leading tokens.
+class CommandTrie {
+public:
+    void insert(const std::string& commandName, std::shared_ptr<Command> command);
+
+    // Finds the shortest run of leading tokens that names a command. consumed receives the
+    // number of tokens the name took and commandName the name as it was registered.
+    std::shared_ptr<Command> match(const std::vector<std::string>& tokens, size_t& consumed, std::string& commandName) const;
+
+private:
+    struct Node {
+        std::unordered_map<std::string, std::unique_ptr<Node>> children;
+        std::shared_ptr<Command> command;
+        std::string commandName;
+    };
+
+    Node root;
+};
+
+#endif
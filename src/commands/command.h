@@ -7,7 +7,8 @@
 class Command {
 public:
     virtual ~Command() = default;
-    virtual void execute(const std::vector<std::string>& args) = 0;
+    // False when the command failed, after it printed why.
+    virtual bool execute(const std::vector<std::string>& args) = 0;
 };
 
 #endif
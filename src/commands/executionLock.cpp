@@ -0,0 +1,19 @@
+#include "commands/executionLock.h"
+#include "databaseManager/databaseManager.h"
+#include "storageManager/storageFormat.h"
+
+std::shared_mutex ExecutionLock::mutex;
+
+// The format is read under the shared lock, so a .set storage cannot change it before the
+// SELECT runs.
+ExecutionLock::ExecutionLock(const std::string& commandName, const std::string& databaseName) {
+    INIT_DB_MANAGER;
+    if (commandName == "SELECT" && !databaseName.empty()) {
+        shared = std::shared_lock<std::shared_mutex>(mutex);
+        if (usesSnapshotWrites(dbManager.getStorageFormat(databaseName))) {
+            return;
+        }
+        shared.unlock();
+    }
+    exclusive = std::unique_lock<std::shared_mutex>(mutex);
+}
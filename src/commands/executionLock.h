@@ -0,0 +1,26 @@
+#ifndef EXECUTION_LOCK_H
+#define EXECUTION_LOCK_H
+
+#include <string>
+#include <mutex>
+#include <shared_mutex>
+
+// Held by the server sessions and the library Databases while one of their statements runs.
+// The managers' caches are guarded, but most commands still take their lock files with a
+// separate check and lock (IS_LOCKED, then LOCK), so those statements run one at a time.
+// A SELECT on a database whose files are replaced by rename reads complete files without a
+// lock file, so such SELECTs run alongside each other.
+class ExecutionLock {
+public:
+    ExecutionLock(const std::string& commandName, const std::string& databaseName);
+    ExecutionLock(const ExecutionLock&) = delete;
+    ExecutionLock& operator=(const ExecutionLock&) = delete;
+
+private:
+    static std::shared_mutex mutex;
+
+    std::shared_lock<std::shared_mutex> shared;
+    std::unique_lock<std::shared_mutex> exclusive;
+};
+
+#endif
@@ -3,12 +3,12 @@
 AddPermissionCommand::AddPermissionCommand(std::string& currentUser)
     : currentUser(currentUser) {}
 
-void AddPermissionCommand::execute(const std::vector<std::string>& args) {
+bool AddPermissionCommand::execute(const std::vector<std::string>& args) {
     checkUserLoggedIn(currentUser);
     LockFileType LockFileTypeToUse = LockFileType::DATABASE_MANAGER;
     if (args.size() < 3) {
         DISPLAY_MESSAGE("Usage: .add permission <databaseName> <username> <permission1> [<permission2> ...], READ, WRITE, ADD_TO_TABLE, MANAGE_PERMISSIONS");
-        return;
+        return false;
     }
 
     std::string databaseName = args[0];
@@ -19,13 +19,13 @@ void AddPermissionCommand::execute(const std::vector<std::string>& args) {
     if (!dbManager.databaseExists(databaseName)) {
         LOG(LogLevel::ERROR, databaseName, currentUser, "Database '" + databaseName + "' not found.");
         DISPLAY_MESSAGE("Error: Database '" + databaseName + "' not found.");
-        return;
+        return false;
     }
 
     if (!dbManager.canManagePermissions(databaseName, currentUser)) {
         LOG(LogLevel::ERROR, databaseName, currentUser, "User '" + currentUser + "' does not have permission to manage permissions for database '" + databaseName + "'.");
         DISPLAY_MESSAGE("Error: You do not have permission to manage permissions for this database.");
-        return;
+        return false;
     }
 
     bool allPermissionsAdded = true;
@@ -33,7 +33,7 @@ void AddPermissionCommand::execute(const std::vector<std::string>& args) {
 
     if (IS_LOCKED("", LockFileTypeToUse)){
         DISPLAY_MESSAGE("databases config file is currently locked... try again later");
-        return;
+        return false;
     }
     LOCK("", LockFileTypeToUse, currentUser, "ADD PERMISSION");
     for (size_t i = 2; i < args.size(); ++i) {
@@ -63,4 +63,5 @@ void AddPermissionCommand::execute(const std::vector<std::string>& args) {
         LOG(LogLevel::ERROR, databaseName, currentUser, "Some permissions could not be added for user '" + username + "'.");
         DISPLAY_MESSAGE("Some permissions could not be added.");
     }
+    return allPermissionsAdded;
 }
@@ -11,7 +11,7 @@
 class AddPermissionCommand : public Command {
 public:
     AddPermissionCommand(std::string& currentUser);
-    void execute(const std::vector<std::string>& args) override;
+    bool execute(const std::vector<std::string>& args) override;
 
 private:
     std::string& currentUser;
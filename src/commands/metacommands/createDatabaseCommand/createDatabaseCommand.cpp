@@ -7,12 +7,12 @@
 CreateDatabaseCommand::CreateDatabaseCommand(std::string& currentUser)
     : currentUser(currentUser) {}
 
-void CreateDatabaseCommand::execute(const std::vector<std::string>& args) {
+bool CreateDatabaseCommand::execute(const std::vector<std::string>& args) {
     checkUserLoggedIn(currentUser);
     LockFileType LockFileTypeToUse = LockFileType::DATABASE_MANAGER;
     if (args.size() < 1) {
         DISPLAY_MESSAGE("Usage: .create database <databaseName1> [<databaseName2> ...]");
-        return;
+        return false;
     }
 
     INIT_DB_MANAGER;
@@ -21,7 +21,7 @@ void CreateDatabaseCommand::execute(const std::vector<std::string>& args) {
     bool allCreated = true;
     if (IS_LOCKED("", LockFileTypeToUse)){
         DISPLAY_MESSAGE("databases config file is currently locked... try again later");
-        return;
+        return false;
     }
     LOCK("", LockFileTypeToUse, currentUser, "CREATE DATABASE");
     for (const std::string& databaseName : args) {
@@ -44,4 +44,5 @@ void CreateDatabaseCommand::execute(const std::vector<std::string>& args) {
         DISPLAY_MESSAGE("Some databases could not be created.");
     }
     UNLOCK("", LockFileTypeToUse);
+    return allCreated;
 }
@@ -11,7 +11,7 @@
 class CreateDatabaseCommand : public Command {
 public:
     CreateDatabaseCommand(std::string& currentUser);
-    void execute(const std::vector<std::string>& args) override;
+    bool execute(const std::vector<std::string>& args) override;
 private:
     std::string& currentUser;
 };
@@ -2,10 +2,10 @@
 #include "lockManager/lockManager.h"
 CreateUserCommand::CreateUserCommand() {}
 
-void CreateUserCommand::execute(const std::vector<std::string>& args) {
+bool CreateUserCommand::execute(const std::vector<std::string>& args) {
     if (args.size() < 2 || args.size() > 2) {
         DISPLAY_MESSAGE("Usage: .create user <username> <password>");
-        return;
+        return false;
     }
     LockFileType LockFileTypeToUse = LockFileType::USER_INFO;
 
@@ -14,7 +14,7 @@ void CreateUserCommand::execute(const std::vector<std::string>& args) {
 
     if (IS_LOCKED("", LockFileTypeToUse)){
         DISPLAY_MESSAGE("users config file is currently locked... try again later");
-        return;
+        return false;
     }
     LOCK("", LockFileTypeToUse, "", "CREATE USER");
 
@@ -22,7 +22,8 @@ void CreateUserCommand::execute(const std::vector<std::string>& args) {
     std::string username = args[0];
     std::string password = args[1];
 
-    if (userManager.createUser(username, password)) {
+    bool created = userManager.createUser(username, password);
+    if (created) {
         DISPLAY_MESSAGE("User created: " + username);
         LOG(LogLevel::INFO, "", "", "User created: " + username);
     } else {
@@ -30,4 +31,5 @@ void CreateUserCommand::execute(const std::vector<std::string>& args) {
         LOG(LogLevel::ERROR, "", "", "Failed to create user: " + username);
     }
     UNLOCK("", LockFileTypeToUse);
+    return created;
 }
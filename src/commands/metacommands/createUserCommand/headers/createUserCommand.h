@@ -11,7 +11,7 @@ class CreateUserCommand : public Command {
 public:
     CreateUserCommand();
 
-    void execute(const std::vector<std::string>& args) override;
+    bool execute(const std::vector<std::string>& args) override;
 
 
 };
@@ -4,35 +4,40 @@
 DeleteDatabaseCommand::DeleteDatabaseCommand(std::string& currentUser)
     : currentUser(currentUser) {}
 
-void DeleteDatabaseCommand::execute(const std::vector<std::string>& args) {
+bool DeleteDatabaseCommand::execute(const std::vector<std::string>& args) {
     checkUserLoggedIn(currentUser);
     if (args.empty()) {
         DISPLAY_MESSAGE("Error: No database names provided.");
-        return;
+        return false;
     }
 
     INIT_DB_MANAGER;
     INIT_SQL_MANAGER;
 
+    bool allDeleted = true;
     for (const std::string& dbName : args) {
         if (!dbManager.databaseExists(dbName)) {
             DISPLAY_MESSAGE("Error: Database '" + dbName + "' does not exist.");
             LOG(LogLevel::ERROR, dbName, currentUser, "Attempted to delete non-existent database '" + dbName + "'.");
+            allDeleted = false;
             continue;
         }
 
         if (!dbManager.isOwner(dbName, currentUser)) {
             DISPLAY_MESSAGE("Error: User '" + currentUser + "' is not the owner of '" + dbName + "'.");
             LOG(LogLevel::ERROR, dbName, currentUser, "User '" + currentUser + "' attempted to delete database '" + dbName + "' without ownership.");
+            allDeleted = false;
             continue;
         }
 
         if (IS_LOCKED(dbName, LockFileType::DATABASE_MANAGER)) {
             DISPLAY_MESSAGE(dbName + " config file is currently locked... try again later");
+            allDeleted = false;
             continue;
         }
         if (IS_LOCKED(dbName, LockFileType::DATABASE)) {
             DISPLAY_MESSAGE(dbName + " file is currently locked... try again later");
+            allDeleted = false;
             continue;
         }
 
@@ -47,10 +52,12 @@ void DeleteDatabaseCommand::execute(const std::vector<std::string>& args) {
                 LOG(LogLevel::INFO, dbName, currentUser, "Database '" + dbName + "' deleted successfully by user '" + currentUser + "'.");
             } else {
                 DISPLAY_MESSAGE("Error: Failed to delete database '" + dbName + "'.");
+                allDeleted = false;
                 LOG(LogLevel::ERROR, dbName, currentUser, "Failed to delete database '" + dbName + "' by user '" + currentUser + "'.");
             }
         } catch (...) {
             DISPLAY_MESSAGE("An unexpected error occurred while deleting database '" + dbName + "'.");
+            allDeleted = false;
             LOG(LogLevel::ERROR, dbName, currentUser, "Unexpected error while deleting database '" + dbName + "'.");
         }
 
@@ -59,4 +66,5 @@ void DeleteDatabaseCommand::execute(const std::vector<std::string>& args) {
         lockReleased = true;
 
     }
+    return allDeleted;
 }
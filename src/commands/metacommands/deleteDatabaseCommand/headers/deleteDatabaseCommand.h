@@ -12,7 +12,7 @@
 class DeleteDatabaseCommand : public Command {
 public:
     DeleteDatabaseCommand(std::string& currentUser);
-    void execute(const std::vector<std::string>& args) override;
+    bool execute(const std::vector<std::string>& args) override;
 
 private:
     std::string &currentUser;
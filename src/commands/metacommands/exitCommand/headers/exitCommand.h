@@ -7,7 +7,7 @@
 
 class ExitCommand : public Command {
 public:
-    virtual void execute(const std::vector<std::string>& args) override;
+    virtual bool execute(const std::vector<std::string>& args) override;
 };
 
 #endif
@@ -0,0 +1,86 @@
+#include "headers/exportCommand.h"
+#include "sqlManager/sqlManager.h"
+#include "lockManager/lockManager.h"
+#include "storageManager/rowExporter.h"
+#include "storageManager/fileAccess.h"
+
+ExportCommand::ExportCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions)
+    : currentUser(currentUser), currentDatabase(currentDatabase), sessionPermissions(sessionPermissions) {}
+
+// .export <table> <file> [csv|jsonl|binary] writes every row of a table to a file. Rows are
+// streamed from the table scan to the file, so the table is never held in memory.
+bool ExportCommand::execute(const std::vector<std::string>& args) {
+    INIT_DB_MANAGER;
+    INIT_SQL_MANAGER;
+    checkUserLoggedIn(currentUser);
+    checkDatabaseSelected(currentUser, currentDatabase);
+    if (args.size() < 2 || args.size() > 3) {
+        DISPLAY_MESSAGE("Usage: .export <table> <file> [csv|jsonl|binary]");
+        return false;
+    }
+    if (!dbManager.sessionHasPermission(sessionPermissions, currentDatabase, currentUser, Permission::READ)) {
+        DISPLAY_MESSAGE("Current user is neither the owner nor has read permission for database '" + currentDatabase + "'.");
+        return false;
+    }
+
+    const std::string& tableName = args[0];
+    const std::string& path = args[1];
+    std::string filePath;
+    if (!FileAccess::resolve(path, filePath)) {
+        return false;
+    }
+    ExportFormat format;
+    if (args.size() == 3 ? !stringToExportFormat(args[2], format) : !exportFormatFromPath(path, format)) {
+        DISPLAY_MESSAGE("Error: Unknown export format. Use .export <table> <file> <csv|jsonl|binary>.");
+        return false;
+    }
+
+    std::shared_ptr<const json> schema = dbManager.getSchema(currentDatabase);
+    if (!schema) {
+        std::cerr << "Error: Failed to read schema of database '" << currentDatabase << "'." << std::endl;
+        return false;
+    }
+    const json table = sqlManager.findTable(*schema, tableName);
+    if (table.is_null()) {
+        std::cerr << "Error: Table '" << tableName << "' does not exist in database '" << currentDatabase << "'." << std::endl;
+        return false;
+    }
+    std::vector<RowExporter::Column> columns;
+    for (const auto& column : table["columns"]) {
+        ColumnarFormat::ColumnType type = ColumnarFormat::ColumnType::STRING;
+        ColumnarFormat::columnTypeFromString(column["type"], type);
+        columns.push_back({column["name"], type});
+    }
+
+    RowExporter exporter(filePath, format, std::move(columns));
+    if (!exporter.isOpen()) {
+        std::cerr << "Error: Failed to create file '" << path << "'." << std::endl;
+        return false;
+    }
+
+    // Snapshot files are always complete, so reading them needs no lock.
+    LockFileType LockFileTypeToUse = LockFileType::DATABASE;
+    const bool snapshotRead = usesSnapshotWrites(dbManager.getStorageFormat(currentDatabase));
+    if (!snapshotRead) {
+        if (IS_LOCKED(currentDatabase, LockFileTypeToUse)) {
+            DISPLAY_MESSAGE(currentDatabase + " is currently locked... try again later");
+            return false;
+        }
+        LOCK(currentDatabase, LockFileTypeToUse, currentUser, "EXPORT");
+    }
+    bool written = true;
+    bool scanned = sqlManager.scanTableRows(currentDatabase, tableName, nullptr, -1, [&exporter, &written](const json& row) {
+        written = exporter.writeRow(row);
+        return written;
+    });
+    if (!snapshotRead) {
+        UNLOCK(currentDatabase, LockFileTypeToUse);
+    }
+
+    if (!scanned || !written || !exporter.close()) {
+        std::cerr << "Error: Failed to export table '" << tableName << "' to '" << path << "'." << std::endl;
+        return false;
+    }
+    std::cout << "Exported " << exporter.rowCount() << " rows to '" << path << "'." << std::endl;
+    return true;
+}
@@ -0,0 +1,23 @@
+#ifndef EXPORT_COMMAND_H
+#define EXPORT_COMMAND_H
+
+#include "commands/command.h"
+#include "databaseManager/databaseManager.h"
+#include <string>
+#include "checks.h"
+#include <vector>
+#include <iostream>
+#include "logManager/logManager.h"
+
+class ExportCommand : public Command {
+public:
+    ExportCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
+    bool execute(const std::vector<std::string>& args) override;
+
+private:
+    std::string& currentUser;
+    std::string& currentDatabase;
+    SessionPermissions& sessionPermissions;
+};
+
+#endif
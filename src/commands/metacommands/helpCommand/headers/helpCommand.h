@@ -11,7 +11,7 @@
 class HelpCommand : public Command {
 public:
     HelpCommand(const CommandFactory& commandFactory);
-    void execute(const std::vector<std::string>& args) override;
+    bool execute(const std::vector<std::string>& args) override;
 
 private:
     const CommandFactory& commandFactory;
@@ -2,7 +2,7 @@
 
 HelpCommand::HelpCommand(const CommandFactory& commandFactory) : commandFactory(commandFactory) {}
 
-void HelpCommand::execute(const std::vector<std::string>& args) {
+bool HelpCommand::execute(const std::vector<std::string>& args) {
     std::vector<std::string> metaCommands = getMetaCommands(args);
 
     for (const auto& command : metaCommands) {
@@ -11,6 +11,7 @@ void HelpCommand::execute(const std::vector<std::string>& args) {
 
         printCommandDetails(command, aliases, description);
     }
+    return true;
 }
 
 std::vector<std::string> HelpCommand::getMetaCommands(const std::vector<std::string>& args) const {
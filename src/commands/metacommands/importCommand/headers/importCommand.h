@@ -0,0 +1,43 @@
+#ifndef IMPORT_COMMAND_H
+#define IMPORT_COMMAND_H
+
+#include "commands/command.h"
+#include "databaseManager/databaseManager.h"
+#include <string>
+#include <string_view>
+#include "checks.h"
+#include <vector>
+#include <iostream>
+#include <nlohmann/json.hpp>
+#include "logManager/logManager.h"
+
+class ImportCommand : public Command {
+public:
+    ImportCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
+    bool execute(const std::vector<std::string>& args) override;
+
+private:
+    // One slice of the input file, parsed on its own thread.
+    struct Chunk {
+        std::string_view text;
+        nlohmann::json rows = nlohmann::json::array();
+        size_t lines = 0;           // lines the chunk spans
+        size_t errorLine = 0;       // line within the chunk, counted from 1
+        std::string error;
+    };
+    struct ImportColumn {
+        std::string name;
+        std::string type;
+    };
+
+    bool readColumns(const std::string& tableName, std::vector<ImportColumn>& columns);
+    std::vector<std::string_view> splitChunks(std::string_view data, size_t count, bool csv);
+    void parseCsvChunk(Chunk& chunk, const std::vector<ImportColumn>& fields);
+    void parseJsonLinesChunk(Chunk& chunk, const std::vector<ImportColumn>& columns);
+
+    std::string& currentUser;
+    std::string& currentDatabase;
+    SessionPermissions& sessionPermissions;
+};
+
+#endif
@@ -0,0 +1,326 @@
+#include "headers/importCommand.h"
+#include "sqlManager/sqlManager.h"
+#include "sqlManager/wherePredicate.h"
+#include "lockManager/lockManager.h"
+#include "storageManager/mappedFile.h"
+#include "storageManager/fileAccess.h"
+#include <future>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+namespace {
+
+// Reads one CSV record starting at pos: fields are separated by ',', a field starting with
+// '"' runs to the closing quote and may hold commas, newlines and doubled quotes. quoted
+// tells empty fields ("") from missing ones. newlines receives the line breaks consumed.
+bool readCsvRecord(std::string_view text, size_t& pos, std::vector<std::string>& fields, std::vector<bool>& quoted, size_t& newlines) {
+    fields.assign(1, std::string());
+    quoted.assign(1, false);
+    bool inQuotes = false;
+    while (pos < text.size()) {
+        char c = text[pos++];
+        std::string& field = fields.back();
+        if (inQuotes) {
+            if (c != '"') {
+                newlines += c == '\n';
+                field += c;
+            } else if (pos < text.size() && text[pos] == '"') {
+                field += '"';
+                ++pos;
+            } else {
+                inQuotes = false;
+            }
+        } else if (c == '"' && field.empty() && !quoted.back()) {
+            inQuotes = true;
+            quoted.back() = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+            quoted.push_back(false);
+        } else if (c == '\n') {
+            ++newlines;
+            break;
+        } else if (c != '\r' || (pos < text.size() && text[pos] != '\n')) {
+            field += c;
+        }
+    }
+    return !inQuotes;
+}
+
+}
+
+ImportCommand::ImportCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions)
+    : currentUser(currentUser), currentDatabase(currentDatabase), sessionPermissions(sessionPermissions) {}
+
+// .import <table> <file> [csv|jsonl] loads a file into a table of the current database.
+// A CSV file starts with a header naming the columns; a JSON lines file holds one object
+// per line. The file is split into one chunk per hardware thread and the chunks are parsed
+// and converted to the column types in parallel. The rows are then checked and written as
+// one batch, as a multi-row INSERT is: if any row fails, nothing is imported.
+bool ImportCommand::execute(const std::vector<std::string>& args) {
+    using Seconds = std::chrono::duration<double>;
+    INIT_DB_MANAGER;
+    checkUserLoggedIn(currentUser);
+    checkDatabaseSelected(currentUser, currentDatabase);
+    if (args.size() < 2 || args.size() > 3) {
+        DISPLAY_MESSAGE("Usage: .import <table> <file> [csv|jsonl]");
+        return false;
+    }
+    bool hasAddToTablePermissions = CHECK_SESSION_PERMISSION(sessionPermissions, currentDatabase, currentUser, Permission::ADD_TO_TABLE);
+    if (!hasAddToTablePermissions) {
+        DISPLAY_MESSAGE("Current user is neither the owner nor has add to table permission for " + currentDatabase);
+        return false;
+    }
+
+    const std::string& tableName = args[0];
+    const std::string& path = args[1];
+    std::string format = args.size() == 3 ? args[2] : "";
+    if (format.empty()) {
+        if (path.ends_with(".csv")) {
+            format = "csv";
+        } else if (path.ends_with(".jsonl") || path.ends_with(".ndjson")) {
+            format = "jsonl";
+        }
+    }
+    if (format.empty()) {
+        DISPLAY_MESSAGE("Error: Cannot tell the format of '" + path + "' from its extension. Use .import <table> <file> <csv|jsonl>.");
+        return false;
+    }
+    if (format != "csv" && format != "jsonl") {
+        DISPLAY_MESSAGE("Error: Unknown import format '" + format + "'. Use csv or jsonl.");
+        return false;
+    }
+    const bool csv = format == "csv";
+
+    std::vector<ImportColumn> columns;
+    if (!readColumns(tableName, columns)) {
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::string filePath;
+    MappedFile file;
+    if (!FileAccess::resolve(path, filePath)) {
+        return false;
+    }
+    if (!file.open(filePath)) {
+        std::cerr << "Error: Failed to open import file '" << path << "'." << std::endl;
+        return false;
+    }
+    std::string_view data = file.view();
+
+    // The CSV header picks and orders the columns the records give values for.
+    std::vector<ImportColumn> fields = columns;
+    size_t headerLines = 0;
+    if (csv) {
+        size_t pos = 0;
+        std::vector<std::string> header;
+        std::vector<bool> quoted;
+        if (data.empty() || !readCsvRecord(data, pos, header, quoted, headerLines)) {
+            std::cerr << "Error: Import file '" << path << "' has no valid CSV header." << std::endl;
+            return false;
+        }
+        fields.clear();
+        for (const auto& name : header) {
+            auto column = std::find_if(columns.begin(), columns.end(), [&name](const ImportColumn& column) {
+                return column.name == name;
+            });
+            if (column == columns.end()) {
+                std::cerr << "Error: Column '" << name << "' does not exist in table '" << tableName << "'." << std::endl;
+                return false;
+            }
+            fields.push_back(*column);
+        }
+        data.remove_prefix(pos);
+    }
+
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<Chunk> chunks;
+    for (std::string_view text : splitChunks(data, threads, csv)) {
+        chunks.push_back({text});
+    }
+    std::vector<std::future<void>> futures;
+    for (auto& chunk : chunks) {
+        futures.push_back(std::async(std::launch::async, [this, &chunk, &fields, csv] {
+            if (csv) {
+                parseCsvChunk(chunk, fields);
+            } else {
+                parseJsonLinesChunk(chunk, fields);
+            }
+        }));
+    }
+    for (auto& future : futures) {
+        future.get();
+    }
+
+    size_t lineOffset = headerLines;
+    size_t rowCount = 0;
+    for (const auto& chunk : chunks) {
+        if (!chunk.error.empty()) {
+            std::cerr << "Error: " << path << ":" << lineOffset + chunk.errorLine << ": " << chunk.error << "." << std::endl;
+            return false;
+        }
+        lineOffset += chunk.lines;
+        rowCount += chunk.rows.size();
+    }
+    nlohmann::json rows = nlohmann::json::array();
+    rows.get_ref<nlohmann::json::array_t&>().reserve(rowCount);
+    for (auto& chunk : chunks) {
+        for (auto& row : chunk.rows) {
+            rows.push_back(std::move(row));
+        }
+        chunk.rows = nlohmann::json::array();
+    }
+    file.close();
+
+    INIT_SQL_MANAGER;
+    LockFileType LockFileTypeToUse = LockFileType::DATABASE;
+    if (IS_LOCKED(currentDatabase, LockFileTypeToUse)) {
+        DISPLAY_MESSAGE(currentDatabase + " is currently locked... try again later");
+        return false;
+    }
+    LOCK(currentDatabase, LockFileTypeToUse, currentUser, "IMPORT");
+    bool imported = sqlManager.insertTypedRows(currentDatabase, tableName, std::move(rows));
+    UNLOCK(currentDatabase, LockFileTypeToUse);
+    if (!imported) {
+        std::cerr << "Error: Failed to import '" << path << "' into table '" << tableName << "'." << std::endl;
+        return false;
+    }
+
+    Seconds elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Imported " << rowCount << " rows into table '" << tableName << "' in " << elapsed.count() << " seconds." << std::endl;
+    return true;
+}
+
+bool ImportCommand::readColumns(const std::string& tableName, std::vector<ImportColumn>& columns) {
+    INIT_DB_MANAGER;
+    INIT_SQL_MANAGER;
+    std::shared_ptr<const json> schema = dbManager.getSchema(currentDatabase);
+    if (!schema) {
+        std::cerr << "Error: Failed to read schema of database '" << currentDatabase << "'." << std::endl;
+        return false;
+    }
+    const json table = sqlManager.findTable(*schema, tableName);
+    if (table.is_null()) {
+        std::cerr << "Error: Table '" << tableName << "' does not exist in database '" << currentDatabase << "'." << std::endl;
+        return false;
+    }
+    for (const auto& column : table["columns"]) {
+        columns.push_back({column["name"], column["type"]});
+    }
+    return true;
+}
+
+// Cuts data into about count pieces, each ending at a line break. For CSV the scan tracks
+// quotes, so a quoted field spanning lines is never cut.
+std::vector<std::string_view> ImportCommand::splitChunks(std::string_view data, size_t count, bool csv) {
+    std::vector<std::string_view> chunks;
+    size_t start = 0;
+    size_t scan = 0;
+    bool inQuotes = false;
+    for (size_t k = 1; k < count; ++k) {
+        size_t target = std::max(start, data.size() / count * k);
+        size_t boundary = std::string_view::npos;
+        if (csv) {
+            for (; scan < data.size(); ++scan) {
+                if (data[scan] == '"') {
+                    inQuotes = !inQuotes;
+                } else if (data[scan] == '\n' && !inQuotes && scan >= target) {
+                    boundary = ++scan;
+                    break;
+                }
+            }
+        } else {
+            size_t lineEnd = data.find('\n', target);
+            boundary = lineEnd == std::string_view::npos ? lineEnd : lineEnd + 1;
+        }
+        if (boundary >= data.size()) {
+            break;
+        }
+        chunks.push_back(data.substr(start, boundary - start));
+        start = boundary;
+    }
+    chunks.push_back(data.substr(start));
+    return chunks;
+}
+
+// An empty unquoted field leaves the column out of the row.
+void ImportCommand::parseCsvChunk(Chunk& chunk, const std::vector<ImportColumn>& fields) {
+    std::vector<std::string> values;
+    std::vector<bool> quoted;
+    size_t pos = 0;
+    while (pos < chunk.text.size()) {
+        size_t line = chunk.lines + 1;
+        if (!readCsvRecord(chunk.text, pos, values, quoted, chunk.lines)) {
+            chunk.errorLine = line;
+            chunk.error = "unterminated quoted field";
+            return;
+        }
+        if (values.size() == 1 && values[0].empty() && !quoted[0]) {
+            continue;
+        }
+        if (values.size() != fields.size()) {
+            chunk.errorLine = line;
+            chunk.error = "expected " + std::to_string(fields.size()) + " fields but found " + std::to_string(values.size());
+            return;
+        }
+        json row = json::object();
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (values[i].empty() && !quoted[i]) {
+                continue;
+            }
+            if (!convertLiteral(fields[i].type, values[i], row[fields[i].name])) {
+                chunk.errorLine = line;
+                chunk.error = "invalid " + fields[i].type + " value '" + values[i] + "' for column '" + fields[i].name + "'";
+                return;
+            }
+        }
+        chunk.rows.push_back(std::move(row));
+    }
+}
+
+// Null members leave the column out of the row. Strings are converted like CSV fields, so a
+// date or a number may also be given as a string.
+void ImportCommand::parseJsonLinesChunk(Chunk& chunk, const std::vector<ImportColumn>& columns) {
+    size_t pos = 0;
+    while (pos < chunk.text.size()) {
+        size_t lineEnd = chunk.text.find('\n', pos);
+        std::string_view line = chunk.text.substr(pos, lineEnd == std::string_view::npos ? std::string_view::npos : lineEnd - pos);
+        pos = lineEnd == std::string_view::npos ? chunk.text.size() : lineEnd + 1;
+        ++chunk.lines;
+        if (line.find_first_not_of(" \t\r") == std::string_view::npos) {
+            continue;
+        }
+
+        json object = json::parse(line.begin(), line.end(), nullptr, false);
+        if (object.is_discarded() || !object.is_object()) {
+            chunk.errorLine = chunk.lines;
+            chunk.error = "expected a JSON object";
+            return;
+        }
+        json row = json::object();
+        for (auto& [name, value] : object.items()) {
+            auto column = std::find_if(columns.begin(), columns.end(), [&name = name](const ImportColumn& column) {
+                return column.name == name;
+            });
+            if (column == columns.end()) {
+                chunk.errorLine = chunk.lines;
+                chunk.error = "column '" + name + "' does not exist";
+                return;
+            }
+            bool converted = value.is_null();
+            if (value.is_string()) {
+                converted = convertLiteral(column->type, value.get_ref<const std::string&>(), row[name]);
+            } else if (value.is_number_integer() && column->type == "int") {
+                row[name] = std::move(value);
+                converted = true;
+            }
+            if (!converted) {
+                chunk.errorLine = chunk.lines;
+                chunk.error = "invalid " + column->type + " value " + value.dump() + " for column '" + name + "'";
+                return;
+            }
+        }
+        chunk.rows.push_back(std::move(row));
+    }
+}
@@ -8,7 +8,7 @@
 
 class ListDatabasesCommand : public Command {
 public:
-    void execute(const std::vector<std::string>& args) override;
+    bool execute(const std::vector<std::string>& args) override;
 };
 
 #endif
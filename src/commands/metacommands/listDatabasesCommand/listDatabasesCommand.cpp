@@ -2,15 +2,16 @@
 #include "lockManager/lockManager.h"
 
 
-void ListDatabasesCommand::execute(const std::vector<std::string>& args) {
+bool ListDatabasesCommand::execute(const std::vector<std::string>& args) {
     INIT_DB_MANAGER;
     dbManager.loadDatabasesFromFile();
     if (IS_LOCKED("", LockFileType::DATABASE_MANAGER)){
         std::cout << "databases config file is currently locked... try again later\n";
-        return;
+        return false;
     }
     LOCK("",LockFileType::DATABASE_MANAGER, "", "LIST DATABASES");
     UNLOCK("",LockFileType::DATABASE_MANAGER);
     dbManager.listDatabases();
+    return true;
 }
 
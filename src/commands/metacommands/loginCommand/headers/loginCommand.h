@@ -10,7 +10,7 @@
 class LoginCommand : public Command {
 public:
     LoginCommand(std::string& currentUser);
-    virtual void execute(const std::vector<std::string>& args) override;
+    virtual bool execute(const std::vector<std::string>& args) override;
 
 private:
     std::string& currentUser;
@@ -5,10 +5,10 @@ LoginCommand::LoginCommand(std::string& currentUser)
     : currentUser(currentUser)
 {}
 
-void LoginCommand::execute(const std::vector<std::string>& args) {
+bool LoginCommand::execute(const std::vector<std::string>& args) {
     if (args.size() < 2 || args.size () > 2) {
         DISPLAY_MESSAGE("Usage: .login <user> <password>");
-        return;
+        return false;
     }
 
     std::string username = args[0];
@@ -19,7 +19,8 @@ void LoginCommand::execute(const std::vector<std::string>& args) {
         DISPLAY_MESSAGE("user config file is currently locked... try again later");
     }
     LOCK("",LockFileType::USER_INFO,currentUser,"logging in");
-    if (userManager.login(username, password)) {
+    bool loggedIn = userManager.login(username, password);
+    if (loggedIn) {
         DISPLAY_MESSAGE("Logged in as: " + username);
         currentUser = username;
         LOG(LogLevel::INFO, "", username, "Logged in.");
@@ -28,4 +29,5 @@ void LoginCommand::execute(const std::vector<std::string>& args) {
         LOG(LogLevel::ERROR, "", username, "Login failed: Invalid username or password.");
     }
     UNLOCK("", LockFileType::USER_INFO);
+    return loggedIn;
 }
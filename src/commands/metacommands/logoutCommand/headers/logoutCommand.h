@@ -10,7 +10,7 @@
 class LogoutCommand : public Command {
 public:
     LogoutCommand(std::string& currentUser, std::string& currentDatabase); 
-    virtual void execute(const std::vector<std::string>& args) override;
+    virtual bool execute(const std::vector<std::string>& args) override;
 private:
     std::string& currentUser;
     std::string& currentDatabase;
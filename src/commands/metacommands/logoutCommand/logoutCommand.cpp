@@ -4,7 +4,8 @@ LogoutCommand::LogoutCommand(std::string& currentUser, std::string& currentDatab
     : currentUser(currentUser), currentDatabase(currentDatabase)
 {}
 
-void LogoutCommand::execute(const std::vector<std::string>& args) {
+bool LogoutCommand::execute(const std::vector<std::string>& args) {
     currentUser.clear();
     currentDatabase.clear();
+    return true;
 }
\ No newline at end of file
@@ -15,7 +15,7 @@ class RemovePermissionCommand : public Command {
 public:
     RemovePermissionCommand(std::string& currentUser);
 
-    void execute(const std::vector<std::string>& args) override;
+    bool execute(const std::vector<std::string>& args) override;
 
 private:
     std::string& currentUser;
@@ -3,12 +3,12 @@
 RemovePermissionCommand::RemovePermissionCommand(std::string& currentUser)
     : currentUser(currentUser) {}
 
-void RemovePermissionCommand::execute(const std::vector<std::string>& args) {
+bool RemovePermissionCommand::execute(const std::vector<std::string>& args) {
     checkUserLoggedIn(currentUser);
 
     if (args.size() < 3) {
         DISPLAY_MESSAGE("Usage: .remove permission <databaseName> <username> <permission1> [<permission2> ...], READ WRITE ADD_TO_TABLE MANAGE_PERMISSIONS");
-        return;
+        return false;
     }
 
     std::string databaseName = args[0];
@@ -18,21 +18,21 @@ void RemovePermissionCommand::execute(const std::vector<std::string>& args) {
     LockFileType LockFileTypeToUse = LockFileType::DATABASE_MANAGER;
     if (IS_LOCKED("",LockFileTypeToUse)){
         DISPLAY_MESSAGE("databases config file is currently locked... try again later");
-        return;
+        return false;
     }
     LOCK("",LockFileTypeToUse,currentUser,"Remove Permission");
     if (!dbManager.databaseExists(databaseName)) {
         UNLOCK("",LockFileTypeToUse);
         DISPLAY_MESSAGE("Error: Database '" + databaseName + "' not found.");
         LOG(LogLevel::ERROR, databaseName, currentUser, "Database '" + databaseName + "' not found.");
-        return;
+        return false;
     }
 
     if (!dbManager.canManagePermissions(databaseName, currentUser)) {
         UNLOCK("",LockFileTypeToUse);
         DISPLAY_MESSAGE("Error: You do not have permission to manage permissions for this database.");
         LOG(LogLevel::ERROR, databaseName, currentUser, "User '" + currentUser + "' does not have permission to manage permissions for database '" + databaseName + "'.");
-        return;
+        return false;
     }
 
     bool allPermissionsRemoved = true;
@@ -65,4 +65,5 @@ void RemovePermissionCommand::execute(const std::vector<std::string>& args) {
         LOG(LogLevel::ERROR, databaseName, currentUser, "Some permissions could not be removed for user '" + username + "'.");
     }
     UNLOCK("",LockFileTypeToUse);
+    return allPermissionsRemoved;
 }
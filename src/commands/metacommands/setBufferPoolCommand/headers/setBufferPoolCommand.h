@@ -0,0 +1,17 @@
+#ifndef SET_BUFFER_POOL_COMMAND_H
+#define SET_BUFFER_POOL_COMMAND_H
+
+#include "commands/command.h"
+#include <iostream>
+#include <string>
+
+class SetBufferPoolCommand : public Command {
+public:
+    SetBufferPoolCommand(std::string& currentUser);
+    virtual bool execute(const std::vector<std::string>& args) override;
+
+private:
+    std::string& currentUser;
+};
+
+#endif
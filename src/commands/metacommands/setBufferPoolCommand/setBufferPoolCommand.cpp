@@ -0,0 +1,31 @@
+#include "headers/setBufferPoolCommand.h"
+#include "storageManager/bufferPool.h"
+#include "macros.h"
+#include <charconv>
+
+SetBufferPoolCommand::SetBufferPoolCommand(std::string& currentUser)
+    : currentUser(currentUser) {}
+
+bool SetBufferPoolCommand::execute(const std::vector<std::string>& args) {
+    BufferPool& bufferPool = BufferPool::getInstance();
+    if (args.empty()) {
+        std::cout << "Buffer pool size: " << bufferPool.capacity() * PAGE_SIZE / 1024 << " KB ("
+                  << bufferPool.capacity() << " pages)" << std::endl;
+        std::cout << "Usage: .set buffer pool <kilobytes>" << std::endl;
+        return true;
+    }
+
+    CHECK_USER_ADMIN(currentUser)
+
+    size_t kilobytes = 0;
+    auto [end, ec] = std::from_chars(args[0].data(), args[0].data() + args[0].size(), kilobytes);
+    if (ec != std::errc() || end != args[0].data() + args[0].size()) {
+        std::cout << "Error: Invalid buffer pool size '" << args[0] << "'." << std::endl;
+        return false;
+    }
+
+    bufferPool.setCapacity(kilobytes * 1024 / PAGE_SIZE);
+    std::cout << "Buffer pool size set to " << bufferPool.capacity() * PAGE_SIZE / 1024 << " KB ("
+              << bufferPool.capacity() << " pages)" << std::endl;
+    return true;
+}
@@ -0,0 +1,40 @@
+#include "headers/setCompactionCommand.h"
+#include "sqlManager/compactionManager.h"
+#include "macros.h"
+#include <charconv>
+
+SetCompactionCommand::SetCompactionCommand(std::string& currentUser)
+    : currentUser(currentUser) {}
+
+bool SetCompactionCommand::execute(const std::vector<std::string>& args) {
+    INIT_COMPACTION_MANAGER
+    if (args.empty()) {
+        std::cout << "Compaction threshold: " << compactionManager.threshold() << " of a table's rows deleted, I/O budget: "
+                  << compactionManager.ioBudget() / 1024 << " KB/s" << std::endl;
+        std::cout << "Usage: .set compaction <ratio> <kilobytes per second>" << std::endl;
+        return true;
+    }
+    CHECK_USER_ADMIN(currentUser)
+    if (args.size() != 2) {
+        std::cout << "Usage: .set compaction <ratio> <kilobytes per second>" << std::endl;
+        return false;
+    }
+
+    double ratio = 0;
+    auto [ratioEnd, ratioError] = std::from_chars(args[0].data(), args[0].data() + args[0].size(), ratio);
+    if (ratioError != std::errc() || ratioEnd != args[0].data() + args[0].size() || ratio <= 0 || ratio > 1) {
+        std::cout << "Error: Invalid compaction ratio '" << args[0] << "', expected a number in (0, 1]." << std::endl;
+        return false;
+    }
+    size_t kilobytes = 0;
+    auto [budgetEnd, budgetError] = std::from_chars(args[1].data(), args[1].data() + args[1].size(), kilobytes);
+    if (budgetError != std::errc() || budgetEnd != args[1].data() + args[1].size() || kilobytes == 0) {
+        std::cout << "Error: Invalid compaction I/O budget '" << args[1] << "'." << std::endl;
+        return false;
+    }
+
+    compactionManager.setThreshold(ratio);
+    compactionManager.setIoBudget(kilobytes * 1024);
+    std::cout << "Compaction threshold set to " << ratio << ", I/O budget to " << kilobytes << " KB/s" << std::endl;
+    return true;
+}
@@ -7,7 +7,7 @@
 class SetDummyDatabaseCommand : public Command {
 public:
     SetDummyDatabaseCommand(std::string &currentDatabase) : currentDatabase(currentDatabase) {}
-    virtual void execute(const std::vector<std::string>& args) override;
+    virtual bool execute(const std::vector<std::string>& args) override;
 
 private:
     std::string &currentDatabase;
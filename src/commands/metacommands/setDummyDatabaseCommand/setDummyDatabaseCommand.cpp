@@ -1,10 +1,11 @@
 #include "headers/setDummyDatabaseCommand.h"
 
-void SetDummyDatabaseCommand::execute(const std::vector<std::string>& args) {
+bool SetDummyDatabaseCommand::execute(const std::vector<std::string>& args) {
     if (args.empty()) {
         std::cout << "Usage: .set dummy database <database_name>" << std::endl;
-        return;
+        return false;
     }
     currentDatabase = args[0];
     std::cout << "Dummy database set to: " << currentDatabase << std::endl;
+    return true;
 }
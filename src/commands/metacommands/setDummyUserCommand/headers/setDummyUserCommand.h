@@ -7,7 +7,7 @@
 class SetDummyUserCommand : public Command {
 public:
     SetDummyUserCommand(std::string &currentUser) : currentUser(currentUser) {}
-    virtual void execute(const std::vector<std::string>& args) override;
+    virtual bool execute(const std::vector<std::string>& args) override;
 
 private:
     std::string &currentUser;
@@ -1,10 +1,11 @@
 #include "headers/setDummyUserCommand.h"
 
-void SetDummyUserCommand::execute(const std::vector<std::string>& args) {
+bool SetDummyUserCommand::execute(const std::vector<std::string>& args) {
     if (args.empty()) {
         std::cout << "Usage: .set dummy user <username>" << std::endl;
-        return;
+        return false;
     }
     currentUser = args[0];
     std::cout << "Dummy user set to: " << currentUser << std::endl;
+    return true;
 }
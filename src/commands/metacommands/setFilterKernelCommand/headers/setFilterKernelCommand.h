@@ -0,0 +1,17 @@
+#ifndef SET_FILTER_KERNEL_COMMAND_H
+#define SET_FILTER_KERNEL_COMMAND_H
+
+#include "commands/command.h"
+#include <iostream>
+#include <string>
+
+class SetFilterKernelCommand : public Command {
+public:
+    SetFilterKernelCommand(std::string& currentUser);
+    virtual bool execute(const std::vector<std::string>& args) override;
+
+private:
+    std::string& currentUser;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#include "headers/setFilterKernelCommand.h"
+#include "sqlManager/filterKernels.h"
+#include "macros.h"
+
+SetFilterKernelCommand::SetFilterKernelCommand(std::string& currentUser)
+    : currentUser(currentUser) {}
+
+bool SetFilterKernelCommand::execute(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        std::cout << "Filter kernel: " << activeFilterKernel() << " (available:";
+        for (const auto& name : availableFilterKernels()) {
+            std::cout << ' ' << name;
+        }
+        std::cout << ")" << std::endl;
+        std::cout << "Usage: .set filter kernel <auto|avx2|sse4.2|scalar>" << std::endl;
+        return true;
+    }
+
+    CHECK_USER_ADMIN(currentUser)
+
+    if (args.size() != 1 || !selectFilterKernel(args[0])) {
+        std::cout << "Error: Filter kernel '" << args[0] << "' is not available on this CPU." << std::endl;
+        return false;
+    }
+    std::cout << "Filter kernel set to " << activeFilterKernel() << "." << std::endl;
+    return true;
+}
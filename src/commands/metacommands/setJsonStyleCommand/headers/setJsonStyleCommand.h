@@ -0,0 +1,21 @@
+#ifndef SET_JSON_STYLE_COMMAND_H
+#define SET_JSON_STYLE_COMMAND_H
+
+#include "commands/command.h"
+#include "databaseManager/databaseManager.h"
+#include <string>
+#include "checks.h"
+#include <vector>
+#include <iostream>
+#include "logManager/logManager.h"
+
+class SetJsonStyleCommand : public Command {
+public:
+    SetJsonStyleCommand(std::string& currentUser);
+    bool execute(const std::vector<std::string>& args) override;
+
+private:
+    std::string &currentUser;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#include "headers/setJsonStyleCommand.h"
+#include "lockManager/lockManager.h"
+SetJsonStyleCommand::SetJsonStyleCommand(std::string& currentUser)
+    : currentUser(currentUser) {}
+
+bool SetJsonStyleCommand::execute(const std::vector<std::string>& args) {
+    checkUserLoggedIn(currentUser);
+    if (args.size() != 1) {
+        DISPLAY_MESSAGE("JSON files are written " + jsonStyleToString(JsonFileWriter::defaultStyle()) + ".");
+        DISPLAY_MESSAGE("Usage: .set json <pretty|compact>");
+        return args.empty();
+    }
+
+    JsonStyle style;
+    try {
+        style = stringToJsonStyle(args[0]);
+    } catch (const std::invalid_argument&) {
+        DISPLAY_MESSAGE("Error: Unknown JSON style '" + args[0] + "'. Use pretty or compact.");
+        return false;
+    }
+
+    INIT_DB_MANAGER;
+    LockFileType LockFileTypeToUse = LockFileType::DATABASE_MANAGER;
+    if (IS_LOCKED("", LockFileTypeToUse)) {
+        DISPLAY_MESSAGE("databases config file is currently locked... try again later");
+        return false;
+    }
+    LOCK("", LockFileTypeToUse, currentUser, "Set JSON style");
+    bool set = dbManager.setJsonStyle(style);
+    if (set) {
+        DISPLAY_MESSAGE("JSON files are now written " + args[0] + ".");
+        LOG(LogLevel::INFO, "", currentUser, "JSON output style set to " + args[0] + ".");
+    } else {
+        DISPLAY_MESSAGE("Error: Failed to update the JSON output style.");
+    }
+    UNLOCK("", LockFileTypeToUse);
+    return set;
+}
@@ -0,0 +1,17 @@
+#ifndef SET_LOG_COMMAND_H
+#define SET_LOG_COMMAND_H
+
+#include "commands/command.h"
+#include <iostream>
+#include <string>
+
+class SetLogCommand : public Command {
+public:
+    SetLogCommand(std::string& currentUser);
+    virtual bool execute(const std::vector<std::string>& args) override;
+
+private:
+    std::string& currentUser;
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "headers/setLogCommand.h"
+#include "logManager/logManager.h"
+#include "macros.h"
+#include <charconv>
+#include <limits>
+
+namespace {
+
+const char* levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::INFO: return "info";
+        case LogLevel::WARNING: return "warning";
+        default: return "error";
+    }
+}
+
+const char* USAGE = "Usage: .set log <info|warning|error> [flush milliseconds] | .set log format <text|binary> | .set log rotate <kilobytes> <seconds> [compress]";
+
+bool setLevel(LogManager& logManager, const std::vector<std::string>& args) {
+    LogLevel level;
+    if (args.size() > 2) {
+        std::cout << USAGE << std::endl;
+        return false;
+    }
+    if (!stringToLogLevel(args[0], level)) {
+        std::cout << "Error: Invalid log level '" << args[0] << "', expected info, warning or error." << std::endl;
+        return false;
+    }
+    unsigned milliseconds = logManager.getFlushInterval();
+    if (args.size() == 2) {
+        auto [end, ec] = std::from_chars(args[1].data(), args[1].data() + args[1].size(), milliseconds);
+        if (ec != std::errc() || end != args[1].data() + args[1].size() || milliseconds == 0) {
+            std::cout << "Error: Invalid log flush interval '" << args[1] << "'." << std::endl;
+            return false;
+        }
+    }
+
+    logManager.setMinimumLevel(level);
+    logManager.setFlushInterval(milliseconds);
+    std::cout << "Log level set to " << levelName(level) << ", flush interval to " << milliseconds << " ms" << std::endl;
+    return true;
+}
+
+bool setFormat(LogManager& logManager, const std::vector<std::string>& args) {
+    LogFormat format;
+    if (args.size() != 2 || !stringToLogFormat(args[1], format)) {
+        std::cout << "Usage: .set log format <text|binary>" << std::endl;
+        return false;
+    }
+    logManager.setFormat(format);
+    std::cout << "Log format set to " << args[1] << ", writing " << (format == LogFormat::BINARY ? "data/logs.bin" : "data/logs.txt") << std::endl;
+    return true;
+}
+
+bool setRotation(LogManager& logManager, const std::vector<std::string>& args) {
+    if (args.size() < 3 || args.size() > 4 || (args.size() == 4 && args[3] != "compress")) {
+        std::cout << "Usage: .set log rotate <kilobytes> <seconds> [compress]" << std::endl;
+        return false;
+    }
+    size_t kilobytes = 0;
+    auto [sizeEnd, sizeError] = std::from_chars(args[1].data(), args[1].data() + args[1].size(), kilobytes);
+    if (sizeError != std::errc() || sizeEnd != args[1].data() + args[1].size() || kilobytes > std::numeric_limits<size_t>::max() / 1024) {
+        std::cout << "Error: Invalid log rotation size '" << args[1] << "'." << std::endl;
+        return false;
+    }
+    unsigned seconds = 0;
+    auto [ageEnd, ageError] = std::from_chars(args[2].data(), args[2].data() + args[2].size(), seconds);
+    if (ageError != std::errc() || ageEnd != args[2].data() + args[2].size()) {
+        std::cout << "Error: Invalid log rotation age '" << args[2] << "'." << std::endl;
+        return false;
+    }
+    bool compress = args.size() == 4;
+    logManager.setRotation(kilobytes * 1024, seconds, compress);
+    std::cout << "Log rotation set to " << kilobytes << " KB, " << seconds << " s" << (compress ? ", compressed" : "") << std::endl;
+    return true;
+}
+
+}
+
+SetLogCommand::SetLogCommand(std::string& currentUser)
+    : currentUser(currentUser) {}
+
+bool SetLogCommand::execute(const std::vector<std::string>& args) {
+    LogManager& logManager = LogManager::getInstance();
+    if (args.empty()) {
+        size_t bytes = 0;
+        unsigned seconds = 0;
+        bool compress = false;
+        logManager.getRotation(bytes, seconds, compress);
+        std::cout << "Log level: " << levelName(logManager.getMinimumLevel()) << ", flush interval: "
+                  << logManager.getFlushInterval() << " ms, format: " << (logManager.getFormat() == LogFormat::BINARY ? "binary" : "text")
+                  << ", rotation: " << bytes / 1024 << " KB, " << seconds << " s" << (compress ? ", compressed" : "") << std::endl;
+        std::cout << USAGE << std::endl;
+        return true;
+    }
+
+    CHECK_USER_ADMIN(currentUser)
+
+    if (args[0] == "format") {
+        return setFormat(logManager, args);
+    }
+    if (args[0] == "rotate") {
+        return setRotation(logManager, args);
+    }
+    return setLevel(logManager, args);
+}
@@ -0,0 +1,21 @@
+#ifndef SET_STORAGE_COMMAND_H
+#define SET_STORAGE_COMMAND_H
+
+#include "commands/command.h"
+#include "databaseManager/databaseManager.h"
+#include <string>
+#include "checks.h"
+#include <vector>
+#include <iostream>
+#include "logManager/logManager.h"
+
+class SetStorageCommand : public Command {
+public:
+    SetStorageCommand(std::string& currentUser);
+    bool execute(const std::vector<std::string>& args) override;
+
+private:
+    std::string &currentUser;
+};
+
+#endif
@@ -0,0 +1,75 @@
+#include "headers/setStorageCommand.h"
+#include "sqlManager/sqlManager.h"
+#include "lockManager/lockManager.h"
+SetStorageCommand::SetStorageCommand(std::string& currentUser)
+    : currentUser(currentUser) {}
+
+bool SetStorageCommand::execute(const std::vector<std::string>& args) {
+    checkUserLoggedIn(currentUser);
+    if (args.size() != 2) {
+        DISPLAY_MESSAGE("Usage: .set storage <databaseName> <json|columnar|paged>");
+        return false;
+    }
+
+    const std::string& dbName = args[0];
+    StorageFormat newFormat;
+    try {
+        newFormat = stringToStorageFormat(args[1]);
+    } catch (const std::invalid_argument&) {
+        DISPLAY_MESSAGE("Error: Unknown storage format '" + args[1] + "'. Use json, columnar or paged.");
+        return false;
+    }
+
+    INIT_DB_MANAGER;
+    INIT_SQL_MANAGER;
+
+    if (!dbManager.databaseExists(dbName)) {
+        DISPLAY_MESSAGE("Error: Database '" + dbName + "' does not exist.");
+        return false;
+    }
+    if (!dbManager.isOwner(dbName, currentUser)) {
+        DISPLAY_MESSAGE("Error: User '" + currentUser + "' is not the owner of '" + dbName + "'.");
+        LOG(LogLevel::ERROR, dbName, currentUser, "User '" + currentUser + "' attempted to change storage of database '" + dbName + "' without ownership.");
+        return false;
+    }
+
+    StorageFormat oldFormat = dbManager.getStorageFormat(dbName);
+    if (oldFormat == newFormat) {
+        DISPLAY_MESSAGE("Database '" + dbName + "' already uses " + args[1] + " storage.");
+        return true;
+    }
+
+    if (IS_LOCKED(dbName, LockFileType::DATABASE_MANAGER)) {
+        DISPLAY_MESSAGE(dbName + " config file is currently locked... try again later");
+        return false;
+    }
+    if (IS_LOCKED(dbName, LockFileType::DATABASE)) {
+        DISPLAY_MESSAGE(dbName + " file is currently locked... try again later");
+        return false;
+    }
+
+    LOCK(dbName, LockFileType::DATABASE, currentUser, "Set STORAGE - database file");
+    LOCK(dbName, LockFileType::DATABASE_MANAGER, currentUser, "Set STORAGE - database config file");
+
+    // The new table files are written before the catalog switches over, so a failure leaves the old copies in use.
+    json dbContent;
+    bool converted = false;
+    if (!sqlManager.readDatabaseFile(dbName, oldFormat, dbContent) ||
+        !sqlManager.writeDatabaseFile(dbName, newFormat, dbContent)) {
+        sqlManager.removeTableFiles(dbName, newFormat, dbContent);
+        DISPLAY_MESSAGE("Error: Failed to convert database '" + dbName + "' to " + args[1] + " storage.");
+        LOG(LogLevel::ERROR, dbName, currentUser, "Failed to convert database '" + dbName + "' to " + args[1] + " storage.");
+    } else if (!dbManager.setStorageFormat(dbName, newFormat)) {
+        sqlManager.removeTableFiles(dbName, newFormat, dbContent);
+        DISPLAY_MESSAGE("Error: Failed to update storage format of database '" + dbName + "'.");
+    } else {
+        sqlManager.removeTableFiles(dbName, oldFormat, dbContent);
+        converted = true;
+        DISPLAY_MESSAGE("Database '" + dbName + "' now uses " + args[1] + " storage.");
+        LOG(LogLevel::INFO, dbName, currentUser, "Database '" + dbName + "' converted to " + args[1] + " storage.");
+    }
+
+    UNLOCK(dbName, LockFileType::DATABASE_MANAGER);
+    UNLOCK(dbName, LockFileType::DATABASE);
+    return converted;
+}
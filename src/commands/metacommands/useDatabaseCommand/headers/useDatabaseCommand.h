@@ -3,16 +3,18 @@
 
 #include "checks.h"
 #include "commands/command.h"
+#include "databaseManager/databaseManager.h"
 #include <string>
 class UseDatabaseCommand : public Command {
 public:
-    UseDatabaseCommand(std::string& currentUser, std::string& currentDatabase);
+    UseDatabaseCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
 
-    void execute(const std::vector<std::string>& args) override;
+    bool execute(const std::vector<std::string>& args) override;
 
 private:
     std::string& currentUser;
     std::string& currentDatabase;
+    SessionPermissions& sessionPermissions;
 };
 
 #endif
@@ -4,15 +4,15 @@
 #include <iostream>
 #include "lockManager/lockManager.h"
 
-UseDatabaseCommand::UseDatabaseCommand(std::string& currentUser, std::string& currentDatabase)
-    : currentUser(currentUser), currentDatabase(currentDatabase) {}
+UseDatabaseCommand::UseDatabaseCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions)
+    : currentUser(currentUser), currentDatabase(currentDatabase), sessionPermissions(sessionPermissions) {}
 
-void UseDatabaseCommand::execute(const std::vector<std::string>& args) {
+bool UseDatabaseCommand::execute(const std::vector<std::string>& args) {
     checkUserLoggedIn(currentUser);
     checkDatabaseSelected(currentUser,currentDatabase);
     if (args.size() != 1) {
         DISPLAY_MESSAGE("Usage: .use <database name>");
-        return;
+        return false;
     }
 
     INIT_DB_MANAGER;
@@ -24,18 +24,20 @@ void UseDatabaseCommand::execute(const std::vector<std::string>& args) {
         UNLOCK("",LockFileTypeToUse);
         LOG(LogLevel::ERROR, toUseDatabase, currentUser, "Database does not exist.");
         DISPLAY_MESSAGE("Error: Database '" + toUseDatabase + "' does not exist.");
-        return;
+        return false;
     }
 
-    if (!dbManager.canUseDatabase(toUseDatabase, currentUser)) {
+    dbManager.resolveSessionPermissions(sessionPermissions, toUseDatabase, currentUser);
+    if (sessionPermissions.mask == 0) {
         UNLOCK("",LockFileTypeToUse);
         LOG(LogLevel::ERROR, toUseDatabase, currentUser, "User '" + currentUser + "' does not have permission to use database '" + toUseDatabase + "'.");
         DISPLAY_MESSAGE("Error: You do not have permission to use database '" + toUseDatabase + "'.");
-        return;
+        return false;
     }
     UNLOCK("",LockFileTypeToUse);
     currentDatabase = toUseDatabase;
     LOG(LogLevel::INFO, currentDatabase, currentUser, "Switched to database: " + currentDatabase);
 
     DISPLAY_MESSAGE("Switched to database: " + currentDatabase);
+    return true;
 }
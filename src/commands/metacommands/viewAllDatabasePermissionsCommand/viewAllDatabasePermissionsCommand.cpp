@@ -4,10 +4,10 @@ ViewAllDatabasePermissionsCommand::ViewAllDatabasePermissionsCommand(std::string
     : currentUser(currentUser) {
 }
 
-void ViewAllDatabasePermissionsCommand::execute(const std::vector<std::string>& args) {
+bool ViewAllDatabasePermissionsCommand::execute(const std::vector<std::string>& args) {
     if (args.size() < 1 || args.size() > 1) {
         DISPLAY_MESSAGE("Usage: .view database permissions <databaseName>");
-        return;
+        return false;
     }
 
     std::string databaseName = args[0];
@@ -18,7 +18,7 @@ void ViewAllDatabasePermissionsCommand::execute(const std::vector<std::string>&
     if (databasePermissionsMap.find(databaseName) == databasePermissionsMap.end()) {
         DISPLAY_MESSAGE("Database '" + databaseName + "' does not exist, is private or you don't have permission to view it.");
         LOG(LogLevel::ERROR, databaseName, currentUser, "Database '" + databaseName + "' does not exist, is private or permission denied.");
-        return;
+        return false;
     }
 
     const auto& databasePermissions = databasePermissionsMap.at(databaseName);
@@ -35,4 +35,5 @@ void ViewAllDatabasePermissionsCommand::execute(const std::vector<std::string>&
             DISPLAY_MESSAGE("  - Permission: " + dbManager.permissionToString(permission));
         }
     }
+    return true;
 }
@@ -0,0 +1,89 @@
+#include "commands/outputCapture.h"
+#include <iostream>
+#include <streambuf>
+#include <mutex>
+
+namespace {
+
+thread_local std::string* captureTarget = nullptr;
+
+// Stream buffer that hands characters to the capture target of the writing thread, or to
+// the stream's original buffer when the thread has none.
+class RoutingBuffer : public std::streambuf {
+public:
+    explicit RoutingBuffer(std::streambuf* original) : original(original) {}
+
+    std::streambuf* originalBuffer() const { return original; }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (traits_type::eq_int_type(c, traits_type::eof())) {
+            return traits_type::not_eof(c);
+        }
+        if (captureTarget) {
+            captureTarget->push_back(traits_type::to_char_type(c));
+            return c;
+        }
+        return original->sputc(traits_type::to_char_type(c));
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize count) override {
+        if (captureTarget) {
+            captureTarget->append(s, static_cast<size_t>(count));
+            return count;
+        }
+        return original->sputn(s, count);
+    }
+
+    int sync() override {
+        return captureTarget ? 0 : original->pubsync();
+    }
+
+private:
+    std::streambuf* original;
+};
+
+std::mutex routingMutex;
+size_t routingCount = 0;
+RoutingBuffer* coutRouting = nullptr;
+RoutingBuffer* cerrRouting = nullptr;
+
+}
+
+OutputCapture::Routing::Routing() {
+    std::lock_guard<std::mutex> lock(routingMutex);
+    if (routingCount++ == 0) {
+        coutRouting = new RoutingBuffer(std::cout.rdbuf());
+        cerrRouting = new RoutingBuffer(std::cerr.rdbuf());
+        std::cout.rdbuf(coutRouting);
+        std::cerr.rdbuf(cerrRouting);
+    }
+}
+
+// A stream the program pointed elsewhere meanwhile is left as it is, and its routing buffer
+// is not freed, since the program may still hold it to put back later.
+OutputCapture::Routing::~Routing() {
+    std::lock_guard<std::mutex> lock(routingMutex);
+    if (--routingCount > 0) {
+        return;
+    }
+    std::cout.flush();
+    std::cerr.flush();
+    if (std::cout.rdbuf() == coutRouting) {
+        std::cout.rdbuf(coutRouting->originalBuffer());
+        delete coutRouting;
+    }
+    if (std::cerr.rdbuf() == cerrRouting) {
+        std::cerr.rdbuf(cerrRouting->originalBuffer());
+        delete cerrRouting;
+    }
+    coutRouting = cerrRouting = nullptr;
+}
+
+OutputCapture::OutputCapture(std::string& target) : previous(captureTarget) {
+    captureTarget = &target;
+}
+
+OutputCapture::~OutputCapture() {
+    captureTarget = previous;
+}
@@ -0,0 +1,34 @@
+#ifndef OUTPUT_CAPTURE_H
+#define OUTPUT_CAPTURE_H
+
+#include <string>
+
+// Commands print their results to std::cout and std::cerr. For the server and the library
+// both streams are routed per thread: while an OutputCapture is alive, everything the
+// constructing thread writes to either stream is appended to its target instead, so a
+// worker can send the output of a command to the client that ran it. Other threads write
+// to the terminal as before. A Routing must be alive while any capture is made.
+class OutputCapture {
+public:
+    // Puts the routing buffers in front of the buffers of std::cout and std::cerr while it
+    // is alive. Routings nest: the streams get their own buffers back when the last one is
+    // destroyed, so a program using the library keeps its streams as it set them. Make and
+    // destroy it while no other thread writes to the streams.
+    class Routing {
+    public:
+        Routing();
+        ~Routing();
+        Routing(const Routing&) = delete;
+        Routing& operator=(const Routing&) = delete;
+    };
+
+    explicit OutputCapture(std::string& target);
+    ~OutputCapture();
+    OutputCapture(const OutputCapture&) = delete;
+    OutputCapture& operator=(const OutputCapture&) = delete;
+
+private:
+    std::string* previous;
+};
+
+#endif
@@ -0,0 +1,19 @@
+#include "commands/resultSink.h"
+
+namespace {
+
+thread_local ResultSink* currentSink = nullptr;
+
+}
+
+ResultSink* ResultSink::current() {
+    return currentSink;
+}
+
+ResultSink::Scope::Scope(ResultSink& sink) : previous(currentSink) {
+    currentSink = &sink;
+}
+
+ResultSink::Scope::~Scope() {
+    currentSink = previous;
+}
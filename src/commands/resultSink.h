@@ -0,0 +1,41 @@
+#ifndef RESULT_SINK_H
+#define RESULT_SINK_H
+
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "storageManager/rowExporter.h"
+
+using json = nlohmann::json;
+using ResultColumn = RowExporter::Column;
+
+// Receives the result of a SELECT in place of the table printer. While a Scope is alive,
+// every SELECT run by the thread that made it hands its columns and rows to the sink;
+// anything else the commands print still goes to the output streams. A statement joining
+// several tables gives one result with columns named table.column, as INTO OUTFILE writes.
+class ResultSink {
+public:
+    virtual ~ResultSink() = default;
+
+    // Called once per result, before its rows.
+    virtual void begin(const std::vector<ResultColumn>& columns) = 0;
+    // row holds the values of the columns by name; a missing member is NULL. False ends the
+    // result early, after reporting why on std::cerr.
+    virtual bool addRow(const json& row) = 0;
+    virtual void finish() = 0;
+
+    // The sink of the calling thread, or nullptr when results are printed.
+    static ResultSink* current();
+
+    class Scope {
+    public:
+        explicit Scope(ResultSink& sink);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        ResultSink* previous;
+    };
+};
+
+#endif
@@ -2,61 +2,46 @@
 
 using json = nlohmann::json;
 
-CreateTableCommand::CreateTableCommand(std::string& currentUser, std::string& currentDatabase)
-    : currentUser(currentUser), currentDatabase(currentDatabase) {}
-
-void trim(std::string& str) {
-    size_t first = str.find_first_not_of(' ');
-    size_t last = str.find_last_not_of(' ');
-    str = str.substr(first, (last - first + 1));
-}
+CreateTableCommand::CreateTableCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions)
+    : currentUser(currentUser), currentDatabase(currentDatabase), sessionPermissions(sessionPermissions) {}
 
+// args holds one or more table definitions: name (column type [{properties}], ...)
 void CreateTableCommand::parseTables(const std::string& args, std::vector<std::pair<std::string, std::vector<json>>>& tables) {
-    std::regex tableRegex(R"(([^,]+)\(([^)]+)\))");
-    std::regex columnRegex(R"((\w+)\s+(\w+)(\s*\{[^}]*\})?)");
-    auto tablesBegin = std::sregex_iterator(args.begin(), args.end(), tableRegex);
-    auto tablesEnd = std::sregex_iterator();
-
-    for (std::sregex_iterator i = tablesBegin; i != tablesEnd; ++i) {
-        std::smatch match = *i;
-        std::string tableName = match.str(1);
-        trim(tableName);
-        std::string columnsStr = match.str(2);
+    std::string_view rest = args;
+    std::string_view columnsStr;
+    while (Lexer::enclosed(rest, '(', ')', columnsStr)) {
+        std::string_view namePart = rest.substr(0, rest.find('('));
+        rest.remove_prefix(columnsStr.data() + columnsStr.size() + 1 - rest.data());
+        std::string tableName(Lexer::trim(namePart.substr(namePart.find_last_of(',') + 1)));
+        if (tableName.empty()) {
+            continue;
+        }
 
         std::vector<json> columns;
-        auto columnsBegin = std::sregex_iterator(columnsStr.begin(), columnsStr.end(), columnRegex);
-        auto columnsEnd = std::sregex_iterator();
-
-        for (std::sregex_iterator j = columnsBegin; j != columnsEnd; ++j) {
-            std::smatch colMatch = *j;
-            std::string colName = colMatch.str(1);
-            std::string colType = colMatch.str(2);
-            std::string colPropsStr = colMatch.str(3);
-            json column = {{"name", colName}, {"type", colType}, {"properties", json::array()}};
-
-            if (!colPropsStr.empty()) {
-                std::regex propsRegex(R"(\{([^}]*)\})");
-                std::smatch propsMatch;
-                if (std::regex_search(colPropsStr, propsMatch, propsRegex)) {
-                    std::string props = propsMatch.str(1);
-                    std::stringstream ss(props);
-                    std::string prop;
-                    while (std::getline(ss, prop, ',')) {
-                        prop.erase(0, prop.find_first_not_of(" \t"));
-                        prop.erase(prop.find_last_not_of(" \t") + 1);
-                        if (prop == "PRIMARY KEY" || prop == "AUTO_INCREMENT" || prop == "UNIQUE") {
-                            column["properties"].push_back(prop);
-                        } else if (prop.find("FOREIGN KEY REFERENCES") != std::string::npos) {
-                            std::regex fkRegex(R"(FOREIGN KEY REFERENCES (\w+) (\w+))");
-                            std::smatch fkMatch;
-                            if (std::regex_search(prop, fkMatch, fkRegex)) {
-                                json references = {{"table", fkMatch.str(1)}, {"column", fkMatch.str(2)}};
-                                column["properties"].push_back(references);
-                            } else {
-                                std::cerr << "Error: Invalid FOREIGN KEY properties for column '" << colName << "'." << std::endl;
-                                return;
-                            }
+        for (std::string_view columnDefinition : Lexer::splitTopLevel(columnsStr, ',')) {
+            std::string_view propsStr;
+            bool hasProps = Lexer::enclosed(columnDefinition, '{', '}', propsStr);
+            std::vector<std::string_view> words = Lexer::tokenize(columnDefinition.substr(0, columnDefinition.find('{')));
+            if (words.size() != 2) {
+                std::cerr << "Error: Invalid column definition '" << columnDefinition << "' in table '" << tableName << "'." << std::endl;
+                return;
+            }
+            std::string colName(words[0]);
+            json column = {{"name", colName}, {"type", std::string(words[1])}, {"properties", json::array()}};
+
+            if (hasProps) {
+                for (std::string_view prop : Lexer::splitTopLevel(propsStr, ',')) {
+                    if (prop == "PRIMARY KEY" || prop == "AUTO_INCREMENT" || prop == "UNIQUE") {
+                        column["properties"].push_back(prop);
+                    } else if (prop.find("FOREIGN KEY REFERENCES") != std::string_view::npos) {
+                        // FOREIGN KEY REFERENCES <table> <column>
+                        std::vector<std::string_view> fkWords = Lexer::tokenize(prop);
+                        if (fkWords.size() != 5 || fkWords[0] != "FOREIGN" || fkWords[1] != "KEY" || fkWords[2] != "REFERENCES") {
+                            std::cerr << "Error: Invalid FOREIGN KEY properties for column '" << colName << "'." << std::endl;
+                            return;
                         }
+                        json references = {{"table", fkWords[3]}, {"column", fkWords[4]}};
+                        column["properties"].push_back(references);
                     }
                 }
             }
@@ -67,28 +52,27 @@ void CreateTableCommand::parseTables(const std::string& args, std::vector<std::p
 }
 
 
-void CreateTableCommand::execute(const std::vector<std::string>& args) {
+bool CreateTableCommand::execute(const std::vector<std::string>& args) {
     checkUserLoggedIn(currentUser);
     checkDatabaseSelected(currentUser, currentDatabase);
     INIT_DB_MANAGER;
     LockFileType LockFileTypeToUse = LockFileType::DATABASE;
 
-    bool isOwner = IS_OWNER(currentDatabase, currentUser);
-    bool hasWritePermission = CHECK_USER_PERMISSION(currentDatabase, currentUser, Permission::WRITE);
+    bool hasWritePermission = CHECK_SESSION_PERMISSION(sessionPermissions, currentDatabase, currentUser, Permission::WRITE);
 
-    if (!isOwner && !hasWritePermission) {
+    if (!hasWritePermission) {
         DISPLAY_MESSAGE("Current user is neither the owner nor has write permission for " + currentDatabase);
-        return;
+        return false;
     }
 
     if (args.empty()) {
         std::cerr << "Error: No table creation arguments provided." << std::endl;
-        return;
+        return false;
     }
 
     if (IS_LOCKED(currentDatabase, LockFileTypeToUse)){
         DISPLAY_MESSAGE(currentDatabase + " is currently locked... try again later");
-        return;
+        return false;
     }
     LOCK(currentDatabase, LockFileTypeToUse, currentUser, "CREATE TABLE");
 
@@ -100,12 +84,15 @@ void CreateTableCommand::execute(const std::vector<std::string>& args) {
     std::vector<std::pair<std::string, std::vector<json>>> tables;
     parseTables(argsStr, tables);
     INIT_SQL_MANAGER;
+    bool allCreated = true;
     for (const auto& table : tables) {
         const std::string& tableName = table.first;
         const std::vector<json>& columns = table.second;
         if (!sqlManager.createTable(currentDatabase, tableName, columns)) {
             std::cerr << "Error: Failed to create table '" << tableName << "' in database '" << currentDatabase << "'." << std::endl;
+            allCreated = false;
         }
     }
     UNLOCK(currentDatabase, LockFileTypeToUse);
+    return allCreated;
 }
@@ -3,7 +3,7 @@
 
 #include "commands/command.h"
 #include <iostream>
-#include <regex>
+#include "parser/lexer.h"
 #include "checks.h"
 #include "databaseManager/databaseManager.h"
 #include "sqlManager/sqlManager.h"
@@ -11,11 +11,12 @@
 
 class CreateTableCommand : public Command {
 public:
-    CreateTableCommand(std::string &currentUser, std::string& currentDatabase);
-    void execute(const std::vector<std::string>& args) override;
+    CreateTableCommand(std::string &currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
+    bool execute(const std::vector<std::string>& args) override;
 private:
     std::string& currentUser;
     std::string& currentDatabase;
+    SessionPermissions& sessionPermissions;
     void parseTables(const std::string& args, std::vector<std::pair<std::string, std::vector<json>>>& tables);
 };
 
@@ -1,19 +1,20 @@
 #ifndef DELETE_COMMAND_H
 #define DELETE_COMMAND_H
 
-#include "commands/command.h"
+#include "commands/statementCommand.h"
+#include "databaseManager/databaseManager.h"
 #include <iostream>
 #include <map>
-class DeleteCommand : public Command {
+class DeleteCommand : public StatementCommand {
 public:
-    DeleteCommand(std::string& currentUser, std::string& currentDatabase);
-    virtual void execute(const std::vector<std::string>& args) override;
-    std::map<std::string, std::map<std::string, std::vector<std::string>>> parseArgsForDeletion(std::vector<std::string>& args);
+    DeleteCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
+    virtual bool run(const Statement& statement) override;
 
 private:
     bool checkPermissions();
     std::string& currentUser;
     std::string& currentDatabase;
+    SessionPermissions& sessionPermissions;
 };
 
 #endif
@@ -1,49 +1,41 @@
 #include "headers/describeCommand.h"
 
-DescribeCommand::DescribeCommand(std::string &currentUser, std::string &currentDatabase)
-: currentUser(currentUser), currentDatabase(currentDatabase) {}
+DescribeCommand::DescribeCommand(std::string &currentUser, std::string &currentDatabase, SessionPermissions& sessionPermissions)
+: currentUser(currentUser), currentDatabase(currentDatabase), sessionPermissions(sessionPermissions) {}
 
-void DescribeCommand::execute(const std::vector<std::string>& args) {
+bool DescribeCommand::execute(const std::vector<std::string>& args) {
     INIT_DB_MANAGER;
     INIT_SQL_MANAGER;
-    LockFileType LockFileTypeToUse = LockFileType::DATABASE;
     checkUserLoggedIn(currentUser);
     checkDatabaseSelected(currentUser, currentDatabase);
 
-    bool isOwner = IS_OWNER(currentDatabase, currentUser);
-    bool hasReadPermissions = CHECK_USER_PERMISSION(currentDatabase, currentUser, Permission::READ);
+    bool hasReadPermissions = CHECK_SESSION_PERMISSION(sessionPermissions, currentDatabase, currentUser, Permission::READ);
 
-    if (!isOwner && !hasReadPermissions) {
+    if (!hasReadPermissions) {
         DISPLAY_MESSAGE("Current user is neither the owner nor has read permission for database '" + currentDatabase + "'.");
-        return;
+        return false;
     }
 
     if (args.size() != 1) {
         std::cerr << "Error: Invalid arguments for DESCRIBE command." << std::endl;
-        return;
+        return false;
     }
 
-    if (IS_LOCKED(currentDatabase, LockFileTypeToUse)){
-        DISPLAY_MESSAGE(currentDatabase + " is currently locked... try again later");
-        return;
-    }
-    LOCK(currentDatabase, LockFileTypeToUse, currentUser, "DESCRIBE");
-
+    // Schema lookups are served from the cached schema.json, which writers replace atomically,
+    // so DESCRIBE neither reads row data nor takes the database lock.
     std::string tableName = args[0];
     std::cout << "Describing table '" << tableName << "' in database '" << currentDatabase << "'." << std::endl;
 
-    json dbContent;
-    if (!sqlManager.readDatabaseFile(currentDatabase, dbContent)) {
+    std::shared_ptr<const json> schema = dbManager.getSchema(currentDatabase);
+    if (!schema) {
         std::cerr << "Error: Database '" << currentDatabase << "' does not exist." << std::endl;
-        UNLOCK(currentDatabase, LockFileTypeToUse);
-        return;
+        return false;
     }
 
-    json table = sqlManager.findTable(dbContent, tableName);
+    const json table = sqlManager.findTable(*schema, tableName);
     if (table.is_null()) {
         std::cerr << "Error: Table '" << tableName << "' does not exist in database '" << currentDatabase << "'." << std::endl;
-        UNLOCK(currentDatabase, LockFileTypeToUse);
-        return;
+        return false;
     }
 
     std::cout << "Table: " << tableName << std::endl;
@@ -54,6 +46,5 @@ void DescribeCommand::execute(const std::vector<std::string>& args) {
         std::string columnType = column["type"];
         std::cout << "  " << columnName << " " << columnType << std::endl;
     }
-    UNLOCK(currentDatabase, LockFileTypeToUse);
-
+    return true;
 }
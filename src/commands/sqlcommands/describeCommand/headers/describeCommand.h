@@ -11,11 +11,12 @@
 
 class DescribeCommand : public Command {
 public:
-    DescribeCommand(std::string& currentUser, std::string& currentDatabase);
-    virtual void execute(const std::vector<std::string>& args) override;
+    DescribeCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
+    virtual bool execute(const std::vector<std::string>& args) override;
 private:
     std::string &currentUser;
     std::string &currentDatabase;
+    SessionPermissions& sessionPermissions;
 };
 
 #endif
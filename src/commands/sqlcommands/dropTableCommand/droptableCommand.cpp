@@ -1,56 +1,34 @@
 #include "headers/dropTableCommand.h"
 
-DropTableCommand::DropTableCommand(std::string& currentUser, std::string& currentDatabase)
-    : currentUser(currentUser), currentDatabase(currentDatabase){}
+DropTableCommand::DropTableCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions)
+    : currentUser(currentUser), currentDatabase(currentDatabase), sessionPermissions(sessionPermissions){}
 
-void DropTableCommand::execute(const std::vector<std::string>& args) {
+bool DropTableCommand::execute(const std::vector<std::string>& args) {
     INIT_DB_MANAGER;
     INIT_SQL_MANAGER;
     LockFileType LockFileTypeToUse = LockFileType::DATABASE;
     checkUserLoggedIn(currentUser);
     checkDatabaseSelected(currentUser, currentDatabase);
 
-    bool isOwner = IS_OWNER(currentDatabase, currentUser);
-    bool hasWritePermissions = CHECK_USER_PERMISSION(currentDatabase, currentUser, Permission::WRITE);
+    bool hasWritePermissions = CHECK_SESSION_PERMISSION(sessionPermissions, currentDatabase, currentUser, Permission::WRITE);
 
-    if (!isOwner && !hasWritePermissions) {
+    if (!hasWritePermissions) {
         DISPLAY_MESSAGE("Current user is neither the owner nor has read permission for database '" + currentDatabase + "'.");
-        return;
+        return false;
     }
         if (args.size() != 1) {
         std::cerr << "Error: Invalid arguments for DROP TABLE command." << std::endl;
-        return;
+        return false;
     }
 
     std::string tableName = args[0];
 
     if (IS_LOCKED(currentDatabase, LockFileTypeToUse)){
         DISPLAY_MESSAGE(currentDatabase + " is currently locked... try again later");
-        return;
+        return false;
     }
     LOCK(currentDatabase, LockFileTypeToUse, currentUser, "DROP TABLE");
-    json dbContent;
-    if (!sqlManager.readDatabaseFile(currentDatabase, dbContent)) {
-        std::cerr << "Error: Failed to read database file for database '" << currentDatabase << "'." << std::endl;
-        UNLOCK(currentDatabase, LockFileTypeToUse);
-        return;
-    }
-
-    auto tableIt = std::find_if(dbContent["tables"].begin(), dbContent["tables"].end(),
-                                [&tableName](const json& table) { return table["table_name"] == tableName; });
-
-    if (tableIt == dbContent["tables"].end()) {
-        std::cerr << "Error: Table '" << tableName << "' does not exist in database '" << currentDatabase << "'." << std::endl;
-        UNLOCK(currentDatabase, LockFileTypeToUse);
-        return;
-    }
-
-    dbContent["tables"].erase(tableIt);
-
-    if (!sqlManager.writeDatabaseFile(currentDatabase, dbContent)) {
-        std::cerr << "Error: Failed to write database file for database '" << currentDatabase << "'." << std::endl;
-        UNLOCK(currentDatabase, LockFileTypeToUse);
-        return;
-    }
+    bool dropped = sqlManager.dropTable(currentDatabase, tableName);
     UNLOCK(currentDatabase, LockFileTypeToUse);
+    return dropped;
 }
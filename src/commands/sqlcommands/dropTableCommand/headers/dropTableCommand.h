@@ -13,11 +13,12 @@
 #include "checks.h"
 class DropTableCommand : public Command {
 public:
-    DropTableCommand(std::string& currentUser, std::string& currentDatabase);
-    virtual void execute(const std::vector<std::string>& args) override;
+    DropTableCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
+    virtual bool execute(const std::vector<std::string>& args) override;
 private:
     std::string& currentUser;
     std::string& currentDatabase;
+    SessionPermissions& sessionPermissions;
 };
 
 #endif
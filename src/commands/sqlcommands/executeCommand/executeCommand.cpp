@@ -0,0 +1,43 @@
+#include "headers/executeCommand.h"
+#include "commands/statementCommand.h"
+#include "parser/sqlParser.h"
+
+ExecuteCommand::ExecuteCommand(const CommandFactory& commandFactory, const PreparedStatements& preparedStatements)
+    : commandFactory(commandFactory), preparedStatements(preparedStatements) {}
+
+// EXECUTE name [(value, ...)] binds the values to the placeholders of a prepared statement,
+// in order, and runs it through the command of its kind, with that command's permission
+// checks and locking.
+bool ExecuteCommand::execute(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        std::cerr << "Error: Invalid arguments for EXECUTE command, EXECUTE <name> [(<values>)]." << std::endl;
+        return false;
+    }
+
+    auto prepared = preparedStatements.find(args[0]);
+    if (prepared == preparedStatements.end()) {
+        std::cerr << "Error: No prepared statement named '" << args[0] << "'." << std::endl;
+        return false;
+    }
+
+    std::vector<Literal> values;
+    SqlParser parser(joinArguments(std::vector<std::string>(args.begin() + 1, args.end())));
+    if (!parser.parseValues(values)) {
+        std::cerr << "Error: Invalid values for EXECUTE: " << parser.error() << "." << std::endl;
+        return false;
+    }
+
+    Statement statement;
+    std::string error;
+    if (!bindStatement(*prepared->second, values, statement, error)) {
+        std::cerr << "Error: Cannot execute '" << args[0] << "': " << error << "." << std::endl;
+        return false;
+    }
+
+    auto command = std::dynamic_pointer_cast<StatementCommand>(commandFactory.getCommand(statementKeyword(statement.kind)));
+    if (!command) {
+        std::cerr << "Error: No command runs " << statementKeyword(statement.kind) << " statements." << std::endl;
+        return false;
+    }
+    return command->run(statement);
+}
@@ -0,0 +1,19 @@
+#ifndef EXECUTE_COMMAND_H
+#define EXECUTE_COMMAND_H
+
+#include "commands/command.h"
+#include "commandFactory/headers/commandFactory.h"
+#include "parser/planCache.h"
+#include <iostream>
+#include <vector>
+#include <string>
+class ExecuteCommand : public Command {
+public:
+    ExecuteCommand(const CommandFactory& commandFactory, const PreparedStatements& preparedStatements);
+    virtual bool execute(const std::vector<std::string>& args) override;
+private:
+    const CommandFactory& commandFactory;
+    const PreparedStatements& preparedStatements;
+};
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef PREPARE_COMMAND_H
+#define PREPARE_COMMAND_H
+
+#include "commands/command.h"
+#include "parser/planCache.h"
+#include <iostream>
+#include <vector>
+#include <string>
+class PrepareCommand : public Command {
+public:
+    PrepareCommand(PreparedStatements& preparedStatements);
+    virtual bool execute(const std::vector<std::string>& args) override;
+private:
+    PreparedStatements& preparedStatements;
+};
+
+#endif
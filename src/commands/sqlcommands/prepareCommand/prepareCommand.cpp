@@ -0,0 +1,22 @@
+#include "headers/prepareCommand.h"
+#include "parser/sqlParser.h"
+
+PrepareCommand::PrepareCommand(PreparedStatements& preparedStatements)
+    : preparedStatements(preparedStatements) {}
+
+// PREPARE name AS statement parses a SELECT, INSERT, UPDATE or DELETE once and keeps it for
+// EXECUTE. Values left as ? or $n placeholders are given to EXECUTE.
+bool PrepareCommand::execute(const std::vector<std::string>& args) {
+    std::string name;
+    auto statement = std::make_shared<Statement>();
+    SqlParser parser(joinArguments(args));
+    if (!parser.parsePrepare(name, *statement)) {
+        std::cerr << "Error: Invalid PREPARE statement: " << parser.error() << "." << std::endl;
+        return false;
+    }
+
+    bool replaced = preparedStatements.count(name) > 0;
+    preparedStatements[name] = std::move(statement);
+    std::cout << "Statement '" << name << "' " << (replaced ? "replaced" : "prepared") << " with " << parser.parameterCount() << " parameter(s)." << std::endl;
+    return true;
+}
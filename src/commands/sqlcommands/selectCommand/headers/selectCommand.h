@@ -1,11 +1,10 @@
 #ifndef SELECT_COMMAND_H
 #define SELECT_COMMAND_H
 
-#include "commands/command.h"
+#include "commands/statementCommand.h"
 #include <iostream>
 #include <vector>
 #include <string>
-#include <regex>
 #include "sqlManager/sqlManager.h"
 #include "logManager/logManager.h"
 #include "databaseManager/databaseManager.h"
@@ -18,6 +17,10 @@
 #include "lockManager/lockManager.h"
 #include <future>
 #include <algorithm>
+#include <charconv>
+#include "parser/sqlParser.h"
+#include "storageManager/rowExporter.h"
+#include "commands/resultSink.h"
 
 const std::string CYAN = "\033[96m";
 const std::string RED = "\033[91m";
@@ -28,17 +31,14 @@ const std::string MAGENTA = "\033[95m";
 const std::string RESET = "\033[0m";
 
 
-class SelectCommand : public Command {
+class SelectCommand : public StatementCommand {
 
 public:
-    SelectCommand(std::string& currentUser, std::string& currentDatabase);
-    void execute(const std::vector<std::string>& args);
+    SelectCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
+    bool run(const Statement& statement) override;
 
 private:
 
-    std::string trim(const std::string& str);
-    void removeWhiteSpaces(std::vector<Join>& joinData);
-
     std::map<std::string, std::map<std::string, std::vector<std::string>>> mergeResultMaps(
     const std::map<std::string, std::map<std::string, std::vector<std::string>>>& existingMap,
     const std::map<std::string, std::map<std::string, std::vector<std::string>>>& joinMap
@@ -47,26 +47,23 @@ private:
 
     std::string randomColor();
     void printTable(const std::map<std::string, std::map<std::string, std::vector<std::string>>>& resultMap);
+    bool streamTable(const SelectStatement& statement, std::vector<std::string> columns);
     std::string& currentUser;
     std::string& currentDatabase;
-    std::vector<std::vector<std::string>> splitJoinsFromArgs(const std::vector<std::vector<std::string>>& joinParts);
+    SessionPermissions& sessionPermissions;
     void removeUnusedTables(std::map<std::string, std::vector<std::string>>& tableColumnMap);
     void displayQueryDetails(const std::map<std::string, std::vector<std::string>>& tableColumnMap);
-    std::string getJoinType(const std::vector<std::string>& joinStr);
-    bool detectJoinsFromArgs(const std::vector<std::string>& args);
-    std::vector<std::vector<std::string>> extractJoinsFromArgs(const std::vector<std::string>& args);
-    void parseJoinDetails(const std::vector<std::vector<std::string>>& joinStrs, std::vector<Join>& joinData);
-
-    std::string parseArgs(std::vector<std::string>& args, const std::string& keyword);
-    std::vector<Join> joins;
-
-    std::vector<std::string>::iterator FindInArgs(std::vector<std::string>& args, const std::string& stringToFind);
-    std::vector<std::string>::iterator FindOrderByInArgs(std::vector<std::string>& args);
     bool checkPermissions();
-    std::string parseArgsOrderBy(std::vector<std::string>& args);
-    std::string parseArgsWhere(std::vector<std::string>& args);
-    int parseArgsLimit(std::vector<std::string>& args);
-    std::map<std::string, std::vector<std::string>> parseArgsTablesColumns(const std::vector<std::string>& args);
+    bool buildTableColumnMap(const SelectStatement& statement, std::map<std::string, std::vector<std::string>>& tableColumnMap);
+    void applyOrderAndLimit(const SelectStatement& statement, std::map<std::string, std::map<std::string, std::vector<std::string>>>& resultMap);
+    bool outfileTarget(const SelectStatement& statement, std::string& filePath, ExportFormat& format);
+    bool streamOutfile(const SelectStatement& statement, const std::string& filePath, ExportFormat format, const std::vector<std::string>& columnNames);
+    bool writeOutfile(const SelectStatement& statement, const std::string& filePath, ExportFormat format, const ResultTableColumns& resultMap);
+    bool streamToSink(const SelectStatement& statement, const std::vector<std::string>& columnNames, ResultSink& sink);
+    bool writeToSink(const ResultTableColumns& resultMap, ResultSink& sink);
+    bool tableColumns(const std::string& tableName, const std::vector<std::string>& columnNames, std::vector<ResultColumn>& columns);
+    bool resultColumns(const ResultTableColumns& resultMap, std::vector<ResultColumn>& columns, std::vector<const std::vector<std::string>*>& values, size_t& rowCount);
+    static json resultRow(const std::vector<ResultColumn>& columns, const std::vector<const std::vector<std::string>*>& values, size_t row);
 
     std::map<std::string, std::map<std::string, std::vector<std::string>>>  combineJoinsAndResultMap(
     const std::map<std::string, std::map<std::string, std::vector<std::string>>>& resultMap,
@@ -0,0 +1,39 @@
+#ifndef TABLE_PRINTER_H
+#define TABLE_PRINTER_H
+
+#include <string>
+#include <vector>
+
+// Prints rows as a boxed table while they arrive. Rows are collected into pages of PAGE_ROWS
+// and each full page is printed at once, so the first rows of a large result show up before
+// the rest is read. Column widths come from the header and the first page; a later page
+// holding a wider value widens its column from there on, drawing a new separator line.
+// All output is built in one buffer that goes to std::cout a page or BUFFER_SIZE at a time.
+class TablePrinter {
+public:
+    static constexpr size_t PAGE_ROWS = 1000;
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    // The colors are ANSI sequences for the title and each column name.
+    TablePrinter(const std::string& title, const std::string& titleColor, std::vector<std::string> columns, std::vector<std::string> columnColors);
+
+    // cells holds one value per column, in the order of the columns.
+    void addRow(std::vector<std::string> cells);
+    // Prints the rows still pending and closes the table.
+    void finish();
+
+private:
+    void printPage();
+    void printBorder();
+    void printHeader();
+    void flush();
+
+    std::vector<std::string> columns;
+    std::vector<std::string> columnColors;
+    std::vector<size_t> widths;
+    std::vector<std::vector<std::string>> page;
+    std::string out;
+    bool headerPrinted = false;
+};
+
+#endif
@@ -1,25 +1,5 @@
 #include "headers/selectCommand.h"
 
-std::string SelectCommand::getJoinType(const std::vector<std::string>& joinStr) {
-    std::string joinType = "UNKNOWN JOIN TYPE";
-
-    std::unordered_set<std::string> validJoinTypes = {
-        "INNER", "LEFT", "RIGHT", "FULL"
-    };
-
-    for (const auto& str : joinStr) {
-        std::string upperStr = str;
-        std::transform(upperStr.begin(), upperStr.end(), upperStr.begin(), ::toupper);
-
-        if (validJoinTypes.count(upperStr) > 0) {
-            joinType = upperStr + " JOIN";
-            break;
-        }
-    }
-
-    return joinType;
-}
-
 void SelectCommand::removeUnusedTables(std::map<std::string, std::vector<std::string>>& tableColumnMap) {
     for (auto it = tableColumnMap.begin(); it != tableColumnMap.end();) {
         if (it->second.empty()) {
@@ -40,173 +20,6 @@ void SelectCommand::displayQueryDetails(const std::map<std::string, std::vector<
     }
 }
 
-bool SelectCommand::detectJoinsFromArgs(const std::vector<std::string>& args) {
-    std::vector<std::string> joinKeywords = {
-        "JOIN",
-        "INNER JOIN",
-        "LEFT JOIN",
-        "RIGHT JOIN",
-        "FULL JOIN"
-    };
-
-    for (const auto& keyword : joinKeywords) {
-        if (std::find(args.begin(), args.end(), keyword) != args.end()) {
-            return true;
-        }
-    }
-
-    return false;
-}
-std::vector<std::vector<std::string>> SelectCommand::extractJoinsFromArgs(const std::vector<std::string>& args) {
-    std::vector<std::vector<std::string>> joinParts;
-    std::vector<std::string> sqlKeywords = {"WHERE", "LIMIT", "ORDER"};
-    bool moreThanOneJoin = false;
-
-    auto it = args.begin();
-    while (it != args.end()) {
-        auto joinIt = std::find(it, args.end(), "JOIN");
-        if (joinIt == args.end()) break;
-
-        std::vector<std::string> joinPart;
-        if (joinIt != args.begin()) {
-            std::string prevToken = *(joinIt - 1);
-            if (std::all_of(prevToken.begin(), prevToken.end(), ::isupper)) {
-                joinPart.push_back(prevToken);
-            }
-        }
-
-        joinPart.push_back("JOIN");
-
-        auto onIt = std::find(joinIt + 1, args.end(), "ON");
-        if (onIt == args.end()) break;
-
-        auto nextJoinIt = std::find(joinIt + 1, args.end(), "JOIN");
-        auto nextKeywordIt = std::find_if(onIt + 1, args.end(), [&](const std::string& token) {
-            return std::find(sqlKeywords.begin(), sqlKeywords.end(), token) != sqlKeywords.end();
-        });
-
-        auto endIt = (nextJoinIt != args.end()) ? nextJoinIt : nextKeywordIt;
-
-        for (auto jt = joinIt + 1; jt != endIt && jt != args.end(); ++jt) {
-            joinPart.push_back(*jt);
-        }
-
-        joinParts.push_back(joinPart);
-
-        if (nextJoinIt != args.end()) {
-            moreThanOneJoin = true;
-        }
-
-        it = endIt;
-    }
-
-    if (moreThanOneJoin) {
-        std::vector<std::vector<std::string>> splitJoinParts = splitJoinsFromArgs(joinParts);
-        return splitJoinParts;
-    } else {
-        return joinParts;
-    }
-}
-std::vector<std::vector<std::string>> SelectCommand::splitJoinsFromArgs(const std::vector<std::vector<std::string>>& joinParts) {
-    std::vector<std::vector<std::string>> splitJoinParts;
-
-    for (const auto& joinPart : joinParts) {
-        std::vector<std::string> splitPart;
-        std::string joinStr;
-        for (const auto& token : joinPart) {
-            if (token == "JOIN") {
-                if (!joinStr.empty()) {
-                    splitJoinParts.push_back({joinStr});
-                }
-                joinStr.clear();
-            }
-            joinStr += token + " ";
-        }
-        if (!joinStr.empty()) {
-            splitJoinParts.push_back({joinStr});
-        }
-    }
-    return splitJoinParts;
-}
-
-std::vector<std::string> split(const std::string& str, char delimiter) {
-    std::vector<std::string> parts;
-    std::string part;
-    for (char c : str) {
-        if (c == delimiter) {
-            parts.push_back(part);
-            part.clear();
-        } else {
-            part += c;
-        }
-    }
-    parts.push_back(part);
-    return parts;
-}
-
-
-
-void SelectCommand::parseJoinDetails(const std::vector<std::vector<std::string>>& joinStrs, std::vector<Join>& joinData) {
-    for (const auto& joinStr : joinStrs) {
-        Join join;
-
-        std::string joinType;
-        if (joinStr.size() >= 2 && (joinStr[0] == "INNER" || joinStr[0] == "LEFT" || joinStr[0] == "RIGHT" || joinStr[0] == "FULL")) {
-            joinType = joinStr[0] + " " + joinStr[1];
-        } else {
-            joinType = "INNER JOIN";
-        }
-
-        std::vector<std::string> tokens;
-        for (const auto& str : joinStr) {
-            std::vector<std::string> splitTokens = split(str, ' ');
-            tokens.insert(tokens.end(), splitTokens.begin(), splitTokens.end());
-        }
-
-        auto joinIt = std::find(tokens.begin(), tokens.end(), "JOIN");
-        if (joinIt == tokens.end() || (joinIt + 1) == tokens.end()) {
-            std::cerr << "Error: Table name missing after JOIN keyword." << std::endl;
-            continue;
-        }
-        join.table = *(joinIt + 1);
-
-        auto onIt = std::find(tokens.begin(), tokens.end(), "ON");
-        if (onIt == tokens.end() || (onIt + 1) == tokens.end()) {
-            std::cerr << "Error: Missing or incomplete ON clause in JOIN specification." << std::endl;
-            continue;
-        }
-
-        std::string conditionStr;
-        for (auto it = onIt + 1; it != tokens.end(); ++it) {
-            conditionStr += *it + " ";
-        }
-
-        auto conditionParts = split(conditionStr, '=');
-        if (conditionParts.size() != 2) {
-            std::cerr << "Error: JOIN condition should contain exactly one '=' character." << std::endl;
-            continue;
-        }
-
-        auto leftParts = split(conditionParts[0], '.');
-        auto rightParts = split(conditionParts[1], '.');
-        if (leftParts.size() != 2 || rightParts.size() != 2) {
-            std::cerr << "Error: Invalid format in JOIN condition. Expected format 'table.column = table.column'." << std::endl;
-            continue;
-        }
-
-        JoinCondition joinCondition;
-        joinCondition.leftTable = leftParts[0];
-        joinCondition.leftColumn = leftParts[1];
-        joinCondition.rightTable = rightParts[0];
-        joinCondition.rightColumn = rightParts[1];
-
-        join.condition = joinCondition;
-        join.joinType = joinType;
-
-        joinData.push_back(join);
-    }
-}
-
 std::map<std::string, std::map<std::string, std::vector<std::string>>> SelectCommand::combineJoinsAndResultMap(
     const std::map<std::string, std::map<std::string, std::vector<std::string>>>& resultMap,
     const std::map<std::string, std::map<std::string, std::vector<std::string>>>& joinResultMap,
@@ -468,12 +281,6 @@ std::map<std::string, std::map<std::string, std::vector<std::string>>> SQLManage
     const std::string& databaseName,
     const std::vector<Join>& joinData
 ) {
-    json dbContent;
-    if (!readDatabaseFile(databaseName, dbContent)) {
-        std::cerr << "Error: Could not read database file." << std::endl;
-        return {};
-    }
-
     std::map<std::string, std::map<std::string, std::vector<std::string>>> resultTableColumns;
 
     std::set<std::string> requiredTables;
@@ -486,6 +293,12 @@ std::map<std::string, std::map<std::string, std::vector<std::string>>> SQLManage
         requiredColumns.insert(join.condition.rightColumn);
     }
 
+    json dbContent;
+    if (!readTables(databaseName, requiredTables, dbContent)) {
+        std::cerr << "Error: Could not read database file." << std::endl;
+        return {};
+    }
+
     for (const auto& table : dbContent["tables"]) {
         std::string tableName = table["table_name"];
 
@@ -505,6 +318,9 @@ std::map<std::string, std::map<std::string, std::vector<std::string>>> SQLManage
             columnMap[columnName] = {};
 
             for (const auto& row : table["rows"]) {
+                if (row.is_null()) {
+                    continue;
+                }
                 if (row.contains(columnName)) {
                     columnMap[columnName].push_back(row[columnName].dump());
                 } else {
@@ -0,0 +1,194 @@
+#include "headers/selectCommand.h"
+#include "storageManager/fileAccess.h"
+
+namespace {
+
+// Types of columns missing from the schema, such as joined columns renamed by the join, are
+// exported as strings.
+ColumnarFormat::ColumnType schemaColumnType(const json& schema, const std::string& tableName, const std::string& columnName) {
+    ColumnarFormat::ColumnType type = ColumnarFormat::ColumnType::STRING;
+    for (const auto& table : schema["tables"]) {
+        if (table["table_name"] != tableName) {
+            continue;
+        }
+        for (const auto& column : table["columns"]) {
+            if (column["name"] == columnName) {
+                ColumnarFormat::columnTypeFromString(column["type"], type);
+            }
+        }
+    }
+    return type;
+}
+
+}
+
+bool SelectCommand::outfileTarget(const SelectStatement& statement, std::string& filePath, ExportFormat& format) {
+    const std::string& path = statement.outfile.text;
+    if (path.empty()) {
+        std::cerr << "Error: INTO OUTFILE expects a file name." << std::endl;
+        return false;
+    }
+    if (!FileAccess::resolve(path, filePath)) {
+        return false;
+    }
+    if (!statement.outfileFormat.empty()) {
+        if (!stringToExportFormat(statement.outfileFormat, format)) {
+            std::cerr << "Error: Unknown export format '" << statement.outfileFormat << "'. Use csv, jsonl or binary." << std::endl;
+            return false;
+        }
+        return true;
+    }
+    if (!exportFormatFromPath(path, format)) {
+        std::cerr << "Error: Cannot tell the format of '" << path << "' from its extension. Add FORMAT csv, jsonl or binary." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SelectCommand::tableColumns(const std::string& tableName, const std::vector<std::string>& columnNames, std::vector<ResultColumn>& columns) {
+    INIT_DB_MANAGER;
+    std::shared_ptr<const json> schema = dbManager.getSchema(currentDatabase);
+    if (!schema) {
+        std::cerr << "Error: Failed to read schema of database '" << currentDatabase << "'." << std::endl;
+        return false;
+    }
+    for (const auto& columnName : columnNames) {
+        columns.push_back({columnName, schemaColumnType(*schema, tableName, columnName)});
+    }
+    return true;
+}
+
+// Flattens a built result into one list of columns, each with the cells it takes them from.
+// With several tables each column is named table.column, once.
+bool SelectCommand::resultColumns(const ResultTableColumns& resultMap, std::vector<ResultColumn>& columns, std::vector<const std::vector<std::string>*>& values, size_t& rowCount) {
+    INIT_DB_MANAGER;
+    std::shared_ptr<const json> schema = dbManager.getSchema(currentDatabase);
+    if (!schema) {
+        std::cerr << "Error: Failed to read schema of database '" << currentDatabase << "'." << std::endl;
+        return false;
+    }
+    rowCount = 0;
+    for (const auto& [tableName, columnMap] : resultMap) {
+        for (const auto& [columnName, cells] : columnMap) {
+            std::string name = resultMap.size() > 1 && columnName.find('.') == std::string::npos ? tableName + "." + columnName : columnName;
+            auto seen = std::find_if(columns.begin(), columns.end(), [&name](const ResultColumn& column) {
+                return column.name == name;
+            });
+            if (seen != columns.end()) {
+                continue;
+            }
+            // Joined columns are already named table.column.
+            size_t dot = columnName.find('.');
+            ColumnarFormat::ColumnType type = dot == std::string::npos
+                ? schemaColumnType(*schema, tableName, columnName)
+                : schemaColumnType(*schema, columnName.substr(0, dot), columnName.substr(dot + 1));
+            columns.push_back({name, type});
+            values.push_back(&cells);
+            rowCount = std::max(rowCount, cells.size());
+        }
+    }
+    return true;
+}
+
+json SelectCommand::resultRow(const std::vector<ResultColumn>& columns, const std::vector<const std::vector<std::string>*>& values, size_t row) {
+    json record = json::object();
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (row >= values[i]->size() || (*values[i])[row] == "NULL") {
+            continue;
+        }
+        // Cells hold dumped JSON.
+        const std::string& cell = (*values[i])[row];
+        json value = json::parse(cell, nullptr, false);
+        record[columns[i].name] = value.is_discarded() ? json(cell) : std::move(value);
+    }
+    return record;
+}
+
+// Without joins or ORDER BY the rows go from the table scan straight to the file, so memory
+// use stays flat however many rows are selected.
+bool SelectCommand::streamOutfile(const SelectStatement& statement, const std::string& filePath, ExportFormat format, const std::vector<std::string>& columnNames) {
+    INIT_SQL_MANAGER;
+    std::vector<ResultColumn> columns;
+    if (!tableColumns(statement.table, columnNames, columns)) {
+        return false;
+    }
+
+    RowExporter exporter(filePath, format, std::move(columns));
+    if (!exporter.isOpen()) {
+        std::cerr << "Error: Failed to create file '" << statement.outfile.text << "'." << std::endl;
+        return false;
+    }
+    bool written = true;
+    bool scanned = sqlManager.scanTableRows(currentDatabase, statement.table, statement.where.get(), statement.limit, [&exporter, &written](const json& row) {
+        written = exporter.writeRow(row);
+        return written;
+    });
+    if (!scanned || !written || !exporter.close()) {
+        std::cerr << "Error: Failed to write file '" << statement.outfile.text << "'." << std::endl;
+        return false;
+    }
+    std::cout << "Exported " << exporter.rowCount() << " rows to '" << statement.outfile.text << "'." << std::endl;
+    return true;
+}
+
+// Joined or ordered results are built in memory as they are for printing, then written row
+// by row.
+bool SelectCommand::writeOutfile(const SelectStatement& statement, const std::string& filePath, ExportFormat format, const ResultTableColumns& resultMap) {
+    std::vector<ResultColumn> columns;
+    std::vector<const std::vector<std::string>*> values;
+    size_t rowCount = 0;
+    if (!resultColumns(resultMap, columns, values, rowCount)) {
+        return false;
+    }
+
+    RowExporter exporter(filePath, format, columns);
+    if (!exporter.isOpen()) {
+        std::cerr << "Error: Failed to create file '" << statement.outfile.text << "'." << std::endl;
+        return false;
+    }
+    for (size_t row = 0; row < rowCount; ++row) {
+        if (!exporter.writeRow(resultRow(columns, values, row))) {
+            return false;
+        }
+    }
+    if (!exporter.close()) {
+        std::cerr << "Error: Failed to write file '" << statement.outfile.text << "'." << std::endl;
+        return false;
+    }
+    std::cout << "Exported " << exporter.rowCount() << " rows to '" << statement.outfile.text << "'." << std::endl;
+    return true;
+}
+
+// The sink counterparts of streamOutfile and writeOutfile.
+bool SelectCommand::streamToSink(const SelectStatement& statement, const std::vector<std::string>& columnNames, ResultSink& sink) {
+    INIT_SQL_MANAGER;
+    std::vector<ResultColumn> columns;
+    if (!tableColumns(statement.table, columnNames, columns)) {
+        return false;
+    }
+    sink.begin(columns);
+    bool added = true;
+    bool scanned = sqlManager.scanTableRows(currentDatabase, statement.table, statement.where.get(), statement.limit, [&sink, &added](const json& row) {
+        added = sink.addRow(row);
+        return added;
+    });
+    sink.finish();
+    return scanned && added;
+}
+
+bool SelectCommand::writeToSink(const ResultTableColumns& resultMap, ResultSink& sink) {
+    std::vector<ResultColumn> columns;
+    std::vector<const std::vector<std::string>*> values;
+    size_t rowCount = 0;
+    if (!resultColumns(resultMap, columns, values, rowCount)) {
+        return false;
+    }
+    sink.begin(columns);
+    for (size_t row = 0; row < rowCount; ++row) {
+        if (!sink.addRow(resultRow(columns, values, row))) {
+            break;
+        }
+    }
+    sink.finish();
+    return true;
+}
@@ -1,6 +1,6 @@
 #include "headers/selectCommand.h"
+#include "headers/tablePrinter.h"
 #include <fmt/core.h>
-#include <iomanip>
 #include <cstdlib>
 
 std::string SelectCommand::randomColor() {
@@ -44,232 +44,273 @@ void SelectCommand::printTable(const std::map<std::string, std::map<std::string,
         }
     }
 
-    for (const auto& tablePair : combinedMap) {
-        const std::string& tableName = tablePair.first;
-        const auto& columnsMap = tablePair.second;
-
+    for (const auto& [tableName, columnsMap] : combinedMap) {
         if (columnsMap.empty()) continue;
 
         std::string tableColor = randomColor();
-        std::cout << "Table: " << tableColor << tableName << RESET << std::endl;
-
-        std::map<std::string, size_t> columnWidths;
-        for (const auto& columnPair : columnsMap) {
-            const auto& columnName = columnPair.first;
-            columnWidths[columnName] = columnName.size();
-            for (const auto& value : columnPair.second) {
-                columnWidths[columnName] = std::max(columnWidths[columnName], value.size());
-            }
-        }
-
-        std::cout << "+";
-        for (const auto& column : columnsMap) {
-            std::cout << std::string(columnWidths[column.first] + 2, '-') << "+";
-        }
-        std::cout << std::endl;
-
-        std::cout << "|";
+        std::vector<std::string> columns;
+        std::vector<std::string> columnColors;
         for (const auto& column : columnsMap) {
-            std::string columnColor = randomColor();
-            std::cout << columnColor << std::setw(columnWidths[column.first] + 1) << std::left << column.first << RESET << " |";
+            columns.push_back(column.first);
+            columnColors.push_back(randomColor());
         }
-        std::cout << std::endl;
-
-        std::cout << "+";
-        for (const auto& column : columnsMap) {
-            std::cout << std::string(columnWidths[column.first] + 2, '-') << "+";
-        }
-        std::cout << std::endl;
-
+        TablePrinter printer(tableName, tableColor, std::move(columns), std::move(columnColors));
         for (size_t row = 0; row < maxRows; ++row) {
-            std::cout << "|";
+            std::vector<std::string> cells;
+            cells.reserve(columnsMap.size());
             for (const auto& column : columnsMap) {
-                if (row < column.second.size()) {
-                    std::cout << std::setw(columnWidths[column.first] + 1) << std::left << column.second[row] << " |";
-                } else {
-                    std::cout << std::setw(columnWidths[column.first] + 1) << std::left << "NULL" << " |";
-                }
+                cells.push_back(row < column.second.size() ? column.second[row] : "NULL");
             }
-            std::cout << std::endl;
-        }
-
-        std::cout << "+";
-        for (const auto& column : columnsMap) {
-            std::cout << std::string(columnWidths[column.first] + 2, '-') << "+";
+            printer.addRow(std::move(cells));
         }
-        std::cout << std::endl;
+        printer.finish();
     }
 }
 
-
-SelectCommand::SelectCommand(std::string& currentUser, std::string& currentDatabase)
-    : currentUser(currentUser), currentDatabase(currentDatabase) {}
-
-std::vector<std::string>::iterator SelectCommand::FindInArgs(std::vector<std::string>& args, const std::string& stringToFind) {
-    auto it = std::find(args.begin(), args.end(), stringToFind);
-    return it;
-}
-
-std::vector<std::string>::iterator SelectCommand::FindOrderByInArgs(std::vector<std::string>& args) {
-    auto it = FindInArgs(args, "ORDER");
-    if (it != args.end() && std::distance(it, args.end()) > 1 && *(it + 1) == "BY") {
-        return it;
+// Without joins or ORDER BY nothing needs the whole result, so rows are printed page by page
+// as the table scan produces them. Columns are in name order, as printTable shows them.
+// False when the table could not be read.
+bool SelectCommand::streamTable(const SelectStatement& statement, std::vector<std::string> columns) {
+    INIT_SQL_MANAGER;
+    std::sort(columns.begin(), columns.end());
+    std::string tableColor = randomColor();
+    std::vector<std::string> columnColors;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        columnColors.push_back(randomColor());
     }
-    return args.end();
+    TablePrinter printer(statement.table, tableColor, columns, std::move(columnColors));
+    bool scanned = sqlManager.scanTableRows(currentDatabase, statement.table, statement.where.get(), statement.limit, [&printer, &columns](const json& row) {
+        std::vector<std::string> cells;
+        cells.reserve(columns.size());
+        for (const auto& column : columns) {
+            auto it = row.find(column);
+            cells.push_back(it != row.end() ? it->dump() : "NULL");
+        }
+        printer.addRow(std::move(cells));
+        return true;
+    });
+    if (scanned) {
+        printer.finish();
+    }
+    return scanned;
 }
 
 
+SelectCommand::SelectCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions)
+    : StatementCommand(Statement::Kind::SELECT), currentUser(currentUser), currentDatabase(currentDatabase), sessionPermissions(sessionPermissions) {}
+
 bool SelectCommand::checkPermissions() {
     INIT_DB_MANAGER;
-    if (!dbManager.isOwner(currentDatabase, currentUser) &&
-        !dbManager.checkUserPermission(currentDatabase, currentUser, Permission::READ)) {
+    if (!dbManager.sessionHasPermission(sessionPermissions, currentDatabase, currentUser, Permission::READ)) {
         DISPLAY_MESSAGE("Current user is neither the owner nor has read permission for database '" + currentDatabase + "'.");
         return false;
     }
     return true;
 }
-std::string SelectCommand::trim(const std::string& str) {
-    auto start = str.find_first_not_of(' ');
-    auto end = str.find_last_not_of(' ');
-    return (start == std::string::npos || end == std::string::npos) ? "" : str.substr(start, end - start + 1);
-}
-void SelectCommand::removeWhiteSpaces(std::vector<Join>& joinData) {
-    for (auto& join : joinData) {
-        join.table = trim(join.table);
-        join.joinType = trim(join.joinType);
-        join.condition.leftTable = trim(join.condition.leftTable);
-        join.condition.leftColumn = trim(join.condition.leftColumn);
-        join.condition.rightTable = trim(join.condition.rightTable);
-        join.condition.rightColumn = trim(join.condition.rightColumn);
+// Columns per table for the projection: unqualified columns belong to the FROM table and
+// '*' expands to every column of its table in the schema.
+bool SelectCommand::buildTableColumnMap(const SelectStatement& statement, std::map<std::string, std::vector<std::string>>& tableColumnMap) {
+    INIT_DB_MANAGER;
+    std::shared_ptr<const json> schema;
+    for (const auto& column : statement.columns) {
+        std::string tableName = column.table.empty() ? statement.table : column.table;
+        auto& columns = tableColumnMap[tableName];
+        if (column.column != "*") {
+            if (std::find(columns.begin(), columns.end(), column.column) == columns.end()) {
+                columns.push_back(column.column);
+            }
+            continue;
+        }
+
+        if (!schema && !(schema = dbManager.getSchema(currentDatabase))) {
+            std::cerr << "Error: Failed to read schema of database '" << currentDatabase << "'." << std::endl;
+            return false;
+        }
+        auto tableIt = std::find_if((*schema)["tables"].begin(), (*schema)["tables"].end(), [&tableName](const json& table) {
+            return table["table_name"] == tableName;
+        });
+        if (tableIt == (*schema)["tables"].end()) {
+            std::cerr << "Error: Table '" << tableName << "' does not exist in database '" << currentDatabase << "'." << std::endl;
+            return false;
+        }
+        for (const auto& schemaColumn : (*tableIt)["columns"]) {
+            std::string columnName = schemaColumn["name"];
+            if (std::find(columns.begin(), columns.end(), columnName) == columns.end()) {
+                columns.push_back(columnName);
+            }
+        }
     }
+    return true;
 }
 
-void SelectCommand::execute(const std::vector<std::string>& args) {
-    INIT_SQL_MANAGER;
-    std::vector<Join> joinData;
-    bool joinsExist = false;
-    LockFileType LockFileTypeToUse = LockFileType::DATABASE;
-    std::vector<std::string> modifiedArgs = args;
+namespace {
 
-    if (!checkPermissions()) {
-        return;
+// Cells hold dumped JSON, so numbers compare numerically and everything else as text;
+// NULL sorts first.
+bool cellLess(const std::string& a, const std::string& b) {
+    if (a == "NULL" || b == "NULL") {
+        return a == "NULL" && b != "NULL";
     }
-
-    if (args.size() < 3) {
-        std::cerr << "Error: Invalid arguments for SELECT command." << std::endl;
-        return;
+    double x = 0, y = 0;
+    auto [endA, errorA] = std::from_chars(a.data(), a.data() + a.size(), x);
+    auto [endB, errorB] = std::from_chars(b.data(), b.data() + b.size(), y);
+    if (errorA == std::errc() && errorB == std::errc() && endA == a.data() + a.size() && endB == b.data() + b.size()) {
+        return x < y;
     }
+    return a < b;
+}
 
+}
 
-    if (detectJoinsFromArgs(modifiedArgs)) {
-        std::vector<std::vector<std::string>> joinStrs = extractJoinsFromArgs(modifiedArgs);
-        parseJoinDetails(joinStrs, joinData);
-        removeWhiteSpaces(joinData);
-        joinsExist = true;
+// Rows of a result are matched across its tables by position, so one order is computed from
+// the ORDER BY columns, wherever they live, and applied to the columns of every table.
+void SelectCommand::applyOrderAndLimit(const SelectStatement& statement, std::map<std::string, std::map<std::string, std::vector<std::string>>>& resultMap) {
+    size_t rowCount = 0;
+    for (const auto& [tableName, columns] : resultMap) {
+        for (const auto& [columnName, values] : columns) {
+            rowCount = std::max(rowCount, values.size());
+        }
     }
 
-
-    //std::string whereClause = parseArgsWhere(modifiedArgs);
-    //std::string orderByClause = parseArgsOrderBy(modifiedArgs);
-    //int limit = parseArgsLimit(modifiedArgs);
-
-    std::map<std::string, std::vector<std::string>> tableColumnMap = parseArgsTablesColumns(modifiedArgs);
-    removeUnusedTables(tableColumnMap);
-
-    if (IS_LOCKED(currentDatabase, LockFileTypeToUse)){
-        DISPLAY_MESSAGE(currentDatabase + " is currently locked... try again later");
-        return;
+    std::vector<const std::vector<std::string>*> keys;
+    std::vector<bool> descending;
+    for (const auto& item : statement.orderBy) {
+        std::string table = item.column.table.empty() ? statement.table : item.column.table;
+        std::string qualified = table + "." + item.column.column;
+        const std::vector<std::string>* key = nullptr;
+        auto tableIt = resultMap.find(table);
+        if (tableIt != resultMap.end()) {
+            auto it = tableIt->second.find(item.column.column);
+            if (it == tableIt->second.end()) {
+                it = tableIt->second.find(qualified);
+            }
+            if (it != tableIt->second.end()) {
+                key = &it->second;
+            }
+        }
+        // Joined columns are stored as table.column under the table they were joined to.
+        for (auto it = resultMap.begin(); !key && it != resultMap.end(); ++it) {
+            auto column = it->second.find(qualified);
+            if (column != it->second.end()) {
+                key = &column->second;
+            }
+        }
+        for (auto it = resultMap.begin(); !key && item.column.table.empty() && it != resultMap.end(); ++it) {
+            auto column = it->second.find(item.column.column);
+            if (column != it->second.end()) {
+                key = &column->second;
+            }
+        }
+        if (key) {
+            keys.push_back(key);
+            descending.push_back(item.descending);
+        }
     }
-    LOCK(currentDatabase, LockFileTypeToUse, currentUser, "SELECT");
 
-    std::map<std::string, std::map<std::string, std::vector<std::string>>> resultMap = sqlManager.getTableAndColumnFromDatabase(currentDatabase, tableColumnMap);
-    if (joinsExist) {
-        std::map<std::string, std::map<std::string, std::vector<std::string>>> joinResultMap = sqlManager.getTableAndColumnFromDatabaseForJoins(currentDatabase, joinData);
-        resultMap = combineJoinsAndResultMap(resultMap, joinResultMap, joinData);
+    std::vector<size_t> order(rowCount);
+    for (size_t i = 0; i < rowCount; ++i) {
+        order[i] = i;
+    }
+    if (!keys.empty()) {
+        static const std::string missing = "NULL";
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            for (size_t k = 0; k < keys.size(); ++k) {
+                const std::string& left = a < keys[k]->size() ? (*keys[k])[a] : missing;
+                const std::string& right = b < keys[k]->size() ? (*keys[k])[b] : missing;
+                if (left == right) {
+                    continue;
+                }
+                return descending[k] ? cellLess(right, left) : cellLess(left, right);
+            }
+            return false;
+        });
+    }
+    if (statement.limit >= 0 && order.size() > static_cast<size_t>(statement.limit)) {
+        order.resize(static_cast<size_t>(statement.limit));
+    }
+    if (keys.empty() && order.size() == rowCount) {
+        return;
     }
-    printTable(resultMap);
-
-    UNLOCK(currentDatabase, LockFileTypeToUse);
-}
 
-int SelectCommand::parseArgsLimit(std::vector<std::string>& args) {
-    auto it = std::find(args.begin(), args.end(), "LIMIT");
-    if (it != args.end() && it + 1 != args.end()) {
-        try {
-            int limit = std::stoi(*(it + 1));
-            if (limit == 0) {
-                return -1;
+    for (auto& [tableName, columns] : resultMap) {
+        for (auto& [columnName, values] : columns) {
+            std::vector<std::string> reordered;
+            reordered.reserve(order.size());
+            for (size_t row : order) {
+                reordered.push_back(row < values.size() ? std::move(values[row]) : "NULL");
             }
-            args.erase(it, it + 2);
-            return limit;
-        } catch (const std::invalid_argument& e) {
-            return -1;
+            values = std::move(reordered);
         }
     }
-    return -1;
 }
 
+bool SelectCommand::run(const Statement& parsed) {
+    INIT_DB_MANAGER;
+    INIT_SQL_MANAGER;
+    std::vector<Join> joinData;
+    LockFileType LockFileTypeToUse = LockFileType::DATABASE;
 
+    if (!checkPermissions()) {
+        return false;
+    }
 
+    const SelectStatement& statement = parsed.select;
 
-void removeFromArgs(std::vector<std::string>& args, std::vector<std::string>::iterator start, std::vector<std::string>::iterator end) {
-    args.erase(start, end);
-}
+    for (const auto& joinClause : statement.joins) {
+        JoinCondition condition{joinClause.left.table, joinClause.left.column, joinClause.right.table, joinClause.right.column};
+        joinData.emplace_back(joinClause.table, joinClause.joinType, condition);
+    }
 
-std::map<std::string, std::vector<std::string>> SelectCommand::parseArgsTablesColumns(const std::vector<std::string>& args) {
     std::map<std::string, std::vector<std::string>> tableColumnMap;
-    std::vector<std::string> tables;
-    std::vector<std::string> columnsBeforeFrom;
-    bool fromSeen = false;
-    std::string firstTableAfterFrom;
+    if (!buildTableColumnMap(statement, tableColumnMap)) {
+        return false;
+    }
+    removeUnusedTables(tableColumnMap);
+    ExportFormat format = ExportFormat::CSV;
+    std::string outfilePath;
+    if (statement.intoOutfile && !outfileTarget(statement, outfilePath, format)) {
+        return false;
+    }
 
-    for (const auto& arg : args) {
-        if (arg == "FROM") {
-            fromSeen = true;
-            continue;
+    // Snapshot files are always complete, so reading them needs no lock.
+    const bool snapshotRead = usesSnapshotWrites(dbManager.getStorageFormat(currentDatabase));
+    if (!snapshotRead) {
+        if (IS_LOCKED(currentDatabase, LockFileTypeToUse)){
+            DISPLAY_MESSAGE(currentDatabase + " is currently locked... try again later");
+            return false;
         }
+        LOCK(currentDatabase, LockFileTypeToUse, currentUser, "SELECT");
+    }
 
-        if (fromSeen) {
-            if (arg.find('.') != std::string::npos) {
-                continue;
-            } else {
-                if (tableColumnMap.find(arg) == tableColumnMap.end()) {
-                    tableColumnMap[arg] = {};
-                }
-                tables.push_back(arg);
-                if (firstTableAfterFrom.empty()) {
-                    firstTableAfterFrom = arg;
-                }
-            }
+    // A ResultSink set by the caller takes the rows in place of the printed table.
+    ResultSink* sink = ResultSink::current();
+    bool succeeded = true;
+    if (joinData.empty() && statement.orderBy.empty()) {
+        if (statement.intoOutfile) {
+            succeeded = streamOutfile(statement, outfilePath, format, tableColumnMap[statement.table]);
+        } else if (sink) {
+            succeeded = streamToSink(statement, tableColumnMap[statement.table], *sink);
         } else {
-            if (arg.find('.') != std::string::npos) {
-                std::string table = arg.substr(0, arg.find('.'));
-                std::string column = arg.substr(arg.find('.') + 1);
-
-                if (tableColumnMap.find(table) == tableColumnMap.end()) {
-                    tableColumnMap[table] = {};
-                }
-                auto& columns = tableColumnMap[table];
-                if (std::find(columns.begin(), columns.end(), column) == columns.end()) {
-                    columns.push_back(column);
-                }
-            } else {
-                columnsBeforeFrom.push_back(arg);
-            }
+            succeeded = streamTable(statement, tableColumnMap[statement.table]);
+        }
+    } else {
+        std::map<std::string, std::map<std::string, std::vector<std::string>>> resultMap = sqlManager.getTableAndColumnFromDatabase(currentDatabase, tableColumnMap, statement.table, statement.where.get());
+        if (!joinData.empty()) {
+            std::map<std::string, std::map<std::string, std::vector<std::string>>> joinResultMap = sqlManager.getTableAndColumnFromDatabaseForJoins(currentDatabase, joinData);
+            resultMap = combineJoinsAndResultMap(resultMap, joinResultMap, joinData);
+        }
+        applyOrderAndLimit(statement, resultMap);
+        if (statement.intoOutfile) {
+            succeeded = writeOutfile(statement, outfilePath, format, resultMap);
+        } else if (sink) {
+            succeeded = writeToSink(resultMap, *sink);
+        } else {
+            printTable(resultMap);
         }
     }
 
-    if (!columnsBeforeFrom.empty() && !firstTableAfterFrom.empty()) {
-        auto& columns = tableColumnMap[firstTableAfterFrom];
-        for (const auto& column : columnsBeforeFrom) {
-            if (std::find(columns.begin(), columns.end(), column) == columns.end()) {
-                columns.push_back(column);
-            }
-        }
-    } else if (!columnsBeforeFrom.empty() && firstTableAfterFrom.empty()) {
-        std::cerr << "Error: No table specified after FROM to assign columns specified before FROM." << std::endl;
+    if (!snapshotRead) {
+        UNLOCK(currentDatabase, LockFileTypeToUse);
     }
-    return tableColumnMap;
+    return succeeded;
 }
-
-
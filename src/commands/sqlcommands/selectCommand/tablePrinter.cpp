@@ -0,0 +1,89 @@
+#include "headers/tablePrinter.h"
+#include "headers/selectCommand.h"
+#include <iostream>
+
+TablePrinter::TablePrinter(const std::string& title, const std::string& titleColor, std::vector<std::string> columns, std::vector<std::string> columnColors)
+    : columns(std::move(columns)), columnColors(std::move(columnColors)) {
+    widths.reserve(this->columns.size());
+    for (const auto& column : this->columns) {
+        widths.push_back(column.size());
+    }
+    page.reserve(PAGE_ROWS);
+    out.reserve(BUFFER_SIZE);
+    out += "Table: " + titleColor + title + RESET + "\n";
+}
+
+void TablePrinter::addRow(std::vector<std::string> cells) {
+    page.push_back(std::move(cells));
+    if (page.size() == PAGE_ROWS) {
+        printPage();
+    }
+}
+
+void TablePrinter::finish() {
+    printPage();
+    printBorder();
+    flush();
+}
+
+void TablePrinter::printPage() {
+    bool widened = false;
+    for (const auto& row : page) {
+        for (size_t i = 0; i < widths.size(); ++i) {
+            if (row[i].size() > widths[i]) {
+                widths[i] = row[i].size();
+                widened = true;
+            }
+        }
+    }
+    if (!headerPrinted) {
+        printHeader();
+    } else if (widened) {
+        printBorder();
+    }
+
+    for (const auto& row : page) {
+        out += '|';
+        for (size_t i = 0; i < widths.size(); ++i) {
+            out += row[i];
+            out.append(widths[i] + 1 - row[i].size(), ' ');
+            out += " |";
+        }
+        out += '\n';
+        if (out.size() >= BUFFER_SIZE) {
+            flush();
+        }
+    }
+    page.clear();
+    flush();
+}
+
+void TablePrinter::printBorder() {
+    out += '+';
+    for (size_t width : widths) {
+        out.append(width + 2, '-');
+        out += '+';
+    }
+    out += '\n';
+}
+
+void TablePrinter::printHeader() {
+    printBorder();
+    out += '|';
+    for (size_t i = 0; i < columns.size(); ++i) {
+        out += columnColors[i];
+        out += columns[i];
+        out.append(widths[i] + 1 - columns[i].size(), ' ');
+        out += RESET;
+        out += " |";
+    }
+    out += '\n';
+    printBorder();
+    headerPrinted = true;
+}
+
+void TablePrinter::flush() {
+    std::cout.write(out.data(), static_cast<std::streamsize>(out.size()));
+    std::cout.flush();
+    out.clear();
+}
@@ -10,11 +10,12 @@
 #include "checks.h"
 class ShowTablesCommand : public Command {
 public:
-    ShowTablesCommand(std::string& currentUser, std::string& currentDatabase);
-    virtual void execute(const std::vector<std::string>& args) override;
+    ShowTablesCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
+    virtual bool execute(const std::vector<std::string>& args) override;
 private:
     std::string& currentUser;
     std::string& currentDatabase;
+    SessionPermissions& sessionPermissions;
 };
 
 #endif
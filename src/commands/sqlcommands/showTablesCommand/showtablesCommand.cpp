@@ -1,36 +1,28 @@
 #include "headers/showTablesCommand.h"
 
-ShowTablesCommand::ShowTablesCommand(std::string& currentUser, std::string& currentDatabase)
-    : currentUser(currentUser), currentDatabase(currentDatabase){}
+ShowTablesCommand::ShowTablesCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions)
+    : currentUser(currentUser), currentDatabase(currentDatabase), sessionPermissions(sessionPermissions){}
 
-void ShowTablesCommand::execute(const std::vector<std::string>& args) {
+bool ShowTablesCommand::execute(const std::vector<std::string>& args) {
     INIT_DB_MANAGER;
-    INIT_SQL_MANAGER;
-    LockFileType LockFileTypeToUse = LockFileType::DATABASE;
     checkUserLoggedIn(currentUser);
     checkDatabaseSelected(currentUser, currentDatabase);
 
-    bool isOwner = IS_OWNER(currentDatabase, currentUser);
-    bool hasReadPermissions = CHECK_USER_PERMISSION(currentDatabase, currentUser, Permission::READ);
+    bool hasReadPermissions = CHECK_SESSION_PERMISSION(sessionPermissions, currentDatabase, currentUser, Permission::READ);
 
-    if (!isOwner && !hasReadPermissions) {
+    if (!hasReadPermissions) {
         DISPLAY_MESSAGE("Current user is neither the owner nor has read permission for database '" + currentDatabase + "'.");
-        return;
+        return false;
     }
-    if (IS_LOCKED(currentDatabase, LockFileTypeToUse)){
-        DISPLAY_MESSAGE(currentDatabase + " is currently locked... try again later");
-        return;
-    }
-    LOCK(currentDatabase, LockFileTypeToUse, currentUser, "SHOW TABLES");
 
-    json dbContent;
-    if (!sqlManager.readDatabaseFile(currentDatabase, dbContent)) {
+    // Served lock-free from the cached schema; see DescribeCommand.
+    std::shared_ptr<const json> schema = dbManager.getSchema(currentDatabase);
+    if (!schema) {
         std::cerr << "Error: Database '" << currentDatabase << "' does not exist." << std::endl;
-        UNLOCK(currentDatabase, LockFileTypeToUse);
-        return;
+        return false;
     }
 
-    auto& tables = dbContent["tables"];
+    const auto& tables = (*schema)["tables"];
     if (tables.empty()) {
         std::cout << "No tables found in database '" << currentDatabase << "'." << std::endl;
     } else {
@@ -40,5 +32,5 @@ void ShowTablesCommand::execute(const std::vector<std::string>& args) {
             std::cout << "  " << tableName << std::endl;
         }
     }
-    UNLOCK(currentDatabase, LockFileTypeToUse);
+    return true;
 }
@@ -1,21 +1,22 @@
 #ifndef UPDATE_COMMAND_H
 #define UPDATE_COMMAND_H
 
-#include "commands/command.h"
+#include "commands/statementCommand.h"
+#include "databaseManager/databaseManager.h"
 #include <string>
 #include <vector>
 #include <map>
 
-class UpdateCommand : public Command {
+class UpdateCommand : public StatementCommand {
 public:
-    UpdateCommand(std::string& currentUser, std::string& currentDatabase);
-    virtual void execute(const std::vector<std::string>& args) override;
+    UpdateCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
+    virtual bool run(const Statement& statement) override;
 
 private:
     std::string& currentUser;
     std::string& currentDatabase;
+    SessionPermissions& sessionPermissions;
 
-    std::map<std::string, std::map<std::string, std::vector<std::string>>> parseArgsForUpdate(std::vector<std::string>& args);
     bool checkPermissions();
 };
 
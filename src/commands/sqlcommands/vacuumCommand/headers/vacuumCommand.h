@@ -0,0 +1,22 @@
+#ifndef VACUUM_COMMAND_H
+#define VACUUM_COMMAND_H
+
+#include "commands/command.h"
+#include <iostream>
+#include "sqlManager/sqlManager.h"
+#include "databaseManager/databaseManager.h"
+#include <vector>
+#include <string>
+#include "lockManager/lockManager.h"
+#include "checks.h"
+class VacuumCommand : public Command {
+public:
+    VacuumCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions);
+    virtual bool execute(const std::vector<std::string>& args) override;
+private:
+    std::string& currentUser;
+    std::string& currentDatabase;
+    SessionPermissions& sessionPermissions;
+};
+
+#endif
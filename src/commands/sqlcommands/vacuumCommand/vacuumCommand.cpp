@@ -0,0 +1,60 @@
+#include "headers/vacuumCommand.h"
+
+VacuumCommand::VacuumCommand(std::string& currentUser, std::string& currentDatabase, SessionPermissions& sessionPermissions)
+    : currentUser(currentUser), currentDatabase(currentDatabase), sessionPermissions(sessionPermissions){}
+
+// VACUUM [table] rewrites the tables of the current database without their deleted rows.
+bool VacuumCommand::execute(const std::vector<std::string>& args) {
+    INIT_DB_MANAGER;
+    INIT_COMPACTION_MANAGER;
+    LockFileType LockFileTypeToUse = LockFileType::DATABASE;
+    checkUserLoggedIn(currentUser);
+    checkDatabaseSelected(currentUser, currentDatabase);
+
+    bool hasWritePermissions = CHECK_SESSION_PERMISSION(sessionPermissions, currentDatabase, currentUser, Permission::WRITE);
+
+    if (!hasWritePermissions) {
+        DISPLAY_MESSAGE("Current user is neither the owner nor has write permission for database '" + currentDatabase + "'.");
+        return false;
+    }
+    if (args.size() > 1) {
+        std::cerr << "Error: Invalid arguments for VACUUM command." << std::endl;
+        return false;
+    }
+
+    std::shared_ptr<const json> schema = dbManager.getSchema(currentDatabase);
+    if (!schema) {
+        std::cerr << "Error: Failed to read schema of database '" << currentDatabase << "'." << std::endl;
+        return false;
+    }
+    std::vector<std::string> tableNames;
+    for (const auto& table : (*schema)["tables"]) {
+        std::string tableName = table["table_name"];
+        if (args.empty() || args[0] == tableName) {
+            tableNames.push_back(tableName);
+        }
+    }
+    if (tableNames.empty()) {
+        std::cerr << "Error: Table '" << args[0] << "' does not exist in database '" << currentDatabase << "'." << std::endl;
+        return false;
+    }
+
+    if (IS_LOCKED(currentDatabase, LockFileTypeToUse)){
+        DISPLAY_MESSAGE(currentDatabase + " is currently locked... try again later");
+        return false;
+    }
+    LOCK(currentDatabase, LockFileTypeToUse, currentUser, "VACUUM");
+    StorageFormat format = dbManager.getStorageFormat(currentDatabase);
+    bool allVacuumed = true;
+    for (const auto& tableName : tableNames) {
+        size_t removed = 0;
+        if (!compactionManager.compactTable(currentDatabase, tableName, format, removed)) {
+            std::cerr << "Error: Failed to vacuum table '" << tableName << "'." << std::endl;
+            allVacuumed = false;
+            continue;
+        }
+        std::cout << "Table '" << tableName << "': removed " << removed << " deleted rows." << std::endl;
+    }
+    UNLOCK(currentDatabase, LockFileTypeToUse);
+    return allVacuumed;
+}
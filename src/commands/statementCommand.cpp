@@ -0,0 +1,14 @@
+#include "commands/statementCommand.h"
+#include "parser/sqlParser.h"
+#include <iostream>
+
+bool StatementCommand::execute(const std::vector<std::string>& args) {
+    INIT_PLAN_CACHE
+    Statement statement;
+    std::string error;
+    if (!planCache.getStatement(kind, joinArguments(args), statement, error)) {
+        std::cerr << "Error: Invalid " << statementKeyword(kind) << " statement: " << error << "." << std::endl;
+        return false;
+    }
+    return run(statement);
+}
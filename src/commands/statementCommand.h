@@ -0,0 +1,22 @@
+#ifndef STATEMENT_COMMAND_H
+#define STATEMENT_COMMAND_H
+
+#include <vector>
+#include <string>
+#include "commands/command.h"
+#include "parser/planCache.h"
+
+// A command that runs one kind of SQL statement. execute() gets the statement through the
+// plan cache and passes it to run(); EXECUTE calls run() with a bound prepared statement.
+// Both return false when the statement failed.
+class StatementCommand : public Command {
+public:
+    explicit StatementCommand(Statement::Kind kind) : kind(kind) {}
+    bool execute(const std::vector<std::string>& args) override;
+    virtual bool run(const Statement& statement) = 0;
+
+private:
+    Statement::Kind kind;
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "databaseManager/databaseManager.h"
+#include <sys/stat.h>
 const std::string DatabaseManager::DATABASE_PATH = "data/databases.json";
 DatabaseManager::DatabaseManager() {}
 
@@ -7,6 +8,19 @@ DatabaseManager& DatabaseManager::getInstance() {
     return instance;
 }
 
+bool readFileStamp(const std::string& path, FileStamp& stamp) {
+    struct stat info;
+    std::error_code ec;
+    auto writeTime = std::filesystem::last_write_time(path, ec);
+    if (ec || ::stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    stamp.writeTime = writeTime;
+    stamp.size = static_cast<std::uintmax_t>(info.st_size);
+    stamp.inode = info.st_ino;
+    return true;
+}
+
 Permission DatabaseManager::stringToPermission(const std::string& permString) {
     if (permString == "READ") {
         return Permission::READ;
@@ -21,6 +35,16 @@ Permission DatabaseManager::stringToPermission(const std::string& permString) {
     }
 }
 
+std::unordered_set<Permission> DatabaseManager::permissionsFromMask(PermissionMask mask) {
+    std::unordered_set<Permission> permissions;
+    for (auto perm : {Permission::READ, Permission::WRITE, Permission::ADD_TO_TABLE, Permission::MANAGE_PERMISSIONS}) {
+        if (mask & permissionBit(perm)) {
+            permissions.insert(perm);
+        }
+    }
+    return permissions;
+}
+
 std::string DatabaseManager::permissionToString(Permission permission) const {
     switch (permission) {
         case Permission::READ:
@@ -38,25 +62,70 @@ std::string DatabaseManager::permissionToString(Permission permission) const {
 
 
 void DatabaseManager::loadDatabasesFromFile() {
-    std::ifstream inputFile(DATABASE_PATH);
-    if (!inputFile.is_open()) {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    catalogLoaded = false;
+    refreshCatalog();
+}
+
+void DatabaseManager::refreshCatalog() const {
+    auto nextCheck = std::chrono::steady_clock::now() + CATALOG_CHECK_INTERVAL;
+    nextCatalogCheck.store(nextCheck.time_since_epoch().count(), std::memory_order_relaxed);
+    FileStamp stamp;
+    if (!readFileStamp(DATABASE_PATH, stamp)) {
         std::cerr << "Error: Failed to open file 'data/databases.json' for reading." << std::endl;
         return;
     }
+    if (catalogLoaded && stamp == catalogStamp) {
+        return;
+    }
 
     json jsonData;
-    inputFile >> jsonData;
-    inputFile.close();
+    if (!readJsonFromFile(DATABASE_PATH, jsonData)) {
+        return;
+    }
+    rebuildCatalog(jsonData);
+    catalogStamp = stamp;
+}
 
+void DatabaseManager::rebuildCatalog(const json& jsonData) const {
     databases.clear();
+    catalogLoaded = true;
+    catalogVersion.fetch_add(1, std::memory_order_release);
+    if (!jsonData.contains("databases") || !jsonData["databases"].is_array()) {
+        return;
+    }
+
     for (const auto& dbJson : jsonData["databases"]) {
-        std::string dbName = dbJson["name"];
         Database db;
-        db.owner = dbJson["owner"];
-        databases[dbName] = db;
+        db.owner = dbJson.value("owner", "");
+        db.storage = stringToStorageFormat(dbJson.value("storage", "json"));
+        if (dbJson.contains("users") && dbJson["users"].is_array()) {
+            for (const auto& userJson : dbJson["users"]) {
+                auto& permissions = db.permissions[userJson["username"].get<std::string>()];
+                if (userJson.contains("permissions") && userJson["permissions"].is_array()) {
+                    for (const auto& perm : userJson["permissions"]) {
+                        permissions |= permissionBit(stringToPermission(perm));
+                    }
+                }
+            }
+        }
+        databases[dbJson["name"].get<std::string>()] = std::move(db);
+    }
+}
+
+bool DatabaseManager::commitCatalog(const json& jsonData) {
+    if (!writeJsonToFile(DATABASE_PATH, jsonData)) {
+        return false;
     }
+    rebuildCatalog(jsonData);
+    if (!readFileStamp(DATABASE_PATH, catalogStamp)) {
+        catalogLoaded = false;
+    }
+    return true;
 }
 void DatabaseManager::listDatabases() const {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    refreshCatalog();
     std::cout << "Databases:\n";
     std::cout << "\n";
     std::cout << std::left << std::setw(20) << "Database Name" << "Owner\n";
@@ -70,33 +139,10 @@ void DatabaseManager::listDatabases() const {
 }
 
 bool DatabaseManager::databaseExists(const std::string& dbName) const {
-    std::ifstream inputFile(DATABASE_PATH);
-    if (!inputFile.is_open()) {
-        std::cerr << "Error: Failed to open file 'data/databases.json'." << std::endl;
-        return false;
-    }
-
-    json jsonData;
-    try {
-        inputFile >> jsonData;
-    } catch (const std::exception& e) {
-        std::cerr << "Error: Failed to parse JSON from file 'data/databases.json': " << e.what() << std::endl;
-        inputFile.close();
-        return false;
-    }
-
-    inputFile.close();
-
-    if (!jsonData.contains("databases") || !jsonData["databases"].is_array()) {
-        std::cerr << "Error: JSON file 'data/databases.json' does not contain 'databases' array." << std::endl;
-        return false;
-    }
-
-    for (const auto& db : jsonData["databases"]) {
-        std::string currentDbName = db["name"];
-        if (currentDbName == dbName) {
-            return true;
-        }
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    refreshCatalog();
+    if (databases.find(dbName) != databases.end()) {
+        return true;
     }
 
     std::cerr << "Database '" << dbName << "' not found in loaded databases." << std::endl;
@@ -104,17 +150,22 @@ bool DatabaseManager::databaseExists(const std::string& dbName) const {
 }
 
 bool DatabaseManager::createDatabase(const std::string& name, const std::string& owner) {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    if (!isValidStorageName(name)) {
+        std::cerr << "Error: Invalid database name '" << name << "'." << std::endl;
+        return false;
+    }
+    refreshCatalog();
     if (databases.find(name) != databases.end()) {
         std::cerr << "Error: Database '" << name << "' already exists." << std::endl;
         return false;
     }
-    databases[name] = { owner };
     json jsonData;
     if (!readJsonFromFile(DATABASE_PATH, jsonData)) {
         return false;
     }
     appendDatabaseToJson(name, owner, jsonData);
-    if (!writeJsonToFile(DATABASE_PATH, jsonData)) {
+    if (!commitCatalog(jsonData)) {
         return false;
     }
 
@@ -156,28 +207,20 @@ void DatabaseManager::appendDatabaseToJson(const std::string& name, const std::s
 }
 
 bool DatabaseManager::writeJsonToFile(const std::string& filePath, const json& jsonData) {
-    std::ofstream outputFile(filePath);
-    if (!outputFile.is_open()) {
-        std::cerr << "Error: Failed to open file '" << filePath << "' for writing." << std::endl;
-        return false;
-    }
-
-    outputFile << std::setw(4) << jsonData << std::endl;
-    outputFile.close();
-    return true;
+    return JsonFileWriter::writeFile(filePath, jsonData);
 }
 bool DatabaseManager::deleteDatabase(const std::string& name) {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
     if (!databaseExists(name)) {
         std::cerr << "Error: Database '" << name << "' does not exist." << std::endl;
         return false;
     }
 
-    databases.erase(name);
     json jsonData;
     if (!readJsonFromFile(DATABASE_PATH, jsonData)) {
         return false;
     }
-    json updatedJson;
+    json updatedJson = jsonData;
     updatedJson["databases"] = json::array();
     for (const auto& dbJson : jsonData["databases"]) {
         if (dbJson["name"] != name) {
@@ -185,7 +228,7 @@ bool DatabaseManager::deleteDatabase(const std::string& name) {
         }
     }
 
-    if (!writeJsonToFile(DATABASE_PATH, updatedJson)) {
+    if (!commitCatalog(updatedJson)) {
         return false;
     }
 
@@ -193,19 +236,14 @@ bool DatabaseManager::deleteDatabase(const std::string& name) {
 }
 
 bool DatabaseManager::isOwner(const std::string& dbName, const std::string& username) const {
-    json jsonData;
-    if (!readJsonFromFile(DATABASE_PATH, jsonData)) {
-        std::cerr << "Failed to read JSON file." << std::endl;
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    refreshCatalog();
+    auto it = databases.find(dbName);
+    if (it == databases.end()) {
+        std::cerr << "Database '" << dbName << "' not found." << std::endl;
         return false;
     }
-    for (const auto& dbJson : jsonData["databases"]) {
-        if (dbJson["name"] == dbName) {
-            std::string owner = dbJson["owner"];
-            return owner == username;
-        }
-    }
-    std::cerr << "Database '" << dbName << "' not found." << std::endl;
-    return false;
+    return it->second.owner == username;
 }
 
 json::iterator DatabaseManager::findDatabase(json& databases, const std::string& dbName) const {
@@ -241,6 +279,7 @@ bool DatabaseManager::removePermissionFromUser(json& userJson, const std::string
     return true;
 }
 bool DatabaseManager::removeUserPermission(const std::string& dbName, const std::string& username, const std::string& permission) {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
     json jsonData;
 
     if (!readJsonFromFile(DATABASE_PATH, jsonData)) {
@@ -293,7 +332,7 @@ bool DatabaseManager::removeUserPermission(const std::string& dbName, const std:
         return false;
     }
 
-    if (!writeJsonToFile(DATABASE_PATH, jsonData)) {
+    if (!commitCatalog(jsonData)) {
         std::cerr << "Failed to update JSON file." << std::endl;
         return false;
     }
@@ -303,61 +342,74 @@ bool DatabaseManager::removeUserPermission(const std::string& dbName, const std:
 }
 
 bool DatabaseManager::checkUserPermission(const std::string& dbName, const std::string& username, Permission permission) const {
-    json jsonData;
-
-    if (!readJsonFromFile(DATABASE_PATH, jsonData)) {
-        std::cerr << "Failed to read JSON file." << std::endl;
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    refreshCatalog();
+    auto dbIt = databases.find(dbName);
+    if (dbIt == databases.end()) {
+        std::cerr << "Database '" << dbName << "' not found in JSON data." << std::endl;
         return false;
     }
 
-    for (const auto& db : jsonData["databases"]) {
-        if (db["name"] == dbName) {
-            std::string dbOwner = db["owner"];
-            if (dbOwner == username) {
-                return true;
-            }
-
-            for (const auto& user : db["users"]) {
-                if (user["username"] == username) {
-                    auto& permissionsArray = user["permissions"];
-                    for (const auto& perm : permissionsArray) {
-                        if (perm == permissionToString(permission)) {
-                            return true;
-                        }
-                    }
-                    break;
-                }
-            }
+    const Database& db = dbIt->second;
+    if (db.owner == username) {
+        return true;
+    }
 
-            std::cerr << "User '" << username << "' does not have permission '" << permissionToString(permission) << "' for database '" << dbName << "'." << std::endl;
-            return false;
-        }
+    auto userIt = db.permissions.find(username);
+    if (userIt != db.permissions.end() && (userIt->second & permissionBit(permission))) {
+        return true;
     }
 
-    std::cerr << "Database '" << dbName << "' not found in JSON data." << std::endl;
+    std::cerr << "User '" << username << "' does not have permission '" << permissionToString(permission) << "' for database '" << dbName << "'." << std::endl;
     return false;
 }
 
 
 bool DatabaseManager::canManagePermissions(const std::string& dbName, const std::string& username) const {
-    if (isOwner(dbName, username)) {
-        return true;
-    }
     return checkUserPermission(dbName, username, Permission::MANAGE_PERMISSIONS);
 }
 bool DatabaseManager::canUseDatabase(const std::string& dbName, const std::string& username) const {
-    if (isOwner(dbName, username)) {
-        return true;
+    return getEffectivePermissions(dbName, username) != 0;
+}
+
+PermissionMask DatabaseManager::getEffectivePermissions(const std::string& dbName, const std::string& username) const {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    refreshCatalog();
+    auto dbIt = databases.find(dbName);
+    if (dbIt == databases.end()) {
+        return 0;
     }
-    for (auto perm : {Permission::READ, Permission::WRITE, Permission::ADD_TO_TABLE, Permission::MANAGE_PERMISSIONS}) {
-        if (checkUserPermission(dbName, username, perm)) {
-            return true;
-        }
+    if (dbIt->second.owner == username) {
+        return ALL_PERMISSIONS;
     }
-    return false;
+    auto userIt = dbIt->second.permissions.find(username);
+    return (userIt != dbIt->second.permissions.end()) ? userIt->second : 0;
+}
+
+void DatabaseManager::resolveSessionPermissions(SessionPermissions& session, const std::string& dbName, const std::string& username) const {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    session.mask = getEffectivePermissions(dbName, username);
+    session.user = username;
+    session.database = dbName;
+    session.catalogVersion = catalogVersion;
+}
+
+// Runs for every statement, so a session whose mask is still current takes neither the
+// catalog lock nor a stat of the catalog file, except once per CATALOG_CHECK_INTERVAL.
+bool DatabaseManager::sessionHasPermission(SessionPermissions& session, const std::string& dbName, const std::string& username, Permission permission) const {
+    if (std::chrono::steady_clock::now().time_since_epoch().count() >= nextCatalogCheck.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+        refreshCatalog();
+    }
+    if (session.catalogVersion != catalogVersion.load(std::memory_order_acquire) || session.database != dbName || session.user != username) {
+        resolveSessionPermissions(session, dbName, username);
+    }
+    return (session.mask & permissionBit(permission)) != 0;
 }
 
 std::unordered_set<Permission> DatabaseManager::getUserPermissions(const std::string& dbName, const std::string& username) const {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    refreshCatalog();
     auto it = databases.find(dbName);
     if (it == databases.end()) {
         return {}; 
@@ -368,48 +420,28 @@ std::unordered_set<Permission> DatabaseManager::getUserPermissions(const std::st
         return {}; 
     }
     
-    return userIt->second;
+    return permissionsFromMask(userIt->second);
 }
 std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_set<Permission>>>
 DatabaseManager::getDatabasePermissions(const std::string& dbName) const {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
     std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_set<Permission>>> databasePermissions;
 
-    json jsonData;
-    if (!readJsonFromFile(DATABASE_PATH, jsonData)) {
-        std::cerr << "Failed to read JSON file." << std::endl;
+    refreshCatalog();
+    auto it = databases.find(dbName);
+    if (it == databases.end()) {
         return databasePermissions;
     }
 
-    for (const auto& dbJson : jsonData["databases"]) {
-        if (dbJson["name"] != dbName) {
-            continue;
-        }
-
-        if (!dbJson.contains("users") || !dbJson["users"].is_array()) {
-            break;
-        }
-
-        for (const auto& userJson : dbJson["users"]) {
-            std::string username = userJson["username"];
-            std::unordered_set<Permission> permissions;
-
-            if (userJson.contains("permissions") && userJson["permissions"].is_array()) {
-                for (const auto& perm : userJson["permissions"]) {
-                    Permission permission = stringToPermission(perm);
-                    permissions.insert(permission);
-                }
-            }
-
-            databasePermissions[dbName][username] = permissions;
-        }
-
-        break;
+    for (const auto& [username, mask] : it->second.permissions) {
+        databasePermissions[dbName][username] = permissionsFromMask(mask);
     }
 
     return databasePermissions;
 }
 
 bool DatabaseManager::addPermission(const std::string& dbName, const std::string& username, Permission permission) {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
     json jsonData;
 
     if (!readJsonFromFile(DATABASE_PATH, jsonData)) {
@@ -428,7 +460,7 @@ bool DatabaseManager::addPermission(const std::string& dbName, const std::string
         return false;
     }
 
-    if (!writeJsonToFile(DATABASE_PATH, jsonData)) {
+    if (!commitCatalog(jsonData)) {
         std::cerr << "Failed to update JSON file." << std::endl;
         return false;
     }
@@ -436,6 +468,94 @@ bool DatabaseManager::addPermission(const std::string& dbName, const std::string
     return true;
 }
 
+StorageFormat DatabaseManager::getStorageFormat(const std::string& dbName) const {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    refreshCatalog();
+    auto it = databases.find(dbName);
+    return (it != databases.end()) ? it->second.storage : StorageFormat::JSON;
+}
+
+bool DatabaseManager::setStorageFormat(const std::string& dbName, StorageFormat format) {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    json jsonData;
+    if (!readJsonFromFile(DATABASE_PATH, jsonData)) {
+        return false;
+    }
+
+    auto dbIt = findDatabase(jsonData["databases"], dbName);
+    if (dbIt == jsonData["databases"].end()) {
+        databaseNotFound(dbName);
+        return false;
+    }
+
+    (*dbIt)["storage"] = storageFormatToString(format);
+    return commitCatalog(jsonData);
+}
+
+// Selects pretty or compact output for every JSON file written from now on. The choice is
+// stored in the catalog so it survives restarts; existing files are read either way.
+bool DatabaseManager::setJsonStyle(JsonStyle style) {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    json jsonData;
+    if (!readJsonFromFile(DATABASE_PATH, jsonData)) {
+        return false;
+    }
+    jsonData["json_style"] = jsonStyleToString(style);
+    // Set first, so the catalog itself is written in the new style.
+    JsonStyle previous = JsonFileWriter::defaultStyle();
+    JsonFileWriter::setDefaultStyle(style);
+    if (!commitCatalog(jsonData)) {
+        JsonFileWriter::setDefaultStyle(previous);
+        return false;
+    }
+    return true;
+}
+
+// Makes the style stored in the catalog the writer's default. Called once at startup;
+// setJsonStyle applies later changes where it makes them.
+void DatabaseManager::loadJsonStyle() {
+    std::lock_guard<std::recursive_mutex> guard(catalogMutex);
+    json jsonData;
+    if (readJsonFromFile(DATABASE_PATH, jsonData)) {
+        JsonFileWriter::setDefaultStyle(stringToJsonStyle(jsonData.value("json_style", "pretty")));
+    }
+}
+
+// Answers schema lookups from memory; the file is parsed again only after its stamp changes.
+std::shared_ptr<const json> DatabaseManager::getSchema(const std::string& dbName) const {
+    std::string path = schemaFilePath(dbName);
+    FileStamp stamp;
+    std::lock_guard<std::mutex> guard(schemaMutex);
+    if (!readFileStamp(path, stamp)) {
+        schemas.erase(dbName);
+        return nullptr;
+    }
+
+    auto it = schemas.find(dbName);
+    if (it != schemas.end() && it->second.stamp == stamp) {
+        return it->second.schema;
+    }
+
+    json schema;
+    if (!readJsonFromFile(path, schema)) {
+        return nullptr;
+    }
+    auto cached = std::make_shared<const json>(std::move(schema));
+    schemas[dbName] = {stamp, cached};
+    return cached;
+}
+
+// Called after schema.json was rewritten, so the writer's next lookup skips the parse.
+void DatabaseManager::cacheSchema(const std::string& dbName, const json& schema) {
+    FileStamp stamp;
+    std::lock_guard<std::mutex> guard(schemaMutex);
+    if (!readFileStamp(schemaFilePath(dbName), stamp)) {
+        schemas.erase(dbName);
+        return;
+    }
+    schemas[dbName] = {stamp, std::make_shared<const json>(schema)};
+}
+
 bool DatabaseManager::addUserPermission(json& dbJson, const std::string& username, Permission permission) {
     if (!dbJson.contains("users")) {
         dbJson["users"] = json::array();
@@ -9,6 +9,15 @@
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <set>
+#include <filesystem>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sys/types.h>
+#include "storageManager/storageFormat.h"
+#include "storageManager/jsonFileWriter.h"
 using json = nlohmann::json;
 
 
@@ -19,16 +28,77 @@ enum class Permission {
     MANAGE_PERMISSIONS
 };
 
+using PermissionMask = std::uint8_t;
+
+constexpr PermissionMask permissionBit(Permission permission) {
+    return static_cast<PermissionMask>(1u << static_cast<unsigned>(permission));
+}
+
+// Owners implicitly hold every permission on their database.
+constexpr PermissionMask ALL_PERMISSIONS =
+    permissionBit(Permission::READ) | permissionBit(Permission::WRITE) |
+    permissionBit(Permission::ADD_TO_TABLE) | permissionBit(Permission::MANAGE_PERMISSIONS);
+
 struct Database {
     std::string owner;
-    std::unordered_map<std::string, std::unordered_set<Permission>> permissions;
+    StorageFormat storage = StorageFormat::JSON;
+    std::unordered_map<std::string, PermissionMask> permissions;
+};
+
+// Effective permissions of the logged in user on the selected database, resolved by .use
+// and kept until the user, the database or the catalog version changes.
+struct SessionPermissions {
+    std::string user;
+    std::string database;
+    PermissionMask mask = 0;
+    std::uint64_t catalogVersion = 0;
+};
+
+// What a cached file is compared against: a rewrite within the same mtime tick, or a file
+// replaced by a rename, still changes the size or the inode.
+struct FileStamp {
+    std::filesystem::file_time_type writeTime;
+    std::uintmax_t size = 0;
+    ino_t inode = 0;
+
+    bool operator==(const FileStamp& other) const {
+        return writeTime == other.writeTime && size == other.size && inode == other.inode;
+    }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+};
+
+// Fills stamp from a stat of path; false when the file cannot be stat'ed.
+bool readFileStamp(const std::string& path, FileStamp& stamp);
+
+// Parsed schema.json of a database (table names and columns, no rows) and the stamp it was read at.
+struct SchemaCacheEntry {
+    FileStamp stamp;
+    std::shared_ptr<const json> schema;
 };
 
 class DatabaseManager {
 private:
     static const std::string DATABASE_PATH;
-    std::unordered_map<std::string, Database> databases;
+    // In-memory catalog of data/databases.json, reloaded only when the file changes on disk.
+    // Sessions, server workers, library callers and the compaction thread share it, so every
+    // public member takes catalogMutex; it is recursive because they call one another.
+    mutable std::recursive_mutex catalogMutex;
+    mutable std::unordered_map<std::string, Database> databases;
+    mutable FileStamp catalogStamp;
+    mutable bool catalogLoaded = false;
+    // Bumped on every rebuild. Sessions compare it without the lock, and the catalog file is
+    // stat'ed for them at most once per CATALOG_CHECK_INTERVAL (steady clock ticks in
+    // nextCatalogCheck), so changes made by another process are seen within that interval.
+    static constexpr std::chrono::milliseconds CATALOG_CHECK_INTERVAL{1000};
+    mutable std::atomic<std::uint64_t> catalogVersion{0};
+    mutable std::atomic<std::chrono::steady_clock::rep> nextCatalogCheck{0};
+    // Schemas are cached apart from row data and revalidated with a single stat of schema.json.
+    mutable std::mutex schemaMutex;
+    mutable std::unordered_map<std::string, SchemaCacheEntry> schemas;
     DatabaseManager();
+    void refreshCatalog() const;
+    void rebuildCatalog(const json& jsonData) const;
+    bool commitCatalog(const json& jsonData);
     void databaseNotFound(const std::string& dbName) const;
     bool addUserPermission(json& dbJson, const std::string& username, Permission permission);
     void appendDatabaseToJson(const std::string& name, const std::string& owner, json& jsonData);
@@ -36,6 +106,7 @@ private:
 public:
     std::string permissionToString(Permission permission) const;
     static Permission stringToPermission(const std::string& permString);
+    static std::unordered_set<Permission> permissionsFromMask(PermissionMask mask);
 
     bool readJsonFromFile(const std::string& filePath, json& jsonData) const;
     bool isOwner(const std::string& dbName, const std::string& username) const;
@@ -48,10 +119,19 @@ public:
     bool createDatabase(const std::string& name, const std::string& owner);
     bool removeUserPermission(const std::string& dbName, const std::string& username, const std::string& permission);
     bool checkUserPermission(const std::string& dbName, const std::string& username, Permission permission) const;
+    PermissionMask getEffectivePermissions(const std::string& dbName, const std::string& username) const;
+    void resolveSessionPermissions(SessionPermissions& session, const std::string& dbName, const std::string& username) const;
+    bool sessionHasPermission(SessionPermissions& session, const std::string& dbName, const std::string& username, Permission permission) const;
     std::unordered_set<Permission> getUserPermissions(const std::string& dbName, const std::string& username) const;
     std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_set<Permission>>> getDatabasePermissions(const std::string& dbName) const;
     bool databaseExists(const std::string& dbName) const;
     bool addPermission(const std::string& dbName, const std::string& username, Permission permission);
+    StorageFormat getStorageFormat(const std::string& dbName) const;
+    bool setStorageFormat(const std::string& dbName, StorageFormat format);
+    bool setJsonStyle(JsonStyle style);
+    void loadJsonStyle();
+    std::shared_ptr<const json> getSchema(const std::string& dbName) const;
+    void cacheSchema(const std::string& dbName, const json& schema);
 
     json::iterator findDatabase(json& databases, const std::string& dbName) const;
     json::iterator findUser(json& users, const std::string& username) const;
@@ -60,5 +140,6 @@ public:
 #define INIT_DB_MANAGER auto& dbManager = DatabaseManager::getInstance();
 #define IS_OWNER(dbName, username) dbManager.isOwner(dbName, username);
 #define CHECK_USER_PERMISSION(dbName, username, permission) dbManager.checkUserPermission(dbName, username, permission);
+#define CHECK_SESSION_PERMISSION(session, dbName, username, permission) dbManager.sessionHasPermission(session, dbName, username, permission);
 
 #endif
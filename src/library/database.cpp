@@ -0,0 +1,87 @@
+#include "library/database.h"
+#include "commands/outputCapture.h"
+#include "commands/executionLock.h"
+#include "parser/lexer.h"
+#include "logManager/logManager.h"
+#include <iostream>
+
+namespace cppjsondb {
+
+Database::Database() : factory(currentUser, currentDatabase) {}
+
+// Checks what .login and .use check, without going through the command text, so a user name
+// or password holding spaces or quotes reaches UserManager as it is.
+std::unique_ptr<Database> Database::open(const std::string& user, const std::string& password, const std::string& database, std::string& error) {
+    INIT_USER_MANAGER;
+    INIT_DB_MANAGER;
+    // The managers print as they check; error says what failed instead.
+    std::unique_ptr<Database> db(new Database());
+    std::string printed;
+    OutputCapture capture(printed);
+    ExecutionLock lock(".login", database);
+    if (!userManager.login(user, password)) {
+        LOG(LogLevel::ERROR, "", user, "Login failed: Invalid username or password.");
+        error = "Invalid username or password.";
+        return nullptr;
+    }
+    if (!dbManager.databaseExists(database)) {
+        LOG(LogLevel::ERROR, database, user, "Database does not exist.");
+        error = "Database '" + database + "' does not exist.";
+        return nullptr;
+    }
+    if (!dbManager.canUseDatabase(database, user)) {
+        LOG(LogLevel::ERROR, database, user, "User '" + user + "' does not have permission to use database '" + database + "'.");
+        error = "You do not have permission to use database '" + database + "'.";
+        return nullptr;
+    }
+
+    db->currentUser = user;
+    db->currentDatabase = database;
+    LOG(LogLevel::INFO, "", user, "Logged in.");
+    LOG(LogLevel::INFO, database, user, "Switched to database: " + database);
+    return db;
+}
+
+ResultSet Database::execute(const std::string& sql) {
+    ResultSet result;
+    bool succeeded = true;
+    {
+        ResultSet::Builder builder(result);
+        ResultSink::Scope scope(builder);
+        OutputCapture capture(result.text);
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::string_view statement : Lexer::splitTopLevel(sql, ';')) {
+            if (!statement.empty() && !runStatement(std::string(statement))) {
+                succeeded = false;
+            }
+        }
+    }
+    result.success = succeeded;
+    return result;
+}
+
+bool Database::runStatement(const std::string& statement) {
+    std::vector<std::string> tokens;
+    for (std::string_view token : Lexer::tokenize(statement)) {
+        tokens.emplace_back(token);
+    }
+    if (tokens.empty()) {
+        return true;
+    }
+    size_t consumed = 0;
+    std::string commandName;
+    std::shared_ptr<Command> command = factory.findCommand(tokens, consumed, commandName);
+    if (!command) {
+        std::cerr << "Error: Unknown command '" << tokens[0] << "'." << std::endl;
+        return false;
+    }
+    if (commandName == ".exit") {
+        std::cerr << "Error: .exit is not available to programs; destroy the Database instead." << std::endl;
+        return false;
+    }
+    std::vector<std::string> args(std::make_move_iterator(tokens.begin() + consumed), std::make_move_iterator(tokens.end()));
+    ExecutionLock lock(commandName, currentDatabase);
+    return command->execute(args);
+}
+
+}
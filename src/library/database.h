@@ -0,0 +1,51 @@
+#ifndef DATABASE_H
+#define DATABASE_H
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include "commandFactory/headers/commandFactory.h"
+#include "library/resultSet.h"
+#include "commands/outputCapture.h"
+
+namespace cppjsondb {
+
+// Access to the databases from a program, without the REPL, readline or parsing stdout.
+// Statements are the ones the REPL accepts and run through the same CommandFactory; what
+// they print and select comes back as a ResultSet. Like dbms, a Database works on the data
+// directory in the current working directory.
+//
+// A Database is one session with its own user, database, cached permissions and prepared
+// statements. Databases may be used from several threads. The statements of one Database
+// run one at a time; those of different Databases take the ExecutionLock, as server
+// sessions do. The API lives in namespace cppjsondb, apart from the catalog's Database entry.
+class Database {
+public:
+    // Logs user in and selects database. Returns nullptr and sets error when either fails.
+    static std::unique_ptr<Database> open(const std::string& user, const std::string& password, const std::string& database, std::string& error);
+
+    Database(const Database&) = delete;
+    Database& operator=(const Database&) = delete;
+
+    // Runs sql, one statement or several separated by ';'. .exit is refused, since it
+    // would end the calling process.
+    ResultSet execute(const std::string& sql);
+
+    const std::string& user() const { return currentUser; }
+    const std::string& database() const { return currentDatabase; }
+
+private:
+    Database();
+    bool runStatement(const std::string& statement);
+
+    // The program's std::cout and std::cerr are routed only while a Database exists.
+    OutputCapture::Routing routing;
+    std::string currentUser;
+    std::string currentDatabase;
+    CommandFactory factory;
+    std::mutex mutex;
+};
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include "library/resultSet.h"
+#include <iostream>
+
+namespace cppjsondb {
+
+bool ResultSet::Cursor::next() {
+    if (started && row < result.rows) {
+        ++row;
+    }
+    started = true;
+    return row < result.rows;
+}
+
+bool ResultSet::Cursor::isNull(size_t column) const {
+    return !started || row >= result.rows || column >= result.values.size() || !result.values[column].present[row];
+}
+
+bool ResultSet::Cursor::getInt(size_t column, long long& value) const {
+    if (isNull(column) || result.resultColumns[column].type != ColumnarFormat::ColumnType::INT) {
+        return false;
+    }
+    value = result.values[column].ints[row];
+    return true;
+}
+
+bool ResultSet::Cursor::getString(size_t column, std::string& value) const {
+    if (isNull(column) || result.resultColumns[column].type == ColumnarFormat::ColumnType::INT) {
+        return false;
+    }
+    value = result.values[column].strings[row];
+    return true;
+}
+
+bool ResultSet::columnIndex(const std::string& name, size_t& index) const {
+    for (size_t i = 0; i < resultColumns.size(); ++i) {
+        if (resultColumns[i].name == name) {
+            index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// A later SELECT of the same execute() replaces the rows of an earlier one.
+void ResultSet::Builder::begin(const std::vector<ResultColumn>& columns) {
+    result.selected = true;
+    result.resultColumns = columns;
+    result.values.assign(columns.size(), ColumnValues());
+    result.rows = 0;
+}
+
+bool ResultSet::Builder::addRow(const json& row) {
+    const std::vector<ResultColumn>& columns = result.resultColumns;
+    for (const auto& column : columns) {
+        auto it = row.find(column.name);
+        if (column.type == ColumnarFormat::ColumnType::INT && it != row.end() && !it->is_null() && !it->is_number_integer()) {
+            std::cerr << "Error: Value " << it->dump() << " of column '" << column.name << "' is not an int." << std::endl;
+            return false;
+        }
+    }
+    for (size_t i = 0; i < columns.size(); ++i) {
+        ColumnValues& column = result.values[i];
+        auto it = row.find(columns[i].name);
+        bool present = it != row.end() && !it->is_null();
+        column.present.push_back(present);
+        if (columns[i].type == ColumnarFormat::ColumnType::INT) {
+            column.ints.push_back(present ? it->get<long long>() : 0);
+        } else if (!present) {
+            column.strings.emplace_back();
+        } else {
+            column.strings.push_back(it->is_string() ? it->get<std::string>() : it->dump());
+        }
+    }
+    ++result.rows;
+    return true;
+}
+
+}
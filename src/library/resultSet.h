@@ -0,0 +1,77 @@
+#ifndef RESULT_SET_H
+#define RESULT_SET_H
+
+#include <string>
+#include <vector>
+#include "commands/resultSink.h"
+
+namespace cppjsondb {
+
+// What Database::execute returns: whether the statements succeeded, the text they printed
+// and the rows of the last SELECT among them, stored column by column with their types.
+class ResultSet {
+public:
+    // Walks the rows of a ResultSet, which must outlive it. Values are read by column index,
+    // in the order of columns(); the getters fail on NULL or on a column of another type.
+    class Cursor {
+    public:
+        explicit Cursor(const ResultSet& result) : result(result) {}
+
+        // Moves to the next row, starting before the first; false past the last one.
+        bool next();
+        bool isNull(size_t column) const;
+        bool getInt(size_t column, long long& value) const;
+        // For string and date columns.
+        bool getString(size_t column, std::string& value) const;
+
+    private:
+        const ResultSet& result;
+        size_t row = 0;
+        bool started = false;
+    };
+
+    // False when a statement reported an error; output() says which.
+    bool succeeded() const { return success; }
+    // Everything the statements printed except the rows of a SELECT.
+    const std::string& output() const { return text; }
+    // Whether a SELECT produced this result, even one without rows.
+    bool hasRows() const { return selected; }
+    const std::vector<ResultColumn>& columns() const { return resultColumns; }
+    size_t rowCount() const { return rows; }
+    bool columnIndex(const std::string& name, size_t& index) const;
+    Cursor cursor() const { return Cursor(*this); }
+
+private:
+    friend class Database;
+
+    // Fills a ResultSet with the rows a SELECT hands to its ResultSink.
+    class Builder : public ResultSink {
+    public:
+        explicit Builder(ResultSet& result) : result(result) {}
+
+        void begin(const std::vector<ResultColumn>& columns) override;
+        bool addRow(const json& row) override;
+        void finish() override {}
+
+    private:
+        ResultSet& result;
+    };
+
+    // INT columns keep their values in ints, the others in strings; one entry per row.
+    struct ColumnValues {
+        std::vector<bool> present;
+        std::vector<long long> ints;
+        std::vector<std::string> strings;
+    };
+
+    bool success = true;
+    bool selected = false;
+    std::string text;
+    std::vector<ResultColumn> resultColumns;
+    std::vector<ColumnValues> values;
+    size_t rows = 0;
+};
+
+}
+
+#endif
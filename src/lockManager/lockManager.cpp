@@ -1,4 +1,6 @@
 #include "lockManager/lockManager.h"
+#include <fcntl.h>
+#include <unistd.h>
 
 LockManager* LockManager::instance = nullptr;
 std::mutex LockManager::singletonMutex;
@@ -86,4 +88,21 @@ bool LockManager::isLocked(const std::string& resource, LockFileType type) {
         operation.clear();
     }
     return false;
-}
\ No newline at end of file
+}
+
+bool LockManager::tryLock(const std::string& resource, LockFileType type, const std::string& currentuser, const std::string& operation) {
+    std::lock_guard<std::mutex> guard(singletonMutex);
+
+    std::string filePath = getLockFilePath(resource, type);
+    int fd = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    std::string content = currentuser + "\n" + operation;
+    bool written = ::write(fd, content.data(), content.size()) == static_cast<ssize_t>(content.size());
+    ::close(fd);
+    if (!written) {
+        std::filesystem::remove(filePath);
+    }
+    return written;
+}
@@ -29,6 +29,8 @@ public:
     void lock(const std::string& resource, LockFileType type, const std::string& currentuser, const std::string& operation);
     void unlock(const std::string& resource, LockFileType type);
     bool isLocked(const std::string& resource, LockFileType type);
+    // Takes the lock only if nobody holds it; the check and the lock file creation are one step.
+    bool tryLock(const std::string& resource, LockFileType type, const std::string& currentuser, const std::string& operation);
 
 private:
     LockManager() = default;
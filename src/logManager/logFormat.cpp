@@ -0,0 +1,149 @@
+#include "logManager/logFormat.h"
+#include <iostream>
+#include <cstring>
+#include <type_traits>
+#include <zlib.h>
+
+bool stringToLogFormat(const std::string& formatString, LogFormat& format) {
+    if (formatString == "text") {
+        format = LogFormat::TEXT;
+    } else if (formatString == "binary") {
+        format = LogFormat::BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void LogFormatter::append(const LogRecord& record, std::string& out) {
+    if (record.time != stampTime) {
+        std::tm timeinfo{};
+        localtime_r(&record.time, &timeinfo);
+        char buffer[32];
+        size_t length = std::strftime(buffer, sizeof(buffer), "[%Y-%m-%d %H:%M:%S] ", &timeinfo);
+        stamp.assign(buffer, length);
+        stampTime = record.time;
+    }
+    out += stamp;
+
+    std::string_view text(record.text, record.userLength + record.databaseLength + record.messageLength);
+    std::string_view user = text.substr(0, record.userLength);
+    std::string_view database = text.substr(record.userLength, record.databaseLength);
+    std::string_view message = text.substr(record.userLength + record.databaseLength);
+    if (!user.empty()) {
+        out += '[';
+        out += user;
+        out += "] ";
+    }
+    if (!database.empty()) {
+        out += '[';
+        out += database;
+        out += "] ";
+    }
+
+    if (record.level == LogLevel::INFO) out += "[INFO] ";
+    else if (record.level == LogLevel::WARNING) out += "[WARNING] ";
+    else if (record.level == LogLevel::ERROR) out += "[ERROR] ";
+
+    out += message;
+    if (record.truncated) {
+        out += " [...]";
+    }
+    out += '\n';
+}
+
+namespace {
+
+// Byte by byte, so the file is little endian whatever the host is.
+template <typename T>
+void appendInteger(std::string& out, T value) {
+    auto bits = static_cast<std::make_unsigned_t<T>>(value);
+    for (size_t shift = 0; shift < sizeof(T) * 8; shift += 8) {
+        out.push_back(static_cast<char>((bits >> shift) & 0xFF));
+    }
+}
+
+template <typename T>
+T readInteger(const unsigned char* data) {
+    std::make_unsigned_t<T> bits = 0;
+    for (size_t i = sizeof(T); i-- > 0;) {
+        bits = static_cast<std::make_unsigned_t<T>>((bits << 8) | data[i]);
+    }
+    return static_cast<T>(bits);
+}
+
+}
+
+void BinaryLog::appendFileHeader(std::string& out) {
+    out.append(MAGIC, sizeof(MAGIC));
+    appendInteger<std::uint32_t>(out, VERSION);
+}
+
+void BinaryLog::appendRecord(const LogRecord& record, std::string& out) {
+    appendInteger<std::int64_t>(out, record.time);
+    appendInteger<std::uint8_t>(out, static_cast<std::uint8_t>(record.level));
+    appendInteger<std::uint8_t>(out, record.truncated ? 1 : 0);
+    appendInteger<std::uint16_t>(out, record.userLength);
+    appendInteger<std::uint16_t>(out, record.databaseLength);
+    appendInteger<std::uint16_t>(out, record.messageLength);
+    out.append(record.text, record.userLength + record.databaseLength + record.messageLength);
+}
+
+bool BinaryLog::dump(const std::string& path, LogLevel minimumLevel, std::ostream& out) {
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Error: Failed to open log file '" << path << "'." << std::endl;
+        return false;
+    }
+    gzbuffer(file, 256 * 1024);
+
+    unsigned char fileHeader[FILE_HEADER_SIZE];
+    if (gzread(file, fileHeader, FILE_HEADER_SIZE) != static_cast<int>(FILE_HEADER_SIZE) ||
+        std::memcmp(fileHeader, MAGIC, sizeof(MAGIC)) != 0 ||
+        readInteger<std::uint32_t>(fileHeader + sizeof(MAGIC)) != VERSION) {
+        std::cerr << "Error: '" << path << "' is not a binary log." << std::endl;
+        gzclose(file);
+        return false;
+    }
+
+    LogFormatter formatter;
+    std::string lines;
+    LogRecord record{};
+    unsigned char header[RECORD_HEADER_SIZE];
+    size_t offset = FILE_HEADER_SIZE;
+    bool complete = true;
+    for (;;) {
+        int read = gzread(file, header, RECORD_HEADER_SIZE);
+        if (read == 0) {
+            break;
+        }
+        record.time = static_cast<std::time_t>(readInteger<std::int64_t>(header));
+        std::uint8_t level = header[8];
+        record.truncated = (header[9] & 1) != 0;
+        record.userLength = readInteger<std::uint16_t>(header + 10);
+        record.databaseLength = readInteger<std::uint16_t>(header + 12);
+        record.messageLength = readInteger<std::uint16_t>(header + 14);
+        size_t textLength = record.userLength + record.databaseLength + record.messageLength;
+        if (read != static_cast<int>(RECORD_HEADER_SIZE) || level > static_cast<std::uint8_t>(LogLevel::ERROR) || textLength > LogRecord::TEXT_SIZE ||
+            gzread(file, record.text, static_cast<unsigned>(textLength)) != static_cast<int>(textLength)) {
+            std::cerr << "Error: Damaged log record at offset " << offset << " of '" << path << "'." << std::endl;
+            complete = false;
+            break;
+        }
+        record.level = static_cast<LogLevel>(level);
+        offset += RECORD_HEADER_SIZE + textLength;
+
+        if (record.level < minimumLevel) {
+            continue;
+        }
+        formatter.append(record, lines);
+        if (lines.size() >= 64 * 1024) {
+            out.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+            lines.clear();
+        }
+    }
+    out.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+    out.flush();
+    gzclose(file);
+    return complete;
+}
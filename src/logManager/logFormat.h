@@ -0,0 +1,50 @@
+#ifndef LOG_FORMAT_H
+#define LOG_FORMAT_H
+
+#include <string>
+#include <ostream>
+#include <cstdint>
+#include "logManager/logRing.h"
+
+enum class LogFormat {
+    TEXT,       // data/logs.txt, one line per event
+    BINARY      // data/logs.bin, see BinaryLog
+};
+
+bool stringToLogFormat(const std::string& formatString, LogFormat& format);
+
+// Appends records as text lines: [time] [user] [database] [LEVEL] message. The timestamp is
+// formatted once per second.
+class LogFormatter {
+public:
+    void append(const LogRecord& record, std::string& out);
+
+private:
+    std::time_t stampTime = -1;
+    std::string stamp;
+};
+
+// The binary log stores records as they sit in the ring, so writing one is a copy and a
+// reader can skip or filter records by their header without parsing any text. Little
+// endian, like the other binary formats:
+//   file   : magic "CJDBLOG1", u32 version, then records up to the end of the file
+//   record : i64 time (seconds since the epoch), u8 level (LogLevel), u8 flags (bit 0 =
+//            message truncated), u16 user length, u16 database length, u16 message length,
+//            then the user, database and message bytes
+namespace BinaryLog {
+
+constexpr char MAGIC[8] = {'C', 'J', 'D', 'B', 'L', 'O', 'G', '1'};
+constexpr std::uint32_t VERSION = 1;
+constexpr size_t FILE_HEADER_SIZE = sizeof(MAGIC) + sizeof(std::uint32_t);
+constexpr size_t RECORD_HEADER_SIZE = 16;
+
+void appendFileHeader(std::string& out);
+void appendRecord(const LogRecord& record, std::string& out);
+// Prints the records of a binary log at minimumLevel or above as text lines. Rotated
+// segments compressed with gzip are read as they are. False when the file cannot be read
+// or is not a binary log; a damaged tail is reported and ends the dump.
+bool dump(const std::string& path, LogLevel minimumLevel, std::ostream& out);
+
+}
+
+#endif
@@ -1,34 +1,270 @@
 #include "logManager/logManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <zlib.h>
 
-LogManager::LogManager() {
-    logFile.open("data/logs.txt", std::ios::app);
-    if (!logFile.is_open()) {
-        std::cerr << "Unable to open log file!" << std::endl;
+namespace fs = std::filesystem;
+
+namespace {
+
+// gzips path to path.gz and removes path; on failure path is kept as it is.
+bool compressFile(const std::string& path) {
+    std::ifstream input(path, std::ios::binary);
+    gzFile output = gzopen((path + ".gz").c_str(), "wb6");
+    if (!input.is_open() || !output) {
+        if (output) {
+            gzclose(output);
+        }
+        return false;
+    }
+    std::string buffer(256 * 1024, '\0');
+    bool written = true;
+    while (written && input) {
+        input.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        std::streamsize count = input.gcount();
+        written = count == 0 || gzwrite(output, buffer.data(), static_cast<unsigned>(count)) == count;
     }
+    if (gzclose(output) != Z_OK || !written || input.bad()) {
+        fs::remove(path + ".gz");
+        return false;
+    }
+    input.close();
+    fs::remove(path);
+    return true;
+}
+
 }
 
+bool stringToLogLevel(const std::string& levelString, LogLevel& level) {
+    if (levelString == "info") {
+        level = LogLevel::INFO;
+    } else if (levelString == "warning") {
+        level = LogLevel::WARNING;
+    } else if (levelString == "error") {
+        level = LogLevel::ERROR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+LogManager::LogManager() : ring(RING_CAPACITY) {
+    openLogFile();
+    compressor = std::thread(&LogManager::runCompressor, this);
+    writer = std::thread(&LogManager::run, this);
+}
+
+// Whatever is still queued is written before the file closes, and every rotated file is
+// compressed before the compressor stops.
 LogManager::~LogManager() {
-    if (logFile.is_open()) {
-        logFile.close();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    if (writer.joinable()) {
+        writer.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(compressMutex);
+        compressorStopping = true;
+    }
+    compressWakeUp.notify_all();
+    if (compressor.joinable()) {
+        compressor.join();
     }
 }
 
 void LogManager::log(LogLevel level, const std::string& user, const std::string& database, const std::string& message) {
-    if (!logFile.is_open()) {
-        std::cerr << "Log file is not open!" << std::endl;
+    bool queued = ring.push([&](LogRecord& record) {
+        record.time = std::time(nullptr);
+        record.level = level;
+        size_t space = LogRecord::TEXT_SIZE;
+        record.userLength = static_cast<std::uint16_t>(std::min(user.size(), space));
+        space -= record.userLength;
+        record.databaseLength = static_cast<std::uint16_t>(std::min(database.size(), space));
+        space -= record.databaseLength;
+        record.messageLength = static_cast<std::uint16_t>(std::min(message.size(), space));
+        record.truncated = static_cast<size_t>(record.userLength) + record.databaseLength + record.messageLength < user.size() + database.size() + message.size();
+        char* text = record.text;
+        std::memcpy(text, user.data(), record.userLength);
+        std::memcpy(text + record.userLength, database.data(), record.databaseLength);
+        std::memcpy(text + record.userLength + record.databaseLength, message.data(), record.messageLength);
+    });
+    if (!queued) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        wakeUp.notify_one();
+    } else if (ring.size() >= ring.capacity() / 2) {
+        wakeUp.notify_one();
+    }
+}
+
+void LogManager::setMinimumLevel(LogLevel level) {
+    minimumLevel.store(level, std::memory_order_relaxed);
+}
+
+LogLevel LogManager::getMinimumLevel() const {
+    return minimumLevel.load(std::memory_order_relaxed);
+}
+
+void LogManager::setFlushInterval(unsigned milliseconds) {
+    flushIntervalMs.store(std::max(1u, milliseconds), std::memory_order_relaxed);
+    wakeUp.notify_one();
+}
+
+unsigned LogManager::getFlushInterval() const {
+    return flushIntervalMs.load(std::memory_order_relaxed);
+}
+
+// The writer switches files at its next batch.
+void LogManager::setFormat(LogFormat newFormat) {
+    format.store(newFormat, std::memory_order_relaxed);
+}
+
+LogFormat LogManager::getFormat() const {
+    return format.load(std::memory_order_relaxed);
+}
+
+void LogManager::setRotation(size_t bytes, unsigned seconds, bool compress) {
+    rotateBytes.store(bytes, std::memory_order_relaxed);
+    rotateSeconds.store(seconds, std::memory_order_relaxed);
+    compressRotated.store(compress, std::memory_order_relaxed);
+}
+
+void LogManager::getRotation(size_t& bytes, unsigned& seconds, bool& compress) const {
+    bytes = rotateBytes.load(std::memory_order_relaxed);
+    seconds = rotateSeconds.load(std::memory_order_relaxed);
+    compress = compressRotated.load(std::memory_order_relaxed);
+}
+
+void LogManager::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        wakeUp.wait_for(lock, std::chrono::milliseconds(flushIntervalMs.load(std::memory_order_relaxed)));
+        lock.unlock();
+        writePending();
+        lock.lock();
+    }
+    lock.unlock();
+    writePending();
+}
+
+void LogManager::writePending() {
+    if (format.load(std::memory_order_relaxed) != fileFormat) {
+        openLogFile();
+    }
+    ring.drain([this](const LogRecord& record) {
+        appendRecord(record);
+    });
+    std::uint64_t lost = dropped.exchange(0, std::memory_order_relaxed);
+    if (lost > 0) {
+        LogRecord note{};
+        note.time = std::time(nullptr);
+        note.level = LogLevel::WARNING;
+        std::string message = std::to_string(lost) + " log events were dropped because the log buffer was full.";
+        note.messageLength = static_cast<std::uint16_t>(message.size());
+        std::memcpy(note.text, message.data(), message.size());
+        appendRecord(note);
+    }
+    if (batch.empty() || !logFile.is_open()) {
+        batch.clear();
         return;
     }
 
-    time_t now = std::time(nullptr);
-    tm* timeinfo = std::localtime(&now);
+    size_t maxBytes = rotateBytes.load(std::memory_order_relaxed);
+    unsigned maxSeconds = rotateSeconds.load(std::memory_order_relaxed);
+    bool hasRecords = fileBytes > (fileFormat == LogFormat::BINARY ? BinaryLog::FILE_HEADER_SIZE : 0);
+    bool full = maxBytes > 0 && fileBytes + batch.size() > maxBytes;
+    bool old = maxSeconds > 0 && std::time(nullptr) - fileOpened >= static_cast<std::time_t>(maxSeconds);
+    if (hasRecords && (full || old)) {
+        rotateLogFile();
+    }
+    if (logFile.is_open()) {
+        logFile.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        logFile.flush();
+        fileBytes += batch.size();
+    }
+    batch.clear();
+}
+
+void LogManager::appendRecord(const LogRecord& record) {
+    if (fileFormat == LogFormat::BINARY) {
+        BinaryLog::appendRecord(record, batch);
+    } else {
+        formatter.append(record, batch);
+    }
+}
+
+// Opens the file of the current format for appending; a new binary log starts with its
+// file header.
+void LogManager::openLogFile() {
+    if (logFile.is_open()) {
+        logFile.close();
+    }
+    fileFormat = format.load(std::memory_order_relaxed);
+    logPath = fileFormat == LogFormat::BINARY ? "data/logs.bin" : "data/logs.txt";
+    logFile.open(logPath, std::ios::app | std::ios::binary);
+    if (!logFile.is_open()) {
+        std::cerr << "Unable to open log file!" << std::endl;
+        return;
+    }
+    std::error_code error;
+    fileBytes = fs::file_size(logPath, error);
+    if (error) {
+        fileBytes = 0;
+    }
+    fileOpened = std::time(nullptr);
+    if (fileFormat == LogFormat::BINARY && fileBytes == 0) {
+        std::string header;
+        BinaryLog::appendFileHeader(header);
+        logFile.write(header.data(), static_cast<std::streamsize>(header.size()));
+        fileBytes = header.size();
+    }
+}
 
-    logFile << "[" << std::put_time(timeinfo, "%Y-%m-%d %H:%M:%S") << "] ";
-    if (!user.empty()) logFile << "[" << user << "] ";
-    if (!database.empty()) logFile << "[" << database << "] ";
+void LogManager::rotateLogFile() {
+    logFile.close();
+    std::time_t now = std::time(nullptr);
+    std::tm timeinfo{};
+    localtime_r(&now, &timeinfo);
+    char buffer[32];
+    size_t length = std::strftime(buffer, sizeof(buffer), "%Y%m%d-%H%M%S", &timeinfo);
+    std::string stamp(buffer, length);
+    std::string extension = fileFormat == LogFormat::BINARY ? ".bin" : ".txt";
 
-    if (level == LogLevel::INFO) logFile << "[INFO] ";
-    else if (level == LogLevel::WARNING) logFile << "[WARNING] ";
-    else if (level == LogLevel::ERROR) logFile << "[ERROR] ";
+    std::string rotated = "data/logs-" + stamp + extension;
+    for (int count = 1; fs::exists(rotated) || fs::exists(rotated + ".gz"); ++count) {
+        rotated = "data/logs-" + stamp + "-" + std::to_string(count) + extension;
+    }
+    std::error_code error;
+    fs::rename(logPath, rotated, error);
+    if (error) {
+        std::cerr << "Unable to rotate log file: " << error.message() << std::endl;
+    } else if (compressRotated.load(std::memory_order_relaxed)) {
+        {
+            std::lock_guard<std::mutex> lock(compressMutex);
+            compressQueue.push_back(rotated);
+        }
+        compressWakeUp.notify_one();
+    }
+    openLogFile();
+}
 
-    logFile << message << std::endl;
+void LogManager::runCompressor() {
+    std::unique_lock<std::mutex> lock(compressMutex);
+    for (;;) {
+        compressWakeUp.wait(lock, [this] { return compressorStopping || !compressQueue.empty(); });
+        if (compressQueue.empty()) {
+            return;
+        }
+        std::string path = std::move(compressQueue.front());
+        compressQueue.pop_front();
+        lock.unlock();
+        if (!compressFile(path)) {
+            std::cerr << "Unable to compress rotated log file '" << path << "'." << std::endl;
+        }
+        lock.lock();
+    }
 }
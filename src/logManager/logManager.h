@@ -3,24 +3,54 @@
 
 #include <iostream>
 #include <fstream>
-#include <string>
 #include <ctime>
-#include <iomanip>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include "logManager/logRing.h"
+#include "logManager/logFormat.h"
 
-enum class LogLevel {
-    INFO,
-    WARNING,
-    ERROR
-};
+bool stringToLogLevel(const std::string& levelString, LogLevel& level);
 
+// Writes the log to data/logs.txt off the calling thread. log() copies the event into a
+// fixed-size record in a lock-free ring and returns; a background thread wakes every flush
+// interval, or sooner once the ring is half full, formats everything queued and writes it
+// with one write and one flush. Events below the minimum level are dropped before they are
+// formatted, and the LOG macro does not even build their message. When the ring is full
+// the event is counted and dropped, and the writer notes how many were lost.
+//
+// The log is written as text to data/logs.txt or, in the binary format, to data/logs.bin.
+// Once a write would take the file past the rotation size, or the file was opened longer
+// ago than the rotation age, it is renamed to data/logs-<time>.txt or .bin and a new file is
+// started. When compression is on, a second thread gzips the renamed files, so a large
+// segment does not hold up the writer while the ring fills.
 class LogManager {
 public:
+    static constexpr size_t RING_CAPACITY = 4096;
+    static constexpr unsigned DEFAULT_FLUSH_INTERVAL_MS = 200;
+    static constexpr size_t DEFAULT_ROTATE_BYTES = 10 * 1024 * 1024;
+
     static LogManager& getInstance() {
         static LogManager instance; 
         return instance;
     }
 
     void log(LogLevel level, const std::string& user, const std::string& database, const std::string& message);
+    bool isEnabled(LogLevel level) const { return level >= minimumLevel.load(std::memory_order_relaxed); }
+
+    void setMinimumLevel(LogLevel level);
+    LogLevel getMinimumLevel() const;
+    void setFlushInterval(unsigned milliseconds);
+    unsigned getFlushInterval() const;
+    void setFormat(LogFormat format);
+    LogFormat getFormat() const;
+    // A size or age of 0 turns that trigger off.
+    void setRotation(size_t bytes, unsigned seconds, bool compress);
+    void getRotation(size_t& bytes, unsigned& seconds, bool& compress) const;
 
 private:
     LogManager(); 
@@ -29,12 +59,49 @@ private:
     LogManager(const LogManager&) = delete; 
     LogManager& operator=(const LogManager&) = delete;
 
+    void run();
+    void writePending();
+    void appendRecord(const LogRecord& record);
+    void openLogFile();
+    void rotateLogFile();
+    void runCompressor();
+
+    LogRing ring;
+    std::atomic<LogLevel> minimumLevel{LogLevel::INFO};
+    std::atomic<unsigned> flushIntervalMs{DEFAULT_FLUSH_INTERVAL_MS};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<LogFormat> format{LogFormat::TEXT};
+    std::atomic<size_t> rotateBytes{DEFAULT_ROTATE_BYTES};
+    std::atomic<unsigned> rotateSeconds{0};
+    std::atomic<bool> compressRotated{false};
+
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool stopping = false;
+    std::thread writer;
+
+    // Rotated files waiting for the compressor, guarded by compressMutex.
+    std::mutex compressMutex;
+    std::condition_variable compressWakeUp;
+    std::deque<std::string> compressQueue;
+    bool compressorStopping = false;
+    std::thread compressor;
+
+    // Used by the writer thread only, once it runs.
     std::ofstream logFile;
+    LogFormat fileFormat = LogFormat::TEXT;
+    std::string logPath;
+    size_t fileBytes = 0;
+    std::time_t fileOpened = 0;
+    std::string batch;
+    LogFormatter formatter;
 };
 
 #define LOG(level, user, database, message) \
     do { \
-        LogManager::getInstance().log(level, user, database, message); \
+        if (LogManager::getInstance().isEnabled(level)) { \
+            LogManager::getInstance().log(level, user, database, message); \
+        } \
     } while (false)
 
 #define DISPLAY_MESSAGE(message) \
@@ -0,0 +1,109 @@
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+enum class LogLevel {
+    INFO,
+    WARNING,
+    ERROR
+};
+
+// One log event as a caller hands it over: fixed size, so nothing is allocated on the way
+// to the writer. user, database and message are stored back to back in text; a message
+// that does not fit is cut and marked truncated.
+struct LogRecord {
+    static constexpr size_t TEXT_SIZE = 480;
+
+    std::time_t time;
+    LogLevel level;
+    bool truncated;
+    std::uint16_t userLength;
+    std::uint16_t databaseLength;
+    std::uint16_t messageLength;
+    char text[TEXT_SIZE];
+};
+
+// Bounded queue of LogRecords for many producers and one consumer, after Dmitry Vyukov's
+// bounded MPMC queue. A producer claims a slot with one compare-and-swap on the enqueue
+// position, fills it and publishes it through the slot's sequence number; the consumer
+// takes published slots in order and hands them back by advancing the sequence a lap. No
+// one waits on a lock, and a full ring refuses the record instead of blocking.
+class LogRing {
+public:
+    // capacity must be a power of two.
+    explicit LogRing(size_t capacity) : slots(new Slot[capacity]), mask(capacity - 1) {
+        for (size_t i = 0; i < capacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // fill(LogRecord&) writes the claimed record. False when the ring is full.
+    template <typename Fill>
+    bool push(Fill&& fill) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots[position & mask];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            std::intptr_t difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        fill(slot->record);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only: passes every published record to visit(const LogRecord&) in order and
+    // returns how many there were. Stops at a slot that is claimed but not yet filled.
+    template <typename Visit>
+    size_t drain(Visit&& visit) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        size_t count = 0;
+        for (;;) {
+            Slot& slot = slots[position & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+                break;
+            }
+            visit(slot.record);
+            slot.sequence.store(position + mask + 1, std::memory_order_release);
+            ++position;
+            ++count;
+        }
+        dequeuePosition.store(position, std::memory_order_relaxed);
+        return count;
+    }
+
+    size_t capacity() const { return mask + 1; }
+    // Records claimed and not yet drained; approximate while producers are running.
+    size_t size() const {
+        size_t dequeued = dequeuePosition.load(std::memory_order_relaxed);
+        return enqueuePosition.load(std::memory_order_relaxed) - dequeued;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    const size_t mask;
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    // Written by the consumer only; atomic so producers can estimate size().
+    alignas(64) std::atomic<size_t> dequeuePosition{0};
+};
+
+#endif
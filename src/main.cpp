@@ -1,14 +1,67 @@
 #include "commandFactory/headers/commandFactory.h"
 #include "repl/headers/repl.h"
 #include "testManager/testManager.h"
+#include "server/server.h"
+#include "logManager/logManager.h"
+#include "storageManager/fileAccess.h"
 #include <vector>
 #include <string>
+#include <thread>
 
 const bool TEST_MODE = true;
 const std::string TEST_CONFIG_PATH = "tests.cfg";
 const bool SAVE_EXECUTION_DETAILS = true;
 
+// dbms --server <unix:path | tcp:[host:]port> [--workers <count>] [--protocol text|binary]
+// [--file-dir <directory>] serves clients instead of running the REPL; the workers default
+// to one per hardware thread and the protocol to the REPL's text. Clients may only import
+// and export files in the --file-dir directory, and none without it.
+int runServer(int argc, char* argv[]) {
+    const std::string usage = std::string("Usage: ") + argv[0] + " --server <unix:path | tcp:[host:]port> [--workers <count>] [--protocol text|binary] [--file-dir <directory>]";
+    size_t workers = std::thread::hardware_concurrency();
+    Session::Protocol protocol = Session::Protocol::TEXT;
+    std::string fileDirectory;
+    if (argc < 3 || argc % 2 == 0) {
+        std::cerr << usage << std::endl;
+        return 1;
+    }
+    for (int i = 3; i < argc; i += 2) {
+        std::string option = argv[i];
+        std::string value = argv[i + 1];
+        if (option == "--workers") {
+            workers = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (option == "--protocol" && (value == "text" || value == "binary")) {
+            protocol = value == "binary" ? Session::Protocol::BINARY : Session::Protocol::TEXT;
+        } else if (option == "--file-dir") {
+            fileDirectory = value;
+        } else {
+            std::cerr << usage << std::endl;
+            return 1;
+        }
+    }
+    FileAccess::restrictTo(fileDirectory);
+    Server server(workers, protocol);
+    return server.listen(argv[2]) && server.run() ? 0 : 1;
+}
+
+// dbms --dump-log <file> [--level info|warning|error] prints a binary log, or a gzipped
+// rotated segment of one, as text lines.
+int dumpLog(int argc, char* argv[]) {
+    LogLevel level = LogLevel::INFO;
+    if (argc != 3 && !(argc == 5 && std::string(argv[3]) == "--level" && stringToLogLevel(argv[4], level))) {
+        std::cerr << "Usage: " << argv[0] << " --dump-log <file> [--level info|warning|error]" << std::endl;
+        return 1;
+    }
+    return BinaryLog::dump(argv[2], level, std::cout) ? 0 : 1;
+}
+
 int main(int argc, char* argv[]) {
+    if (argc > 1 && std::string(argv[1]) == "--server") {
+        return runServer(argc, argv);
+    }
+    if (argc > 1 && std::string(argv[1]) == "--dump-log") {
+        return dumpLog(argc, argv);
+    }
     std::string currentUser, currentDatabase;
     CommandFactory factory(currentUser, currentDatabase);
     Repl repl(factory, currentUser, currentDatabase);
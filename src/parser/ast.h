@@ -0,0 +1,104 @@
+#ifndef AST_H
+#define AST_H
+
+#include <string>
+#include <vector>
+#include <memory>
+
+// Statements produced by SqlParser. Literals keep their source text; they are converted to
+// the column's type when the statement is compiled against a table schema.
+
+// A value written in a statement, or a placeholder (? or $n) that is bound to a value
+// before the statement runs.
+struct Literal {
+    std::string text;
+    char quote = '\0';      // the quote character of a string literal
+    int parameter = -1;     // index of the placeholder, -1 for a value
+};
+
+struct ColumnRef {
+    std::string table;      // empty when the column is not qualified
+    std::string column;     // "*" selects every column
+};
+
+struct WhereExpr {
+    enum class Kind {
+        COMPARISON,     // column op literal
+        AND,
+        OR,
+        NOT             // negates left
+    };
+
+    Kind kind = Kind::COMPARISON;
+    ColumnRef column;
+    std::string op;
+    Literal literal;
+    std::unique_ptr<WhereExpr> left;
+    std::unique_ptr<WhereExpr> right;
+};
+
+struct JoinClause {
+    std::string joinType;   // "INNER JOIN", "LEFT JOIN", "RIGHT JOIN" or "FULL JOIN"
+    std::string table;
+    ColumnRef left;
+    ColumnRef right;
+};
+
+struct OrderItem {
+    ColumnRef column;
+    bool descending = false;
+};
+
+struct SelectStatement {
+    std::vector<ColumnRef> columns;
+    std::string table;
+    std::vector<JoinClause> joins;
+    std::unique_ptr<WhereExpr> where;
+    std::vector<OrderItem> orderBy;
+    long long limit = -1;   // -1 when there is no LIMIT
+    int limitParameter = -1;
+    bool intoOutfile = false;
+    Literal outfile;            // path of INTO OUTFILE
+    std::string outfileFormat;  // empty to follow the file extension
+};
+
+struct InsertStatement {
+    std::string table;
+    std::vector<std::string> columns;
+    std::vector<std::vector<Literal>> rows;     // one list of values per VALUES tuple
+};
+
+struct Assignment {
+    std::string column;
+    Literal value;
+};
+
+struct UpdateStatement {
+    std::string table;
+    std::vector<Assignment> assignments;
+    std::unique_ptr<WhereExpr> where;
+};
+
+struct DeleteStatement {
+    std::string table;
+    std::unique_ptr<WhereExpr> where;
+};
+
+// A statement of any kind, as kept by the plan cache and by PREPARE.
+struct Statement {
+    enum class Kind {
+        SELECT,
+        INSERT,
+        UPDATE,
+        DELETE
+    };
+
+    Kind kind = Kind::SELECT;
+    SelectStatement select;
+    InsertStatement insert;
+    UpdateStatement update;
+    DeleteStatement remove;
+    size_t parameterCount = 0;
+};
+
+#endif
@@ -0,0 +1,187 @@
+#include "parser/lexer.h"
+#include <cctype>
+
+namespace {
+
+bool isSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c));
+}
+
+bool isIdentifierChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isQuote(char c) {
+    return c == '\'' || c == '"';
+}
+
+// Index just past the quote closing the one at pos; the end of input when unterminated.
+size_t skipQuoted(std::string_view input, size_t pos) {
+    size_t close = input.find(input[pos], pos + 1);
+    return close == std::string_view::npos ? input.size() : close + 1;
+}
+
+// Index just past the bracket matching the one at pos, skipping quoted text; npos when the
+// input ends first.
+size_t skipGroup(std::string_view input, size_t pos, char open, char close) {
+    size_t depth = 0;
+    while (pos < input.size()) {
+        char c = input[pos];
+        if (isQuote(c)) {
+            pos = skipQuoted(input, pos);
+            continue;
+        }
+        if (c == open) {
+            ++depth;
+        } else if (c == close && --depth == 0) {
+            return pos + 1;
+        }
+        ++pos;
+    }
+    return std::string_view::npos;
+}
+
+}
+
+namespace Lexer {
+
+std::vector<std::string_view> tokenize(std::string_view input) {
+    std::vector<std::string_view> tokens;
+    size_t pos = 0;
+    while (pos < input.size()) {
+        char c = input[pos];
+        if (isSpace(c) || c == ',' || c == ')') {
+            ++pos;
+            continue;
+        }
+        if (c == '(') {
+            size_t end = skipGroup(input, pos, '(', ')');
+            if (end == std::string_view::npos) {
+                ++pos;
+                continue;
+            }
+            tokens.push_back(input.substr(pos, end - pos));
+            pos = end;
+            continue;
+        }
+
+        size_t start = pos;
+        while (pos < input.size()) {
+            c = input[pos];
+            if (isSpace(c) || c == ',' || c == '(' || c == ')') {
+                break;
+            }
+            pos = isQuote(c) ? skipQuoted(input, pos) : pos + 1;
+        }
+        tokens.push_back(input.substr(start, pos - start));
+    }
+    return tokens;
+}
+
+std::vector<std::string_view> splitTopLevel(std::string_view input, char separator) {
+    std::vector<std::string_view> pieces;
+    if (trim(input).empty()) {
+        return pieces;
+    }
+
+    size_t start = 0;
+    size_t pos = 0;
+    while (pos < input.size()) {
+        char c = input[pos];
+        if (c == separator) {
+            pieces.push_back(trim(input.substr(start, pos - start)));
+            start = ++pos;
+        } else if (isQuote(c)) {
+            pos = skipQuoted(input, pos);
+        } else if (c == '(' || c == '{') {
+            size_t end = skipGroup(input, pos, c, c == '(' ? ')' : '}');
+            pos = end == std::string_view::npos ? input.size() : end;
+        } else {
+            ++pos;
+        }
+    }
+    pieces.push_back(trim(input.substr(start)));
+    return pieces;
+}
+
+bool enclosed(std::string_view input, char open, char close, std::string_view& inside) {
+    size_t start = input.find(open);
+    if (start == std::string_view::npos) {
+        return false;
+    }
+    size_t end = skipGroup(input, start, open, close);
+    if (end == std::string_view::npos) {
+        return false;
+    }
+    inside = input.substr(start + 1, end - start - 2);
+    return true;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && isSpace(text.front())) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && isSpace(text.back())) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+std::string_view unquote(std::string_view text) {
+    if (text.size() >= 2 && isQuote(text.front()) && text.back() == text.front()) {
+        return text.substr(1, text.size() - 2);
+    }
+    return text;
+}
+
+std::vector<SqlToken> scanSql(std::string_view input) {
+    std::vector<SqlToken> tokens;
+    size_t pos = 0;
+    while (pos < input.size()) {
+        char c = input[pos];
+        if (isSpace(c)) {
+            ++pos;
+            continue;
+        }
+
+        size_t start = pos;
+        if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            while (pos < input.size() && isIdentifierChar(input[pos])) {
+                ++pos;
+            }
+            tokens.push_back({SqlTokenType::IDENTIFIER, input.substr(start, pos - start)});
+        } else if (std::isdigit(static_cast<unsigned char>(c))) {
+            while (pos < input.size() && (isIdentifierChar(input[pos]) || input[pos] == '.' || input[pos] == '-' || input[pos] == ':')) {
+                ++pos;
+            }
+            tokens.push_back({SqlTokenType::NUMBER, input.substr(start, pos - start)});
+        } else if (isQuote(c)) {
+            size_t close = input.find(c, pos + 1);
+            if (close == std::string_view::npos) {
+                tokens.push_back({SqlTokenType::INVALID, input.substr(start)});
+                break;
+            }
+            tokens.push_back({SqlTokenType::STRING, input.substr(start + 1, close - start - 1), c});
+            pos = close + 1;
+        } else if (c == '?' || (c == '$' && pos + 1 < input.size() && std::isdigit(static_cast<unsigned char>(input[pos + 1])))) {
+            ++pos;
+            while (c == '$' && pos < input.size() && std::isdigit(static_cast<unsigned char>(input[pos]))) {
+                ++pos;
+            }
+            tokens.push_back({SqlTokenType::PARAMETER, input.substr(start, pos - start)});
+        } else if ((c == '<' || c == '>' || c == '!') && pos + 1 < input.size() && (input[pos + 1] == '=' || (c == '<' && input[pos + 1] == '>'))) {
+            tokens.push_back({SqlTokenType::SYMBOL, input.substr(start, 2)});
+            pos += 2;
+        } else if (std::string_view("=<>(),.*;+-").find(c) != std::string_view::npos) {
+            tokens.push_back({SqlTokenType::SYMBOL, input.substr(start, 1)});
+            ++pos;
+        } else {
+            tokens.push_back({SqlTokenType::INVALID, input.substr(start, 1)});
+            ++pos;
+        }
+    }
+    tokens.push_back({SqlTokenType::END, input.substr(input.size())});
+    return tokens;
+}
+
+}
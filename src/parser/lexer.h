@@ -0,0 +1,44 @@
+#ifndef LEXER_H
+#define LEXER_H
+
+#include <string_view>
+#include <vector>
+
+enum class SqlTokenType {
+    IDENTIFIER,     // names and keywords: a letter or '_' followed by letters, digits and '_'
+    NUMBER,         // starts with a digit; also covers unquoted dates such as 2024-01-31
+    STRING,         // quoted text, text holds the contents without the quotes
+    SYMBOL,         // operators and punctuation: = != <> < <= > >= ( ) , . * ; + -
+    PARAMETER,      // a placeholder for a prepared statement: ? or $ followed by its number
+    INVALID,        // a character no other token starts with
+    END
+};
+
+struct SqlToken {
+    SqlTokenType type;
+    std::string_view text;
+    char quote = '\0';      // the quote character of a STRING token
+};
+
+// Hand-written scanner for command lines. Tokens are views into the input, so the caller
+// keeps the input alive while it uses them; nothing is copied and no regex is compiled.
+namespace Lexer {
+    // Command tokens, separated by whitespace and commas:
+    //   - a word runs up to whitespace, a comma or a parenthesis; a quoted section inside
+    //     it ('...' or "...") is part of the word even when it holds those characters,
+    //   - a parenthesised group is one token, brackets included, up to the matching ')'.
+    // Stray ')' and unbalanced '(' are skipped.
+    std::vector<std::string_view> tokenize(std::string_view input);
+    // Splits on separator where it is outside quotes, () and {}; pieces are trimmed.
+    std::vector<std::string_view> splitTopLevel(std::string_view input, char separator);
+    // The text between the first open bracket and its matching close; false when unbalanced.
+    bool enclosed(std::string_view input, char open, char close, std::string_view& inside);
+    std::string_view trim(std::string_view text);
+    // Drops one pair of matching single or double quotes around text.
+    std::string_view unquote(std::string_view text);
+
+    // Statement tokens for the SQL parser, always terminated by an END token.
+    std::vector<SqlToken> scanSql(std::string_view input);
+}
+
+#endif
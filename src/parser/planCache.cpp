@@ -0,0 +1,215 @@
+#include "parser/planCache.h"
+#include "parser/sqlParser.h"
+#include <charconv>
+
+namespace {
+
+// Builds the cache key of a statement and collects the values the key leaves out. False
+// for statements the key cannot stand for, those holding placeholders or invalid
+// characters; they are parsed directly. Double-quoted strings stay in the key, since
+// INSERT uses them for column names.
+bool normalize(Statement::Kind kind, std::string_view sql, std::string& key, std::vector<Literal>& values) {
+    std::vector<SqlToken> tokens = Lexer::scanSql(sql);
+    key = statementKeyword(kind);
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        const SqlToken& token = tokens[i];
+        switch (token.type) {
+            case SqlTokenType::END:
+                return true;
+            case SqlTokenType::INVALID:
+            case SqlTokenType::PARAMETER:
+                return false;
+            case SqlTokenType::NUMBER:
+                values.push_back({std::string(token.text)});
+                key += " ?";
+                break;
+            case SqlTokenType::STRING:
+                if (token.quote == '\'') {
+                    values.push_back({std::string(token.text), token.quote});
+                    key += " ?";
+                } else {
+                    key += ' ';
+                    key += token.quote;
+                    key += token.text;
+                    key += token.quote;
+                }
+                break;
+            case SqlTokenType::SYMBOL:
+                if ((token.text == "-" || token.text == "+") && tokens[i + 1].type == SqlTokenType::NUMBER) {
+                    values.push_back({std::string(token.text) + std::string(tokens[i + 1].text)});
+                    key += " ?";
+                    ++i;
+                    break;
+                }
+                [[fallthrough]];
+            case SqlTokenType::IDENTIFIER:
+                key += ' ';
+                key += token.text;
+                break;
+        }
+    }
+    return true;
+}
+
+void bindLiteral(const Literal& literal, const std::vector<Literal>& parameters, Literal& bound) {
+    bound = literal.parameter < 0 ? literal : parameters[literal.parameter];
+}
+
+void bindWhere(const WhereExpr& expr, const std::vector<Literal>& parameters, std::unique_ptr<WhereExpr>& bound) {
+    bound = std::make_unique<WhereExpr>();
+    bound->kind = expr.kind;
+    bound->column = expr.column;
+    bound->op = expr.op;
+    bindLiteral(expr.literal, parameters, bound->literal);
+    if (expr.left) {
+        bindWhere(*expr.left, parameters, bound->left);
+    }
+    if (expr.right) {
+        bindWhere(*expr.right, parameters, bound->right);
+    }
+}
+
+bool bindLimit(const SelectStatement& plan, const std::vector<Literal>& parameters, long long& limit, std::string& error) {
+    limit = plan.limit;
+    if (plan.limitParameter < 0) {
+        return true;
+    }
+    const Literal& value = parameters[plan.limitParameter];
+    const char* end = value.text.data() + value.text.size();
+    auto [last, ec] = std::from_chars(value.text.data(), end, limit);
+    if (value.quote != '\0' || ec != std::errc() || last != end || limit < 0) {
+        error = "LIMIT expects a row count but got '" + value.text + "'";
+        return false;
+    }
+    return true;
+}
+
+}
+
+PlanCache& PlanCache::getInstance() {
+    static PlanCache instance;
+    return instance;
+}
+
+bool PlanCache::getStatement(Statement::Kind kind, const std::string& sql, Statement& statement, std::string& error) {
+    std::string key;
+    std::vector<Literal> values;
+    if (!normalize(kind, sql, key, values)) {
+        SqlParser parser(sql);
+        if (!parser.parse(kind, statement)) {
+            error = parser.error();
+            return false;
+        }
+        if (statement.parameterCount > 0) {
+            error = "placeholders can only be used in prepared statements";
+            return false;
+        }
+        return true;
+    }
+
+    std::shared_ptr<const Statement> plan;
+    if (!find(key, plan)) {
+        auto parsed = std::make_shared<Statement>();
+        SqlParser parser(key.substr(statementKeyword(kind).size()));
+        if (!parser.parse(kind, *parsed)) {
+            // Reported against the statement as written, not its normalized key.
+            Statement unused;
+            SqlParser original(sql);
+            error = original.parse(kind, unused) ? parser.error() : original.error();
+            return false;
+        }
+        plan = parsed;
+        insert(key, plan);
+    }
+    return bindStatement(*plan, values, statement, error);
+}
+
+bool PlanCache::find(const std::string& key, std::shared_ptr<const Statement>& plan) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return false;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    plan = it->second->second;
+    return true;
+}
+
+void PlanCache::insert(const std::string& key, std::shared_ptr<const Statement> plan) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (index.count(key)) {
+        return;
+    }
+    entries.emplace_front(key, std::move(plan));
+    index[key] = entries.begin();
+    if (entries.size() > DEFAULT_CAPACITY) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+std::string statementKeyword(Statement::Kind kind) {
+    switch (kind) {
+        case Statement::Kind::SELECT: return "SELECT";
+        case Statement::Kind::INSERT: return "INSERT";
+        case Statement::Kind::UPDATE: return "UPDATE";
+        case Statement::Kind::DELETE: return "DELETE";
+    }
+    return "";
+}
+
+bool bindStatement(const Statement& plan, const std::vector<Literal>& parameters, Statement& statement, std::string& error) {
+    if (parameters.size() != plan.parameterCount) {
+        error = "expected " + std::to_string(plan.parameterCount) + " values but got " + std::to_string(parameters.size());
+        return false;
+    }
+
+    statement.kind = plan.kind;
+    statement.parameterCount = 0;
+    switch (plan.kind) {
+        case Statement::Kind::SELECT: {
+            const SelectStatement& select = plan.select;
+            statement.select.columns = select.columns;
+            statement.select.table = select.table;
+            statement.select.joins = select.joins;
+            statement.select.orderBy = select.orderBy;
+            statement.select.intoOutfile = select.intoOutfile;
+            statement.select.outfileFormat = select.outfileFormat;
+            bindLiteral(select.outfile, parameters, statement.select.outfile);
+            if (select.where) {
+                bindWhere(*select.where, parameters, statement.select.where);
+            }
+            return bindLimit(select, parameters, statement.select.limit, error);
+        }
+        case Statement::Kind::INSERT:
+            statement.insert.table = plan.insert.table;
+            statement.insert.columns = plan.insert.columns;
+            statement.insert.rows.resize(plan.insert.rows.size());
+            for (size_t row = 0; row < plan.insert.rows.size(); ++row) {
+                const auto& values = plan.insert.rows[row];
+                statement.insert.rows[row].resize(values.size());
+                for (size_t i = 0; i < values.size(); ++i) {
+                    bindLiteral(values[i], parameters, statement.insert.rows[row][i]);
+                }
+            }
+            return true;
+        case Statement::Kind::UPDATE:
+            statement.update.table = plan.update.table;
+            statement.update.assignments.resize(plan.update.assignments.size());
+            for (size_t i = 0; i < plan.update.assignments.size(); ++i) {
+                statement.update.assignments[i].column = plan.update.assignments[i].column;
+                bindLiteral(plan.update.assignments[i].value, parameters, statement.update.assignments[i].value);
+            }
+            if (plan.update.where) {
+                bindWhere(*plan.update.where, parameters, statement.update.where);
+            }
+            return true;
+        case Statement::Kind::DELETE:
+            statement.remove.table = plan.remove.table;
+            if (plan.remove.where) {
+                bindWhere(*plan.remove.where, parameters, statement.remove.where);
+            }
+            return true;
+    }
+    return false;
+}
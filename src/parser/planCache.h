@@ -0,0 +1,54 @@
+#ifndef PLAN_CACHE_H
+#define PLAN_CACHE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "parser/ast.h"
+
+// Parsed statements keyed by their normalized text: the statement's tokens joined by single
+// spaces, with every number and single-quoted string replaced by a placeholder. Statements
+// that differ only in their values share one entry, so a new statement is scanned once to
+// build its key and is not parsed again; its values are bound into a copy of the cached
+// tree. Beyond DEFAULT_CAPACITY entries the least recently used one is dropped.
+class PlanCache {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    static PlanCache& getInstance();
+
+    // sql is the statement after its keyword, as the command of that kind receives it.
+    // error describes the problem when false is returned.
+    bool getStatement(Statement::Kind kind, const std::string& sql, Statement& statement, std::string& error);
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const Statement>>;
+
+    PlanCache() = default;
+    PlanCache(const PlanCache&) = delete;
+    PlanCache& operator=(const PlanCache&) = delete;
+
+    bool find(const std::string& key, std::shared_ptr<const Statement>& plan);
+    void insert(const std::string& key, std::shared_ptr<const Statement> plan);
+
+    std::mutex mutex;
+    std::list<Entry> entries;      // most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+};
+
+// Statements prepared by PREPARE in one session, by name.
+using PreparedStatements = std::unordered_map<std::string, std::shared_ptr<const Statement>>;
+
+// The keyword of a statement kind, which is also the name its command is registered under.
+std::string statementKeyword(Statement::Kind kind);
+
+// Copies plan with each placeholder replaced by its value from parameters.
+bool bindStatement(const Statement& plan, const std::vector<Literal>& parameters, Statement& statement, std::string& error);
+
+#define INIT_PLAN_CACHE PlanCache& planCache = PlanCache::getInstance();
+
+#endif
@@ -0,0 +1,500 @@
+#include "parser/sqlParser.h"
+#include <charconv>
+#include <cctype>
+#include <algorithm>
+
+namespace {
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::toupper(static_cast<unsigned char>(a[i])) != std::toupper(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isComparisonOperator(std::string_view symbol) {
+    return symbol == "=" || symbol == "!=" || symbol == "<>" || symbol == "<" || symbol == ">" || symbol == "<=" || symbol == ">=";
+}
+
+std::string describe(const SqlToken& token) {
+    if (token.type == SqlTokenType::END) {
+        return "end of statement";
+    }
+    std::string quoted;
+    quoted.reserve(token.text.size() + 2);
+    quoted += '\'';
+    quoted += token.text;
+    quoted += '\'';
+    return quoted;
+}
+
+}
+
+SqlParser::SqlParser(std::string sql) : text(std::move(sql)), tokens(Lexer::scanSql(text)) {}
+
+bool SqlParser::atKeyword(std::string_view keyword) const {
+    return peek().type == SqlTokenType::IDENTIFIER && equalsIgnoreCase(peek().text, keyword);
+}
+
+bool SqlParser::atSymbol(std::string_view symbol) const {
+    return peek().type == SqlTokenType::SYMBOL && peek().text == symbol;
+}
+
+bool SqlParser::acceptKeyword(std::string_view keyword) {
+    if (!atKeyword(keyword)) {
+        return false;
+    }
+    ++position;
+    return true;
+}
+
+bool SqlParser::acceptSymbol(std::string_view symbol) {
+    if (!atSymbol(symbol)) {
+        return false;
+    }
+    ++position;
+    return true;
+}
+
+bool SqlParser::expectKeyword(std::string_view keyword) {
+    return acceptKeyword(keyword) || fail("expected " + std::string(keyword) + " but found " + describe(peek()));
+}
+
+bool SqlParser::expectSymbol(std::string_view symbol) {
+    return acceptSymbol(symbol) || fail("expected '" + std::string(symbol) + "' but found " + describe(peek()));
+}
+
+bool SqlParser::expectIdentifier(std::string& name) {
+    if (peek().type != SqlTokenType::IDENTIFIER) {
+        return fail("expected a name but found " + describe(peek()));
+    }
+    name = std::string(peek().text);
+    ++position;
+    return true;
+}
+
+bool SqlParser::expectEnd() {
+    acceptSymbol(";");
+    return peek().type == SqlTokenType::END || fail("unexpected " + describe(peek()));
+}
+
+bool SqlParser::fail(const std::string& message) {
+    if (errorMessage.empty()) {
+        errorMessage = message;
+    }
+    return false;
+}
+
+bool SqlParser::parseColumnRef(ColumnRef& column) {
+    if (acceptSymbol("*")) {
+        column.column.assign(1, '*');
+        return true;
+    }
+    if (!expectIdentifier(column.column)) {
+        return false;
+    }
+    if (acceptSymbol(".")) {
+        column.table.swap(column.column);
+        column.column.clear();
+        if (acceptSymbol("*")) {
+            column.column.assign(1, '*');
+            return true;
+        }
+        return expectIdentifier(column.column);
+    }
+    return true;
+}
+
+bool SqlParser::parseLiteral(Literal& literal) {
+    if (peek().type == SqlTokenType::PARAMETER) {
+        return parsePlaceholder(literal.parameter);
+    }
+    std::string sign;
+    if (atSymbol("-") || atSymbol("+")) {
+        sign = std::string(peek().text);
+        ++position;
+        if (peek().type != SqlTokenType::NUMBER) {
+            return fail("expected a number after '" + sign + "'");
+        }
+    }
+    const SqlToken& token = peek();
+    if (token.type != SqlTokenType::STRING && token.type != SqlTokenType::NUMBER && token.type != SqlTokenType::IDENTIFIER) {
+        return fail("expected a value but found " + describe(token));
+    }
+    literal.text = sign + std::string(token.text);
+    literal.quote = token.quote;
+    ++position;
+    return true;
+}
+
+bool SqlParser::parsePlaceholder(int& parameter) {
+    std::string_view text = peek().text;
+    if (text == "?") {
+        parameter = static_cast<int>(parameters);
+    } else {
+        auto [end, ec] = std::from_chars(text.data() + 1, text.data() + text.size(), parameter);
+        if (ec != std::errc() || parameter < 1) {
+            return fail("invalid placeholder '" + std::string(text) + "'");
+        }
+        --parameter;
+    }
+    parameters = std::max(parameters, static_cast<size_t>(parameter) + 1);
+    ++position;
+    return true;
+}
+
+bool SqlParser::parseJoin(JoinClause& join) {
+    std::string joinType = "INNER";
+    for (std::string_view type : {"INNER", "LEFT", "RIGHT", "FULL"}) {
+        if (acceptKeyword(type)) {
+            joinType = std::string(type);
+            acceptKeyword("OUTER");
+            break;
+        }
+    }
+    join.joinType = joinType + " JOIN";
+    return expectKeyword("JOIN") && expectIdentifier(join.table) && expectKeyword("ON")
+        && parseColumnRef(join.left) && expectSymbol("=") && parseColumnRef(join.right);
+}
+
+bool SqlParser::parseWhere(std::unique_ptr<WhereExpr>& where) {
+    if (!acceptKeyword("WHERE")) {
+        return true;
+    }
+    where = parseOr();
+    return where != nullptr;
+}
+
+std::unique_ptr<WhereExpr> SqlParser::parseOr() {
+    std::unique_ptr<WhereExpr> left = parseAnd();
+    while (left && acceptKeyword("OR")) {
+        std::unique_ptr<WhereExpr> right = parseAnd();
+        if (!right) {
+            return nullptr;
+        }
+        auto node = std::make_unique<WhereExpr>();
+        node->kind = WhereExpr::Kind::OR;
+        node->left = std::move(left);
+        node->right = std::move(right);
+        left = std::move(node);
+    }
+    return left;
+}
+
+std::unique_ptr<WhereExpr> SqlParser::parseAnd() {
+    std::unique_ptr<WhereExpr> left = parseUnary();
+    while (left && acceptKeyword("AND")) {
+        std::unique_ptr<WhereExpr> right = parseUnary();
+        if (!right) {
+            return nullptr;
+        }
+        auto node = std::make_unique<WhereExpr>();
+        node->kind = WhereExpr::Kind::AND;
+        node->left = std::move(left);
+        node->right = std::move(right);
+        left = std::move(node);
+    }
+    return left;
+}
+
+std::unique_ptr<WhereExpr> SqlParser::parseUnary() {
+    if (acceptKeyword("NOT")) {
+        std::unique_ptr<WhereExpr> operand = parseUnary();
+        if (!operand) {
+            return nullptr;
+        }
+        auto node = std::make_unique<WhereExpr>();
+        node->kind = WhereExpr::Kind::NOT;
+        node->left = std::move(operand);
+        return node;
+    }
+    if (acceptSymbol("(")) {
+        std::unique_ptr<WhereExpr> inner = parseOr();
+        if (!inner || !expectSymbol(")")) {
+            return nullptr;
+        }
+        return inner;
+    }
+    return parseComparison();
+}
+
+std::unique_ptr<WhereExpr> SqlParser::parseComparison() {
+    auto node = std::make_unique<WhereExpr>();
+    if (!parseColumnRef(node->column)) {
+        return nullptr;
+    }
+    if (peek().type != SqlTokenType::SYMBOL || !isComparisonOperator(peek().text)) {
+        fail("expected a comparison operator but found " + describe(peek()));
+        return nullptr;
+    }
+    node->op = std::string(peek().text);
+    ++position;
+    // A bare name on the right would be a column, and columns can only be compared with values.
+    if (peek().type == SqlTokenType::IDENTIFIER) {
+        fail("expected a value but found column " + describe(peek()) + "; text values must be quoted");
+        return nullptr;
+    }
+    if (!parseLiteral(node->literal)) {
+        return nullptr;
+    }
+    return node;
+}
+
+bool SqlParser::parseSelect(SelectStatement& statement) {
+    do {
+        ColumnRef column;
+        if (!parseColumnRef(column)) {
+            return false;
+        }
+        statement.columns.push_back(std::move(column));
+        acceptSymbol(",");
+    } while (!atKeyword("FROM") && peek().type != SqlTokenType::END);
+
+    if (!expectKeyword("FROM") || !expectIdentifier(statement.table)) {
+        return false;
+    }
+
+    while (atKeyword("JOIN") || atKeyword("INNER") || atKeyword("LEFT") || atKeyword("RIGHT") || atKeyword("FULL")) {
+        JoinClause join;
+        if (!parseJoin(join)) {
+            return false;
+        }
+        statement.joins.push_back(std::move(join));
+    }
+
+    if (!parseWhere(statement.where)) {
+        return false;
+    }
+
+    if (acceptKeyword("ORDER")) {
+        if (!expectKeyword("BY")) {
+            return false;
+        }
+        do {
+            OrderItem item;
+            if (!parseColumnRef(item.column)) {
+                return false;
+            }
+            if (acceptKeyword("DESC")) {
+                item.descending = true;
+            } else {
+                acceptKeyword("ASC");
+            }
+            statement.orderBy.push_back(std::move(item));
+            acceptSymbol(",");
+        } while (peek().type == SqlTokenType::IDENTIFIER && !atKeyword("LIMIT") && !atKeyword("INTO"));
+    }
+
+    if (acceptKeyword("LIMIT")) {
+        if (peek().type == SqlTokenType::PARAMETER) {
+            if (!parsePlaceholder(statement.limitParameter)) {
+                return false;
+            }
+        } else {
+            const SqlToken& token = peek();
+            auto [end, ec] = std::from_chars(token.text.data(), token.text.data() + token.text.size(), statement.limit);
+            if (token.type != SqlTokenType::NUMBER || ec != std::errc() || end != token.text.data() + token.text.size()) {
+                return fail("expected a row count after LIMIT but found " + describe(token));
+            }
+            ++position;
+        }
+    }
+
+    if (acceptKeyword("INTO")) {
+        if (!expectKeyword("OUTFILE")) {
+            return false;
+        }
+        statement.intoOutfile = true;
+        if (peek().type == SqlTokenType::PARAMETER) {
+            if (!parsePlaceholder(statement.outfile.parameter)) {
+                return false;
+            }
+        } else if (peek().type == SqlTokenType::STRING) {
+            statement.outfile.text = std::string(peek().text);
+            statement.outfile.quote = peek().quote;
+            ++position;
+        } else {
+            return fail("expected a file name after OUTFILE but found " + describe(peek()));
+        }
+        if (acceptKeyword("FORMAT") && !expectIdentifier(statement.outfileFormat)) {
+            return false;
+        }
+    }
+
+    return expectEnd();
+}
+
+bool SqlParser::parseValueList(std::vector<Literal>& values) {
+    if (!expectSymbol("(")) {
+        return false;
+    }
+    do {
+        Literal value;
+        if (!parseLiteral(value)) {
+            return false;
+        }
+        values.push_back(std::move(value));
+        acceptSymbol(",");
+    } while (!atSymbol(")") && peek().type != SqlTokenType::END);
+    return expectSymbol(")");
+}
+
+// Double quotes around a column name are dropped, as they always were for INSERT.
+bool SqlParser::parseInsert(InsertStatement& statement) {
+    if (!expectKeyword("INTO") || !expectIdentifier(statement.table) || !expectSymbol("(")) {
+        return false;
+    }
+    do {
+        if (peek().type == SqlTokenType::STRING && peek().quote == '"') {
+            statement.columns.emplace_back(peek().text);
+            ++position;
+        } else {
+            std::string column;
+            if (!expectIdentifier(column)) {
+                return false;
+            }
+            statement.columns.push_back(std::move(column));
+        }
+        acceptSymbol(",");
+    } while (!atSymbol(")") && peek().type != SqlTokenType::END);
+
+    if (!expectSymbol(")") || !expectKeyword("VALUES")) {
+        return false;
+    }
+    do {
+        std::vector<Literal> values;
+        if (!parseValueList(values)) {
+            return false;
+        }
+        statement.rows.push_back(std::move(values));
+        acceptSymbol(",");
+    } while (atSymbol("("));
+    return expectEnd();
+}
+
+bool SqlParser::parseUpdate(UpdateStatement& statement) {
+    if (!expectIdentifier(statement.table) || !expectKeyword("SET")) {
+        return false;
+    }
+    do {
+        Assignment assignment;
+        if (!expectIdentifier(assignment.column) || !expectSymbol("=") || !parseLiteral(assignment.value)) {
+            return false;
+        }
+        statement.assignments.push_back(std::move(assignment));
+        acceptSymbol(",");
+    } while (peek().type == SqlTokenType::IDENTIFIER && !atKeyword("WHERE"));
+
+    return parseWhere(statement.where) && expectEnd();
+}
+
+bool SqlParser::parseDelete(DeleteStatement& statement) {
+    return expectKeyword("FROM") && expectIdentifier(statement.table) && parseWhere(statement.where) && expectEnd();
+}
+
+bool SqlParser::parse(Statement::Kind kind, Statement& statement) {
+    statement.kind = kind;
+    bool parsed = false;
+    switch (kind) {
+        case Statement::Kind::SELECT: parsed = parseSelect(statement.select); break;
+        case Statement::Kind::INSERT: parsed = parseInsert(statement.insert); break;
+        case Statement::Kind::UPDATE: parsed = parseUpdate(statement.update); break;
+        case Statement::Kind::DELETE: parsed = parseDelete(statement.remove); break;
+    }
+    statement.parameterCount = parameters;
+    return parsed;
+}
+
+bool SqlParser::parseStatement(Statement& statement) {
+    if (acceptKeyword("SELECT")) {
+        return parse(Statement::Kind::SELECT, statement);
+    }
+    if (acceptKeyword("INSERT")) {
+        return parse(Statement::Kind::INSERT, statement);
+    }
+    if (acceptKeyword("UPDATE")) {
+        return parse(Statement::Kind::UPDATE, statement);
+    }
+    if (acceptKeyword("DELETE")) {
+        return parse(Statement::Kind::DELETE, statement);
+    }
+    return fail("expected SELECT, INSERT, UPDATE or DELETE but found " + describe(peek()));
+}
+
+bool SqlParser::parsePrepare(std::string& name, Statement& statement) {
+    return expectIdentifier(name) && expectKeyword("AS") && parseStatement(statement);
+}
+
+bool SqlParser::parseValues(std::vector<Literal>& values) {
+    if (peek().type == SqlTokenType::END) {
+        return true;
+    }
+    if (!parseValueList(values)) {
+        return false;
+    }
+    if (parameters > 0) {
+        return fail("placeholders cannot be used as values");
+    }
+    return expectEnd();
+}
+
+std::string joinArguments(const std::vector<std::string>& args) {
+    std::string text;
+    for (const auto& arg : args) {
+        if (!text.empty()) {
+            text += ' ';
+        }
+        text += arg;
+    }
+    return text;
+}
+
+namespace {
+
+// Appends to out, so nested conditions are written into one string instead of concatenating
+// temporaries.
+void appendWhere(const WhereExpr& expr, std::string& out) {
+    switch (expr.kind) {
+        case WhereExpr::Kind::AND:
+        case WhereExpr::Kind::OR:
+            out += '(';
+            appendWhere(*expr.left, out);
+            out += expr.kind == WhereExpr::Kind::AND ? " AND " : " OR ";
+            appendWhere(*expr.right, out);
+            out += ')';
+            return;
+        case WhereExpr::Kind::NOT:
+            out += "NOT ";
+            appendWhere(*expr.left, out);
+            return;
+        case WhereExpr::Kind::COMPARISON:
+            break;
+    }
+    if (!expr.column.table.empty()) {
+        out += expr.column.table;
+        out += '.';
+    }
+    out += expr.column.column;
+    out += ' ';
+    out += expr.op;
+    out += ' ';
+    if (expr.literal.parameter >= 0) {
+        out += '$';
+        out += std::to_string(expr.literal.parameter + 1);
+    } else {
+        out += expr.literal.text;
+    }
+}
+
+}
+
+std::string whereToString(const WhereExpr& expr) {
+    std::string text;
+    appendWhere(expr, text);
+    return text;
+}
@@ -0,0 +1,94 @@
+#ifndef SQL_PARSER_H
+#define SQL_PARSER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "parser/lexer.h"
+#include "parser/ast.h"
+
+// Recursive-descent parser over Lexer::scanSql tokens. Each parse method reads the statement
+// that follows its keyword (the command name the REPL already matched) up to an optional ';'.
+// Keywords are case-insensitive. The REPL drops commas between arguments, so commas in the
+// select list, SET list and ORDER BY list are optional.
+//
+//   select     := columns FROM name join* [WHERE expr] [ORDER BY order (',' order)*] [LIMIT count]
+//                 [INTO OUTFILE (string | placeholder) [FORMAT name]]
+//   columns    := '*' | column (',' column)*
+//   join       := [INNER | LEFT | RIGHT | FULL] [OUTER] JOIN name ON column '=' column
+//   insert     := INTO name '(' field (',' field)* ')' VALUES tuple (',' tuple)*
+//   tuple      := '(' literal (',' literal)* ')'
+//   update     := name SET name '=' literal (',' name '=' literal)* [WHERE expr]
+//   delete     := FROM name [WHERE expr]
+//   expr       := and (OR and)*
+//   and        := unary (AND unary)*
+//   unary      := NOT unary | '(' expr ')' | column op literal
+//   column     := name ['.' (name | '*')]
+//   field      := name | string
+//   literal    := string | ['-' | '+'] number | name | placeholder
+//   count      := number | placeholder
+//   placeholder:= '?' | '$' number
+//   prepare    := name AS (SELECT select | INSERT insert | UPDATE update | DELETE delete)
+//   values     := [tuple]
+//
+// '$n' is the n-th parameter and '?' the one after the highest referred to so far.
+class SqlParser {
+public:
+    // The parser keeps its own copy of the text; the tokens point into it.
+    explicit SqlParser(std::string sql);
+
+    bool parseSelect(SelectStatement& statement);
+    bool parseInsert(InsertStatement& statement);
+    bool parseUpdate(UpdateStatement& statement);
+    bool parseDelete(DeleteStatement& statement);
+    // The statement that follows the keyword of the given kind.
+    bool parse(Statement::Kind kind, Statement& statement);
+    // A statement that starts with its SELECT, INSERT, UPDATE or DELETE keyword.
+    bool parseStatement(Statement& statement);
+    // name AS statement, as given to PREPARE.
+    bool parsePrepare(std::string& name, Statement& statement);
+    // A parenthesised list of values, as given to EXECUTE; an empty input is an empty list.
+    bool parseValues(std::vector<Literal>& values);
+
+    // Number of parameters the placeholders seen so far refer to.
+    size_t parameterCount() const { return parameters; }
+
+    // Describes the first syntax error.
+    const std::string& error() const { return errorMessage; }
+
+private:
+    const SqlToken& peek() const { return tokens[position]; }
+    bool atKeyword(std::string_view keyword) const;
+    bool atSymbol(std::string_view symbol) const;
+    bool acceptKeyword(std::string_view keyword);
+    bool acceptSymbol(std::string_view symbol);
+    bool expectKeyword(std::string_view keyword);
+    bool expectSymbol(std::string_view symbol);
+    bool expectIdentifier(std::string& name);
+    bool expectEnd();
+    bool fail(const std::string& message);
+
+    bool parseColumnRef(ColumnRef& column);
+    bool parseLiteral(Literal& literal);
+    bool parsePlaceholder(int& parameter);
+    bool parseValueList(std::vector<Literal>& values);
+    bool parseJoin(JoinClause& join);
+    bool parseWhere(std::unique_ptr<WhereExpr>& where);
+    std::unique_ptr<WhereExpr> parseOr();
+    std::unique_ptr<WhereExpr> parseAnd();
+    std::unique_ptr<WhereExpr> parseUnary();
+    std::unique_ptr<WhereExpr> parseComparison();
+
+    std::string text;
+    std::vector<SqlToken> tokens;
+    size_t position = 0;
+    size_t parameters = 0;
+    std::string errorMessage;
+};
+
+// Joins command arguments back into statement text for the parser.
+std::string joinArguments(const std::vector<std::string>& args);
+// Renders a WHERE expression back as SQL, for messages.
+std::string whereToString(const WhereExpr& expr);
+
+#endif
@@ -21,13 +21,15 @@ public:
     void suggestCommands(const std::string& input);
     void processStartupCommands(const std::vector<std::string>& args);
     void setSaveExecutionDetails(bool saveDetails);
+    // Runs one statement: finds its command and executes it with the remaining tokens.
+    // False when there is no such command or the command failed.
+    bool processCommand(const std::string& input);
 
 private:
     CommandFactory& commandFactory;
     std::string& currentUser;
     std::string& currentDatabase;
     bool saveExecutionDetails = false;
-    void processCommand(const std::string& input);
     std::vector<std::string> tokenize(const std::string& input);
     std::string getPrompt() const;
     std::string getUserPrompt() const;
@@ -1,5 +1,6 @@
 #include "headers/repl.h"
 #include "utils.h"
+#include "parser/lexer.h"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
@@ -8,7 +9,6 @@
 #include <cctype>
 #include <iterator>
 #include <limits>
-#include <regex>
 #include <chrono>
 #include <fstream>
 
@@ -64,36 +64,25 @@ void Repl::start() {
     }
 }
 
-void Repl::processCommand(const std::string& input) {
+bool Repl::processCommand(const std::string& input) {
     auto start = std::chrono::high_resolution_clock::now();
 
     std::vector<std::string> tokens = tokenize(input);
     if (tokens.empty()) {
         std::cout << "No command entered." << std::endl;
-        return;
+        return true;
     }
 
     std::string commandName;
-    std::vector<std::string> args;
-
-    for (size_t i = 0; i < tokens.size(); ++i) {
-        std::string possibleCommand = joinTokens(tokens, 0, i + 1);
-        if (commandFactory.getCommand(possibleCommand)) {
-            commandName = possibleCommand;
-            args = std::vector<std::string>(tokens.begin() + i + 1, tokens.end());
-            break;
-        }
-    }
+    size_t consumed = 0;
+    auto command = commandFactory.findCommand(tokens, consumed, commandName);
 
-    if (commandName.empty()) {
+    bool succeeded = false;
+    if (!command) {
         suggestCommands(tokens[0]);
     } else {
-        auto command = commandFactory.getCommand(commandName);
-        if (command) {
-            command->execute(args);
-        } else {
-            std::cout << "Command not found: " << commandName << std::endl;
-        }
+        std::vector<std::string> args(std::make_move_iterator(tokens.begin() + consumed), std::make_move_iterator(tokens.end()));
+        succeeded = command->execute(args);
     }
 
     auto end = std::chrono::high_resolution_clock::now();
@@ -102,6 +91,7 @@ void Repl::processCommand(const std::string& input) {
     if (saveExecutionDetails) {
         saveExecutionDetailsToFile(commandName, duration);
     }
+    return succeeded;
 }
 
 void Repl::saveExecutionDetailsToFile(const std::string& commandName, std::chrono::duration<double> duration) {
@@ -116,15 +106,9 @@ void Repl::saveExecutionDetailsToFile(const std::string& commandName, std::chron
 
 std::vector<std::string> Repl::tokenize(const std::string& input) {
     std::vector<std::string> tokens;
-    std::regex tokenRegex(R"(([^()\s,]+)|(\([^)]*\))|(\s*".*?")|(\s*'.*?'))");
-    auto wordsBegin = std::sregex_iterator(input.begin(), input.end(), tokenRegex);
-    auto wordsEnd = std::sregex_iterator();
-
-    for (std::sregex_iterator i = wordsBegin; i != wordsEnd; ++i) {
-        std::smatch match = *i;
-        tokens.push_back(match.str());
+    for (std::string_view token : Lexer::tokenize(input)) {
+        tokens.emplace_back(token);
     }
-
     return tokens;
 }
 
@@ -0,0 +1,339 @@
+#include "server/server.h"
+#include "server/wireProtocol.h"
+#include <iostream>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <atomic>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace {
+
+constexpr int MAX_EVENTS = 64;
+constexpr size_t READ_SIZE = 64 * 1024;
+// Longest text line a client may send, and the most one read takes from a socket.
+constexpr size_t MAX_LINE = 16 * 1024 * 1024;
+constexpr int WRITE_TIMEOUT_MS = 30 * 1000;
+
+std::atomic<bool> stopRequested{false};
+
+void requestStop(int) {
+    stopRequested = true;
+}
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// The socket is non-blocking for the event loop, so a full send buffer is waited out here,
+// for at most WRITE_TIMEOUT_MS at a time: results are sent while their statement runs, so a
+// client that stops reading would otherwise hold up the statements of other sessions.
+bool writeAll(int fd, std::string_view data) {
+    while (!data.empty()) {
+        ssize_t written = send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (written > 0) {
+            data.remove_prefix(static_cast<size_t>(written));
+        } else if (written < 0 && errno == EINTR) {
+            continue;
+        } else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            pollfd waiter{fd, POLLOUT, 0};
+            int ready = poll(&waiter, 1, WRITE_TIMEOUT_MS);
+            if (ready == 0 || (ready < 0 && errno != EINTR)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+Server::Server(size_t workerCount, Session::Protocol protocol) : protocol(protocol), pool(std::max<size_t>(1, workerCount)) {}
+
+Server::~Server() {
+    if (listenFd >= 0) {
+        close(listenFd);
+    }
+    if (epollFd >= 0) {
+        close(epollFd);
+    }
+    if (!unixPath.empty()) {
+        unlink(unixPath.c_str());
+    }
+}
+
+bool Server::listen(const std::string& address) {
+    bool listening = false;
+    if (address.starts_with("unix:")) {
+        listening = listenUnix(address.substr(5));
+    } else if (address.starts_with("tcp:")) {
+        listening = listenTcp(address.substr(4));
+    } else {
+        std::cerr << "Error: Unknown server address '" << address << "'. Use unix:<path> or tcp:[<host>:]<port>." << std::endl;
+        return false;
+    }
+    if (!listening) {
+        return false;
+    }
+    if (::listen(listenFd, SOMAXCONN) < 0 || !setNonBlocking(listenFd)) {
+        std::cerr << "Error: Failed to listen on '" << address << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    std::cout << "Listening on " << address << std::endl;
+    return true;
+}
+
+bool Server::listenUnix(const std::string& path) {
+    sockaddr_un socketAddress{};
+    if (path.empty() || path.size() >= sizeof(socketAddress.sun_path)) {
+        std::cerr << "Error: Invalid socket path '" << path << "'." << std::endl;
+        return false;
+    }
+    socketAddress.sun_family = AF_UNIX;
+    std::memcpy(socketAddress.sun_path, path.c_str(), path.size() + 1);
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if (listenFd < 0 || bind(listenFd, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) < 0) {
+        std::cerr << "Error: Failed to bind socket '" << path << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    unixPath = path;
+    return true;
+}
+
+bool Server::listenTcp(const std::string& hostPort) {
+    size_t colon = hostPort.rfind(':');
+    std::string host = colon == std::string::npos ? "" : hostPort.substr(0, colon);
+    std::string port = colon == std::string::npos ? hostPort : hostPort.substr(colon + 1);
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo* addresses = nullptr;
+    int error = getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &addresses);
+    if (error != 0) {
+        std::cerr << "Error: Invalid address '" << hostPort << "': " << gai_strerror(error) << std::endl;
+        return false;
+    }
+    for (addrinfo* address = addresses; address; address = address->ai_next) {
+        listenFd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (listenFd < 0) {
+            continue;
+        }
+        int reuse = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (bind(listenFd, address->ai_addr, address->ai_addrlen) == 0) {
+            break;
+        }
+        close(listenFd);
+        listenFd = -1;
+    }
+    freeaddrinfo(addresses);
+    if (listenFd < 0) {
+        std::cerr << "Error: Failed to bind to '" << hostPort << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Server::run() {
+    epollFd = epoll_create1(0);
+    epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = listenFd;
+    if (epollFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &listenEvent) < 0) {
+        std::cerr << "Error: Failed to start the event loop: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Without SA_RESTART a signal interrupts epoll_wait, which ends the loop.
+    struct sigaction action{};
+    action.sa_handler = requestStop;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    epoll_event events[MAX_EVENTS];
+    while (!stopRequested) {
+        int count = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Error: epoll_wait failed: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        for (int i = 0; i < count; ++i) {
+            if (events[i].data.fd == listenFd) {
+                acceptClients();
+                continue;
+            }
+            auto it = sessions.find(events[i].data.fd);
+            if (it != sessions.end()) {
+                readClient(it->second);
+            }
+        }
+    }
+
+    std::cout << "Shutting down, " << sessions.size() << " client(s) connected." << std::endl;
+    for (auto& [fd, session] : sessions) {
+        shutdown(fd, SHUT_RDWR);
+    }
+    while (!sessions.empty()) {
+        dropClient(sessions.begin()->second, false);
+    }
+    return true;
+}
+
+void Server::acceptClients() {
+    for (;;) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "Error: accept failed: " << std::strerror(errno) << std::endl;
+            }
+            return;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (!setNonBlocking(fd) || epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+
+        // The greeting counts as the first response; lines that arrive meanwhile are
+        // served by the same worker right after it. Binary clients get no greeting.
+        auto session = std::make_shared<Session>(fd, protocol);
+        sessions[fd] = session;
+        if (protocol == Session::Protocol::TEXT) {
+            session->busy = true;
+            pool.submit([this, session] {
+                writeAll(session->fd, session->prompt());
+                serve(session);
+            });
+        }
+    }
+}
+
+void Server::readClient(const std::shared_ptr<Session>& session) {
+    char buffer[READ_SIZE];
+    bool endOfInput = false;
+    bool failed = false;
+    std::string received;
+    // Epoll is level triggered, so what is left after MAX_LINE bytes is read on the next wait.
+    while (received.size() < MAX_LINE) {
+        ssize_t count = recv(session->fd, buffer, sizeof(buffer), 0);
+        if (count > 0) {
+            received.append(buffer, static_cast<size_t>(count));
+            continue;
+        }
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        endOfInput = count == 0;
+        failed = count < 0 && errno != EAGAIN && errno != EWOULDBLOCK;
+        break;
+    }
+
+    bool start = false;
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->input += received;
+        if (session->protocol == Session::Protocol::BINARY) {
+            // A malformed frame leaves no way to find the next one.
+            if (!WireProtocol::takeRequests(session->input, session->pending)) {
+                failed = true;
+            }
+        } else {
+            size_t begin = 0;
+            size_t end;
+            while ((end = session->input.find('\n', begin)) != std::string::npos) {
+                session->pending.emplace_back(session->input, begin, end - begin);
+                begin = end + 1;
+            }
+            session->input.erase(0, begin);
+            if (session->input.size() > MAX_LINE) {
+                failed = true;
+            }
+        }
+        // Text after the last newline is a line of its own; an incomplete frame is dropped.
+        if (endOfInput) {
+            if (session->protocol == Session::Protocol::TEXT && !session->input.empty()) {
+                session->pending.push_back(std::move(session->input));
+            }
+            session->input.clear();
+        }
+        if (!failed && !session->busy && !session->pending.empty() && !session->quit) {
+            session->busy = start = true;
+        }
+    }
+    if (start) {
+        pool.submit([this, session] { serve(session); });
+    }
+    if (failed || endOfInput) {
+        dropClient(session, !failed);
+    }
+}
+
+// The descriptor is closed by whoever lets go of the session last, the loop or its worker,
+// so a worker never writes to a descriptor number that was reused for a new client. A
+// session that ends with the client's EOF (finish) still runs and answers what it has queued.
+void Server::dropClient(const std::shared_ptr<Session>& session, bool finish) {
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, session->fd, nullptr);
+    sessions.erase(session->fd);
+    std::lock_guard<std::mutex> lock(session->mutex);
+    if (finish) {
+        session->ended = true;
+    } else {
+        session->closed = true;
+    }
+    if (!session->busy) {
+        close(session->fd);
+    }
+}
+
+void Server::serve(const std::shared_ptr<Session>& session) {
+    for (;;) {
+        std::string line;
+        {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            if (session->pending.empty() || session->closed || session->quit) {
+                session->busy = false;
+                if (session->closed || session->ended) {
+                    close(session->fd);
+                } else if (session->quit) {
+                    shutdown(session->fd, SHUT_RDWR);
+                }
+                return;
+            }
+            line = std::move(session->pending.front());
+            session->pending.pop_front();
+        }
+        bool written;
+        if (session->protocol == Session::Protocol::BINARY) {
+            written = session->executeRequest(line, [&session](std::string_view frames) { return writeAll(session->fd, frames); });
+        } else {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            written = writeAll(session->fd, session->execute(line));
+        }
+        // The client is gone or stopped reading: what it still queued is dropped, and the
+        // event loop sees the connection end.
+        if (!written) {
+            std::lock_guard<std::mutex> lock(session->mutex);
+            session->pending.clear();
+            shutdown(session->fd, SHUT_RDWR);
+        }
+    }
+}
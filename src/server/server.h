@@ -0,0 +1,49 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include "server/session.h"
+#include "server/threadPool.h"
+#include "commands/outputCapture.h"
+
+// Serves the command language to many clients over a Unix or TCP stream socket. One thread
+// runs an epoll loop that accepts connections and reads requests; complete lines are queued
+// on the client's Session and run by a worker of the pool, which writes the response back.
+//
+// The text protocol is the REPL's: the client sends command lines ending in '\n' and
+// receives what the commands print, followed by the session prompt once the line is done.
+// The binary protocol (WireProtocol) sends length-prefixed requests and answers SELECTs
+// with typed column batches, for clients that pipeline many small statements.
+class Server {
+public:
+    Server(size_t workerCount, Session::Protocol protocol);
+    ~Server();
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // address is unix:<path> or tcp:[<host>:]<port>.
+    bool listen(const std::string& address);
+    // Runs until SIGINT or SIGTERM; false when the event loop failed.
+    bool run();
+
+private:
+    bool listenUnix(const std::string& path);
+    bool listenTcp(const std::string& hostPort);
+    void acceptClients();
+    void readClient(const std::shared_ptr<Session>& session);
+    void dropClient(const std::shared_ptr<Session>& session, bool finish);
+    void serve(const std::shared_ptr<Session>& session);
+
+    int listenFd = -1;
+    int epollFd = -1;
+    std::string unixPath;
+    std::unordered_map<int, std::shared_ptr<Session>> sessions;
+    Session::Protocol protocol;
+    // Declared before the pool, so the streams are routed until its workers have finished.
+    OutputCapture::Routing routing;
+    ThreadPool pool;
+};
+
+#endif
@@ -0,0 +1,82 @@
+#include "server/session.h"
+#include "commands/outputCapture.h"
+#include "server/wireProtocol.h"
+#include "commands/executionLock.h"
+#include "parser/lexer.h"
+
+Session::Session(int fd, Protocol protocol) : fd(fd), protocol(protocol) {}
+
+bool Session::runStatements(const std::string& line, std::string& output) {
+    if (!factory) {
+        factory = std::make_unique<CommandFactory>(currentUser, currentDatabase);
+        repl = std::make_unique<Repl>(*factory, currentUser, currentDatabase);
+    }
+
+    bool succeeded = true;
+    for (std::string_view piece : Lexer::splitTopLevel(line, ';')) {
+        if (quit) {
+            break;
+        }
+        if (piece.empty()) {
+            continue;
+        }
+        std::string statement(piece);
+
+        // .exit would end the whole server; for a client it ends the connection.
+        std::vector<std::string> tokens;
+        for (std::string_view token : Lexer::tokenize(statement)) {
+            tokens.emplace_back(token);
+        }
+        size_t consumed = 0;
+        std::string commandName;
+        if (factory->findCommand(tokens, consumed, commandName) && commandName == ".exit") {
+            output += "Exiting...\n";
+            quit = true;
+            break;
+        }
+
+        OutputCapture capture(output);
+        ExecutionLock lock(commandName, currentDatabase);
+        if (!repl->processCommand(statement)) {
+            succeeded = false;
+        }
+    }
+    return succeeded;
+}
+
+std::string Session::execute(const std::string& line) {
+    std::string output;
+    runStatements(line, output);
+    if (!quit) {
+        output += prompt();
+    }
+    return output;
+}
+
+// SELECT results go to the client as column batches while they are read; the printed text
+// travels in DONE.
+bool Session::executeRequest(const std::string& request, const BatchEncoder::Writer& write) {
+    std::string message;
+    bool succeeded = false;
+    if (static_cast<std::uint8_t>(request[0]) != static_cast<std::uint8_t>(WireProtocol::RequestType::QUERY)) {
+        message = "Error: Unknown request type " + std::to_string(static_cast<std::uint8_t>(request[0])) + ".\n";
+    } else {
+        BatchEncoder encoder(write);
+        ResultSink::Scope scope(encoder);
+        succeeded = runStatements(request.substr(1), message);
+    }
+    std::string done;
+    WireProtocol::appendDone(done, succeeded ? WireProtocol::Status::OK : WireProtocol::Status::ERROR, message);
+    return write(done);
+}
+
+std::string Session::prompt() const {
+    std::string prompt;
+    if (!currentUser.empty()) {
+        prompt += "[" + currentUser + "]";
+    }
+    if (!currentDatabase.empty()) {
+        prompt += (currentUser.empty() ? "(" : "::(") + currentDatabase + ")";
+    }
+    return prompt + "> ";
+}
@@ -0,0 +1,58 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include "commandFactory/headers/commandFactory.h"
+#include "repl/headers/repl.h"
+#include "server/wireProtocol.h"
+
+// One client connection of the server. A session has its own user, database, cached
+// permissions and prepared statements, held by a CommandFactory of its own, exactly as the
+// REPL keeps them for its single user. The factory is built by the first worker that runs a
+// request of the session, not by the event loop that accepts it.
+//
+// The event loop appends complete input lines to pending; one worker at a time drains them
+// (busy), so the statements of a session run in the order they were sent. With the binary
+// protocol the pending entries are request frames instead (see WireProtocol).
+class Session {
+public:
+    enum class Protocol {
+        TEXT,
+        BINARY
+    };
+
+    Session(int fd, Protocol protocol);
+
+    // Runs one input line as the REPL would, statements separated by ';', and returns
+    // everything the commands printed followed by the prompt. quit is set by .exit.
+    std::string execute(const std::string& line);
+    // Runs one binary request and sends its response frames with write as they are made;
+    // false when the client could not be written to.
+    bool executeRequest(const std::string& request, const BatchEncoder::Writer& write);
+    std::string prompt() const;
+
+    const int fd;
+    const Protocol protocol;
+    std::mutex mutex;
+    std::string input;                  // bytes after the last complete line or frame
+    std::deque<std::string> pending;    // lines or requests waiting for a worker
+    bool busy = false;
+    bool closed = false;                // the event loop has dropped the connection
+    bool ended = false;                 // the client sent EOF; pending is run, then the connection closed
+    std::atomic<bool> quit = false;
+
+private:
+    // Appends what the statements print to output; false when any of them failed.
+    bool runStatements(const std::string& line, std::string& output);
+
+    std::string currentUser;
+    std::string currentDatabase;
+    std::unique_ptr<CommandFactory> factory;
+    std::unique_ptr<Repl> repl;
+};
+
+#endif
@@ -0,0 +1,152 @@
+#include "server/wireProtocol.h"
+#include <iostream>
+#include <type_traits>
+
+namespace {
+
+// Byte by byte, so frames are little endian whatever the host is.
+template <typename T>
+void appendInteger(std::string& out, T value) {
+    auto bits = static_cast<std::make_unsigned_t<T>>(value);
+    for (size_t shift = 0; shift < sizeof(T) * 8; shift += 8) {
+        out.push_back(static_cast<char>((bits >> shift) & 0xFF));
+    }
+}
+
+std::uint32_t readLength(const char* data) {
+    std::uint32_t length = 0;
+    for (size_t i = sizeof(length); i-- > 0;) {
+        length = (length << 8) | static_cast<unsigned char>(data[i]);
+    }
+    return length;
+}
+
+void appendString(std::string& out, std::string_view text) {
+    appendInteger<std::uint32_t>(out, static_cast<std::uint32_t>(text.size()));
+    out.append(text);
+}
+
+// Starts a frame with a zero length, which endFrame fills in once the payload is written.
+size_t beginFrame(std::string& out, WireProtocol::ResponseType type) {
+    size_t start = out.size();
+    appendInteger<std::uint32_t>(out, 0);
+    appendInteger<std::uint8_t>(out, static_cast<std::uint8_t>(type));
+    return start;
+}
+
+void endFrame(std::string& out, size_t start) {
+    std::uint32_t length = static_cast<std::uint32_t>(out.size() - start - sizeof(std::uint32_t));
+    for (size_t i = 0; i < sizeof(length); ++i) {
+        out[start + i] = static_cast<char>((length >> (i * 8)) & 0xFF);
+    }
+}
+
+}
+
+bool WireProtocol::takeRequests(std::string& input, std::deque<std::string>& requests) {
+    size_t begin = 0;
+    bool valid = true;
+    while (input.size() - begin >= sizeof(std::uint32_t)) {
+        std::uint32_t length = readLength(input.data() + begin);
+        if (length == 0 || length > MAX_REQUEST) {
+            valid = false;
+            break;
+        }
+        if (input.size() - begin - sizeof(length) < length) {
+            break;
+        }
+        requests.emplace_back(input, begin + sizeof(length), length);
+        begin += sizeof(length) + length;
+    }
+    input.erase(0, begin);
+    return valid;
+}
+
+void WireProtocol::appendDone(std::string& out, Status status, std::string_view message) {
+    size_t frame = beginFrame(out, ResponseType::DONE);
+    appendInteger<std::uint8_t>(out, static_cast<std::uint8_t>(status));
+    out.append(message);
+    endFrame(out, frame);
+}
+
+void BatchEncoder::begin(const std::vector<ResultColumn>& columns) {
+    this->columns = columns;
+    presence.assign(columns.size(), std::string());
+    values.assign(columns.size(), std::string());
+    rows = 0;
+
+    size_t frame = beginFrame(out, WireProtocol::ResponseType::COLUMNS);
+    appendInteger<std::uint32_t>(out, static_cast<std::uint32_t>(columns.size()));
+    for (const auto& column : columns) {
+        appendString(out, column.name);
+        appendInteger<std::uint8_t>(out, static_cast<std::uint8_t>(column.type));
+    }
+    endFrame(out, frame);
+    send();
+}
+
+bool BatchEncoder::addRow(const json& row) {
+    if (failed) {
+        std::cerr << "Error: Failed to send the result to the client." << std::endl;
+        return false;
+    }
+    for (const auto& column : columns) {
+        auto it = row.find(column.name);
+        if (column.type == ColumnarFormat::ColumnType::INT && it != row.end() && !it->is_null() && !it->is_number_integer()) {
+            std::cerr << "Error: Value " << it->dump() << " of column '" << column.name << "' is not an int." << std::endl;
+            return false;
+        }
+    }
+    if (rows % 8 == 0) {
+        for (auto& bits : presence) {
+            bits.push_back('\0');
+        }
+    }
+    for (size_t i = 0; i < columns.size(); ++i) {
+        auto it = row.find(columns[i].name);
+        if (it == row.end() || it->is_null()) {
+            continue;
+        }
+        if (columns[i].type == ColumnarFormat::ColumnType::INT) {
+            appendInteger<std::int64_t>(values[i], it->get<std::int64_t>());
+        } else if (it->is_string()) {
+            appendString(values[i], it->get_ref<const std::string&>());
+        } else {
+            appendString(values[i], it->dump());
+        }
+        presence[i].back() = static_cast<char>(presence[i].back() | (1 << (rows % 8)));
+    }
+    if (++rows == WireProtocol::BATCH_ROWS && !writeBatch()) {
+        std::cerr << "Error: Failed to send the result to the client." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void BatchEncoder::finish() {
+    if (rows > 0) {
+        writeBatch();
+    }
+}
+
+bool BatchEncoder::writeBatch() {
+    size_t frame = beginFrame(out, WireProtocol::ResponseType::BATCH);
+    appendInteger<std::uint32_t>(out, static_cast<std::uint32_t>(rows));
+    for (size_t i = 0; i < columns.size(); ++i) {
+        out += presence[i];
+        out += values[i];
+        presence[i].clear();
+        values[i].clear();
+    }
+    endFrame(out, frame);
+    rows = 0;
+    return send();
+}
+
+bool BatchEncoder::send() {
+    if (!failed && !write(out)) {
+        failed = true;
+    }
+    out.clear();
+    return !failed;
+}
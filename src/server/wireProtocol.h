@@ -0,0 +1,80 @@
+#ifndef WIRE_PROTOCOL_H
+#define WIRE_PROTOCOL_H
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "commands/resultSink.h"
+
+// The binary protocol of the server (--protocol binary). Integers are little endian, like
+// the columnar format, and every message is a frame:
+//   frame   : u32 length of what follows, u8 type, payload
+// Requests:
+//   QUERY   (1) : statement text; several statements may be separated by ';'
+// Responses come in request order, and each request ends with exactly one DONE:
+//   COLUMNS (1) : u32 column count, then per column str name, u8 type (ColumnarFormat::ColumnType)
+//   BATCH   (2) : u32 row count, then per column a presence bitmap of ceil(rows / 8) bytes
+//                 (bit set = value present) followed by the present values,
+//                 int -> i64, string/date -> str
+//   DONE    (3) : u8 status (0 ok, 1 error), then the text the statements printed
+// str is a u32 length followed by the bytes. A SELECT answers with COLUMNS and a BATCH per
+// BATCH_ROWS rows; other statements only print text. There is no prompt, and a client may
+// send any number of requests before reading the responses.
+namespace WireProtocol {
+
+constexpr std::uint32_t MAX_REQUEST = 16 * 1024 * 1024;
+constexpr size_t BATCH_ROWS = 1024;
+
+enum class RequestType : std::uint8_t {
+    QUERY = 1
+};
+
+enum class ResponseType : std::uint8_t {
+    COLUMNS = 1,
+    BATCH = 2,
+    DONE = 3
+};
+
+enum class Status : std::uint8_t {
+    OK = 0,
+    ERROR = 1
+};
+
+// Moves every complete frame at the front of input to requests, as its type byte followed
+// by the payload. False when a frame is empty or longer than MAX_REQUEST.
+bool takeRequests(std::string& input, std::deque<std::string>& requests);
+void appendDone(std::string& out, Status status, std::string_view message);
+
+}
+
+// Encodes SELECT results as COLUMNS and BATCH frames and hands each frame to write as soon as
+// it is complete, so a large result reaches the client while it is still being read.
+// Values are gathered column by column, so a batch is written as one run per column.
+class BatchEncoder : public ResultSink {
+public:
+    // Sends one frame; false when the client can no longer be written to.
+    using Writer = std::function<bool(std::string_view)>;
+
+    explicit BatchEncoder(Writer write) : write(std::move(write)) {}
+
+    void begin(const std::vector<ResultColumn>& columns) override;
+    bool addRow(const json& row) override;
+    void finish() override;
+
+private:
+    bool writeBatch();
+    bool send();
+
+    Writer write;
+    std::string out;
+    bool failed = false;
+    std::vector<ResultColumn> columns;
+    std::vector<std::string> presence;
+    std::vector<std::string> values;
+    size_t rows = 0;
+};
+
+#endif
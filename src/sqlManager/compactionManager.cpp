@@ -0,0 +1,152 @@
+#include "sqlManager/compactionManager.h"
+#include "sqlManager/sqlManager.h"
+#include "lockManager/lockManager.h"
+#include <chrono>
+#include <filesystem>
+
+CompactionManager& CompactionManager::getInstance() {
+    static CompactionManager instance;
+    return instance;
+}
+
+// The singletons the worker uses are constructed first, so they are destroyed after the
+// destructor below has joined the worker.
+CompactionManager::CompactionManager() {
+    SQLManager::getInstance();
+    BufferPool::getInstance();
+    LockManager::getInstance();
+}
+
+CompactionManager::~CompactionManager() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void CompactionManager::noteTombstones(const std::string& databaseName, const std::string& tableName, StorageFormat format, size_t tombstones, size_t liveRows) {
+    if (tombstones == 0 || static_cast<double>(tombstones) < threshold() * static_cast<double>(tombstones + liveRows)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& job : queue) {
+        if (job.databaseName == databaseName && job.tableName == tableName) {
+            return;
+        }
+    }
+    queue.push_back({databaseName, tableName, format});
+    if (!worker.joinable()) {
+        worker = std::thread(&CompactionManager::run, this);
+    }
+    wakeUp.notify_one();
+}
+
+bool CompactionManager::compactTable(const std::string& databaseName, const std::string& tableName, StorageFormat format, size_t& removed) {
+    INIT_SQL_MANAGER
+    removed = 0;
+    if (format == StorageFormat::COLUMNAR) {
+        return true;
+    }
+
+    if (format == StorageFormat::PAGED) {
+        PagedTable pagedTable(databaseName, tableName);
+        size_t erasedSlots = 0;
+        bool scanned = pagedTable.forEachPage([&erasedSlots](SlottedPage& page) {
+            erasedSlots += page.slotCount() - page.liveCount();
+            return false;
+        });
+        if (!scanned) {
+            return false;
+        }
+        if (erasedSlots == 0) {
+            return true;
+        }
+        json rows;
+        if (!pagedTable.load(rows) || !pagedTable.store(rows)) {
+            return false;
+        }
+        removed = erasedSlots;
+        return true;
+    }
+
+    json rows;
+    if (!sqlManager.readTableRows(databaseName, format, tableName, rows)) {
+        return false;
+    }
+    json liveRows = json::array();
+    for (auto& row : rows) {
+        if (row.is_null()) {
+            ++removed;
+        } else {
+            liveRows.push_back(std::move(row));
+        }
+    }
+    if (removed == 0) {
+        return true;
+    }
+    return sqlManager.writeTable(databaseName, format, {{"table_name", tableName}, {"rows", std::move(liveRows)}});
+}
+
+// Returns false when the database is locked and the job should be retried later.
+bool CompactionManager::runJob(const Job& job) {
+    if (!std::filesystem::exists(tableFilePath(job.databaseName, job.tableName, job.format))) {
+        return true;
+    }
+    if (!LockManager::getInstance().tryLock(job.databaseName, LockFileType::DATABASE, "compaction", "COMPACT " + job.tableName)) {
+        return false;
+    }
+    size_t removed = 0;
+    compactTable(job.databaseName, job.tableName, job.format, removed);
+    UNLOCK(job.databaseName, LockFileType::DATABASE);
+    return true;
+}
+
+void CompactionManager::run() {
+    using Seconds = std::chrono::duration<double>;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeUp.wait(lock, [this] { return stopping || !queue.empty(); });
+        if (stopping) {
+            return;
+        }
+        Job job = queue.front();
+        queue.pop_front();
+        lock.unlock();
+
+        std::error_code error;
+        auto fileSize = std::filesystem::file_size(tableFilePath(job.databaseName, job.tableName, job.format), error);
+        size_t bytes = error ? 0 : static_cast<size_t>(fileSize);
+        bool done = runJob(job);
+
+        lock.lock();
+        if (!done) {
+            queue.push_back(job);
+            wakeUp.wait_for(lock, std::chrono::seconds(1), [this] { return stopping; });
+            continue;
+        }
+        // Compacting reads the table and writes it back, so about twice its size goes through the disk.
+        Seconds pause(2.0 * static_cast<double>(bytes) / static_cast<double>(ioBudget()));
+        wakeUp.wait_for(lock, pause, [this] { return stopping; });
+    }
+}
+
+void CompactionManager::setThreshold(double ratio) {
+    thresholdRatio = ratio;
+}
+
+double CompactionManager::threshold() const {
+    return thresholdRatio;
+}
+
+void CompactionManager::setIoBudget(size_t bytesPerSecond) {
+    ioBudgetBytesPerSecond = std::max<size_t>(bytesPerSecond, 1);
+}
+
+size_t CompactionManager::ioBudget() const {
+    return ioBudgetBytesPerSecond;
+}
@@ -0,0 +1,62 @@
+#ifndef COMPACTION_MANAGER_H
+#define COMPACTION_MANAGER_H
+
+#include <string>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include "storageManager/storageFormat.h"
+
+// Deleted rows are left behind as tombstones: null entries in a JSON rows file, erased slots
+// in a paged table. Columnar images drop them whenever they are written. Once tombstones
+// make up threshold() of a table, it is queued here and rewritten without them by a
+// background thread. The thread pauses between tables so its average I/O rate stays within
+// ioBudget() bytes per second.
+class CompactionManager {
+public:
+    static constexpr double DEFAULT_THRESHOLD = 0.3;
+    static constexpr size_t DEFAULT_IO_BUDGET = 4 * 1024 * 1024;
+
+    static CompactionManager& getInstance();
+
+    // Reported by deletes; queues the table once the tombstone ratio reaches the threshold.
+    void noteTombstones(const std::string& databaseName, const std::string& tableName, StorageFormat format, size_t tombstones, size_t liveRows);
+    // Rewrites a table without its tombstones on the calling thread; the caller holds the
+    // database lock. removed receives the number of tombstones dropped.
+    bool compactTable(const std::string& databaseName, const std::string& tableName, StorageFormat format, size_t& removed);
+
+    void setThreshold(double ratio);
+    double threshold() const;
+    void setIoBudget(size_t bytesPerSecond);
+    size_t ioBudget() const;
+
+private:
+    struct Job {
+        std::string databaseName;
+        std::string tableName;
+        StorageFormat format;
+    };
+
+    CompactionManager();
+    ~CompactionManager();
+    CompactionManager(const CompactionManager&) = delete;
+    CompactionManager& operator=(const CompactionManager&) = delete;
+
+    void run();
+    bool runJob(const Job& job);
+
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::deque<Job> queue;
+    std::thread worker;
+    bool stopping = false;
+    std::atomic<double> thresholdRatio{DEFAULT_THRESHOLD};
+    std::atomic<size_t> ioBudgetBytesPerSecond{DEFAULT_IO_BUDGET};
+};
+
+#define INIT_COMPACTION_MANAGER CompactionManager& compactionManager = CompactionManager::getInstance();
+
+#endif
@@ -0,0 +1,111 @@
+#include "sqlManager/constraintIndex.h"
+#include "storageManager/tombstoneFile.h"
+#include <algorithm>
+
+namespace {
+
+bool isForeignKey(const json& properties, const json& property) {
+    return property.is_object() && property.contains("table") && property.contains("column")
+        && std::find(properties.begin(), properties.end(), "FOREIGN KEY") != properties.end();
+}
+
+// The AUTO_INCREMENT column of tableName and the columns its index holds values of.
+void indexedColumns(const json& schema, const std::string& tableName, std::string& autoIncrementColumn, std::set<std::string>& columns) {
+    for (const auto& table : schema["tables"]) {
+        bool target = table["table_name"] == tableName;
+        for (const auto& column : table["columns"]) {
+            const json& properties = column["properties"];
+            for (const auto& property : properties) {
+                if (!target) {
+                    if (isForeignKey(properties, property) && property["table"] == tableName) {
+                        columns.insert(property["column"].get<std::string>());
+                    }
+                } else if (property == "AUTO_INCREMENT" && autoIncrementColumn.empty()) {
+                    autoIncrementColumn = column["name"];
+                } else if (property == "UNIQUE" || property == "PRIMARY KEY") {
+                    columns.insert(column["name"].get<std::string>());
+                } else if (isForeignKey(properties, property) && property["table"] == tableName) {
+                    columns.insert(property["column"].get<std::string>());
+                }
+            }
+        }
+    }
+}
+
+}
+
+void TableIndex::add(const json& row) {
+    if (!row.is_object()) {
+        return;
+    }
+    if (!autoIncrementColumn.empty() && row.contains(autoIncrementColumn) && row[autoIncrementColumn].is_number_integer()) {
+        nextId = std::max(nextId, row[autoIncrementColumn].get<long long>() + 1);
+    }
+    for (auto& [columnName, columnValues] : values) {
+        if (row.contains(columnName)) {
+            columnValues.insert(row[columnName].dump());
+        }
+    }
+}
+
+ConstraintIndex& ConstraintIndex::getInstance() {
+    static ConstraintIndex instance;
+    return instance;
+}
+
+std::unique_lock<std::mutex> ConstraintIndex::lock() {
+    return std::unique_lock<std::mutex>(mutex);
+}
+
+// A missing file has an empty stamp, so creating it later is a change too.
+std::vector<FileStamp> ConstraintIndex::readStamps(const std::string& databaseName, const std::string& tableName, StorageFormat format) {
+    std::string rowsPath = tableFilePath(databaseName, tableName, format);
+    std::vector<FileStamp> stamps(format == StorageFormat::JSON ? 2 : 1);
+    readFileStamp(rowsPath, stamps[0]);
+    if (format == StorageFormat::JSON) {
+        readFileStamp(TombstoneFile::path(rowsPath), stamps[1]);
+    }
+    return stamps;
+}
+
+TableIndex* ConstraintIndex::get(const std::string& databaseName, const std::string& tableName, StorageFormat format, const json& schema, const RowLoader& loadRows) {
+    std::string autoIncrementColumn;
+    std::set<std::string> columns;
+    indexedColumns(schema, tableName, autoIncrementColumn, columns);
+    std::vector<FileStamp> stamps = readStamps(databaseName, tableName, format);
+
+    TableIndex& index = indexes[databaseName + "/" + tableName];
+    bool current = !index.stamps.empty() && index.stamps == stamps && index.autoIncrementColumn == autoIncrementColumn
+        && std::all_of(columns.begin(), columns.end(), [&index](const std::string& column) { return index.values.count(column) > 0; });
+    if (current) {
+        return &index;
+    }
+
+    const json* rows = loadRows();
+    if (!rows) {
+        indexes.erase(databaseName + "/" + tableName);
+        return nullptr;
+    }
+    index = TableIndex();
+    index.stamps = std::move(stamps);
+    index.autoIncrementColumn = autoIncrementColumn;
+    for (const auto& column : columns) {
+        index.values[column];
+    }
+    for (const auto& row : *rows) {
+        index.add(row);
+    }
+    return &index;
+}
+
+void ConstraintIndex::stamp(const std::string& databaseName, const std::string& tableName, StorageFormat format) {
+    auto it = indexes.find(databaseName + "/" + tableName);
+    if (it != indexes.end()) {
+        it->second.stamps = readStamps(databaseName, tableName, format);
+    }
+}
+
+void ConstraintIndex::forget(const std::string& databaseName, const std::string& tableName) {
+    std::lock_guard<std::mutex> guard(mutex);
+    indexes.erase(databaseName + "/" + tableName);
+}
@@ -0,0 +1,70 @@
+#ifndef CONSTRAINT_INDEX_H
+#define CONSTRAINT_INDEX_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <mutex>
+#include <functional>
+#include <unordered_set>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+#include "databaseManager/databaseManager.h"
+#include "storageManager/storageFormat.h"
+
+using json = nlohmann::json;
+
+// What an INSERT checks its rows against in one table: the next AUTO_INCREMENT value and the
+// values of the table's UNIQUE and PRIMARY KEY columns and of its columns that foreign keys
+// reference. Values are keyed by their serialized form, so 5 read from a file and 5 parsed
+// from a statement compare equal.
+struct TableIndex {
+    std::vector<FileStamp> stamps;
+    std::string autoIncrementColumn;
+    long long nextId = 1;
+    std::map<std::string, std::unordered_set<std::string>> values;
+
+    void add(const json& row);
+};
+
+// Table indexes kept between statements, so an INSERT does not read and serialize every row
+// of a table to check a few new ones. An index is built from the rows the first time it is
+// needed and kept with the stamps of the table's files; inserts add their rows to it, and it
+// is rebuilt when the files have changed since. UPDATE and DELETE drop the index of their
+// table, since a page rewritten in place can keep its size and, within one clock tick, its
+// modification time.
+class ConstraintIndex {
+public:
+    // Returns the rows of the table, kept alive by the caller, or nullptr when they cannot be read.
+    using RowLoader = std::function<const json*()>;
+
+    static ConstraintIndex& getInstance();
+
+    // Held by an insert from its first check until its rows are in the index, so the checks
+    // and writes of concurrent inserts do not interleave.
+    std::unique_lock<std::mutex> lock();
+    // The index of a table for schema, read with loadRows when it is missing or stale;
+    // nullptr when the rows cannot be read. The caller holds lock().
+    TableIndex* get(const std::string& databaseName, const std::string& tableName, StorageFormat format, const json& schema, const RowLoader& loadRows);
+    // Takes the stamps of a table's files after the caller wrote them and added its rows to
+    // the index. The caller holds lock().
+    void stamp(const std::string& databaseName, const std::string& tableName, StorageFormat format);
+    // Drops the index of a table; takes the lock itself.
+    void forget(const std::string& databaseName, const std::string& tableName);
+
+private:
+    ConstraintIndex() = default;
+    ConstraintIndex(const ConstraintIndex&) = delete;
+    ConstraintIndex& operator=(const ConstraintIndex&) = delete;
+
+    static std::vector<FileStamp> readStamps(const std::string& databaseName, const std::string& tableName, StorageFormat format);
+
+    std::mutex mutex;
+    // Keyed by database name and table name, separated by '/', which names cannot contain.
+    std::unordered_map<std::string, TableIndex> indexes;
+};
+
+#define INIT_CONSTRAINT_INDEX ConstraintIndex& constraintIndex = ConstraintIndex::getInstance();
+
+#endif
@@ -0,0 +1,173 @@
+#include "sqlManager/filterKernels.h"
+#include <atomic>
+#include <cstring>
+#include <iterator>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FILTER_KERNELS_X86 1
+#endif
+
+namespace {
+
+using FilterKernel = void (*)(const std::int64_t*, size_t, CompareOp, std::int64_t, std::uint64_t*);
+
+void filterScalarRange(const std::int64_t* values, size_t begin, size_t count, CompareOp op, std::int64_t literal, std::uint64_t* bitmap) {
+    for (size_t i = begin; i < count; ++i) {
+        if (compareInt64(values[i], op, literal)) {
+            bitmap[i / 64] |= std::uint64_t(1) << (i % 64);
+        }
+    }
+}
+
+void filterScalar(const std::int64_t* values, size_t count, CompareOp op, std::int64_t literal, std::uint64_t* bitmap) {
+    std::memset(bitmap, 0, bitmapWords(count) * sizeof(std::uint64_t));
+    filterScalarRange(values, 0, count, op, literal, bitmap);
+}
+
+#ifdef FILTER_KERNELS_X86
+
+// EQUAL/NOT_EQUAL use cmpeq, the rest are expressed with cmpgt and an optional inversion.
+__attribute__((target("avx2")))
+void filterAvx2(const std::int64_t* values, size_t count, CompareOp op, std::int64_t literal, std::uint64_t* bitmap) {
+    std::memset(bitmap, 0, bitmapWords(count) * sizeof(std::uint64_t));
+    const __m256i lit = _mm256_set1_epi64x(literal);
+    const bool invert = op == CompareOp::NOT_EQUAL || op == CompareOp::LESS_EQUAL || op == CompareOp::GREATER_EQUAL;
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i mask;
+        switch (op) {
+            case CompareOp::EQUAL:
+            case CompareOp::NOT_EQUAL:
+                mask = _mm256_cmpeq_epi64(v, lit);
+                break;
+            case CompareOp::GREATER:
+            case CompareOp::LESS_EQUAL:
+                mask = _mm256_cmpgt_epi64(v, lit);
+                break;
+            default:
+                mask = _mm256_cmpgt_epi64(lit, v);
+                break;
+        }
+        std::uint64_t bits = static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+        if (invert) {
+            bits = ~bits & 0xF;
+        }
+        bitmap[i / 64] |= bits << (i % 64);
+    }
+    filterScalarRange(values, i, count, op, literal, bitmap);
+}
+
+__attribute__((target("sse4.2")))
+void filterSse42(const std::int64_t* values, size_t count, CompareOp op, std::int64_t literal, std::uint64_t* bitmap) {
+    std::memset(bitmap, 0, bitmapWords(count) * sizeof(std::uint64_t));
+    const __m128i lit = _mm_set1_epi64x(literal);
+    const bool invert = op == CompareOp::NOT_EQUAL || op == CompareOp::LESS_EQUAL || op == CompareOp::GREATER_EQUAL;
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        __m128i mask;
+        switch (op) {
+            case CompareOp::EQUAL:
+            case CompareOp::NOT_EQUAL:
+                mask = _mm_cmpeq_epi64(v, lit);
+                break;
+            case CompareOp::GREATER:
+            case CompareOp::LESS_EQUAL:
+                mask = _mm_cmpgt_epi64(v, lit);
+                break;
+            default:
+                mask = _mm_cmpgt_epi64(lit, v);
+                break;
+        }
+        std::uint64_t bits = static_cast<std::uint64_t>(_mm_movemask_pd(_mm_castsi128_pd(mask)));
+        if (invert) {
+            bits = ~bits & 0x3;
+        }
+        bitmap[i / 64] |= bits << (i % 64);
+    }
+    filterScalarRange(values, i, count, op, literal, bitmap);
+}
+
+#endif
+
+bool alwaysSupported() {
+    return true;
+}
+
+#ifdef FILTER_KERNELS_X86
+bool avx2Supported() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+bool sse42Supported() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+#endif
+
+struct KernelEntry {
+    const char* name;
+    FilterKernel kernel;
+    bool (*supported)();
+};
+
+// Fastest first, so the first supported entry is the default.
+const KernelEntry KERNELS[] = {
+#ifdef FILTER_KERNELS_X86
+    {"avx2", filterAvx2, avx2Supported},
+    {"sse4.2", filterSse42, sse42Supported},
+#endif
+    {"scalar", filterScalar, alwaysSupported}
+};
+
+size_t fastestKernel() {
+    size_t index = 0;
+    while (!KERNELS[index].supported()) {
+        ++index;
+    }
+    return index;
+}
+
+std::atomic<size_t>& activeKernel() {
+    static std::atomic<size_t> active{fastestKernel()};
+    return active;
+}
+
+}
+
+void filterInt64Column(const std::int64_t* values, size_t count, CompareOp op, std::int64_t literal, std::uint64_t* bitmap) {
+    KERNELS[activeKernel().load(std::memory_order_relaxed)].kernel(values, count, op, literal, bitmap);
+}
+
+std::vector<std::string> availableFilterKernels() {
+    std::vector<std::string> names;
+    for (const auto& entry : KERNELS) {
+        if (entry.supported()) {
+            names.push_back(entry.name);
+        }
+    }
+    return names;
+}
+
+std::string activeFilterKernel() {
+    return KERNELS[activeKernel().load(std::memory_order_relaxed)].name;
+}
+
+bool selectFilterKernel(const std::string& name) {
+    if (name == "auto") {
+        activeKernel().store(fastestKernel(), std::memory_order_relaxed);
+        return true;
+    }
+    for (size_t i = 0; i < std::size(KERNELS); ++i) {
+        if (name == KERNELS[i].name && KERNELS[i].supported()) {
+            activeKernel().store(i, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
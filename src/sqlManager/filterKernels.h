@@ -0,0 +1,45 @@
+#ifndef FILTER_KERNELS_H
+#define FILTER_KERNELS_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "sqlManager/wherePredicate.h"
+
+// One bit per row, bit i of word i / 64 is set when row i was selected.
+using SelectionBitmap = std::vector<std::uint64_t>;
+
+inline size_t bitmapWords(size_t rowCount) {
+    return (rowCount + 63) / 64;
+}
+
+inline bool bitmapTest(const SelectionBitmap& bitmap, size_t row) {
+    return (bitmap[row / 64] >> (row % 64)) & 1;
+}
+
+inline bool compareInt64(std::int64_t value, CompareOp op, std::int64_t literal) {
+    switch (op) {
+        case CompareOp::EQUAL: return value == literal;
+        case CompareOp::NOT_EQUAL: return value != literal;
+        case CompareOp::LESS: return value < literal;
+        case CompareOp::GREATER: return value > literal;
+        case CompareOp::LESS_EQUAL: return value <= literal;
+        case CompareOp::GREATER_EQUAL: return value >= literal;
+    }
+    return false;
+}
+
+// Compares `count` contiguous int64 values against `literal` and writes the selection bitmap.
+// The implementation (AVX2, SSE4.2 or scalar) is the fastest the CPU supports unless
+// selectFilterKernel picked another.
+void filterInt64Column(const std::int64_t* values, size_t count, CompareOp op, std::int64_t literal, std::uint64_t* bitmap);
+
+// Names of the kernels this CPU can run, fastest first; "scalar" is always available.
+std::vector<std::string> availableFilterKernels();
+std::string activeFilterKernel();
+// Makes filterInt64Column use the named kernel, or the fastest one for "auto", so the vector
+// kernels can be checked against the scalar one. False when the CPU cannot run it.
+bool selectFilterKernel(const std::string& name);
+
+#endif
@@ -5,6 +5,43 @@
 #include <map>
 #include <string>
 #include <tuple>
+#include <unordered_set>
+
+namespace {
+
+// Drops the constraint index of a table once a statement that may have changed its rows ends,
+// however it ends.
+class IndexInvalidation {
+public:
+    IndexInvalidation(const std::string& databaseName, const std::string& tableName) : databaseName(databaseName), tableName(tableName) {}
+    ~IndexInvalidation() { ConstraintIndex::getInstance().forget(databaseName, tableName); }
+
+private:
+    const std::string& databaseName;
+    const std::string& tableName;
+};
+
+// Combines the bitmaps of the operands of a logical predicate word by word, under SQL's
+// three-valued logic: known marks rows whose result is true or false rather than unknown.
+// NOT selects the known rows its operand did not; AND is known once either side is false
+// and OR once either side is true.
+void combineSelections(WhereExpr::Kind kind, SelectionBitmap& selected, SelectionBitmap& known, const SelectionBitmap& rightSelected, const SelectionBitmap& rightKnown) {
+    for (size_t w = 0; w < selected.size(); ++w) {
+        std::uint64_t leftFalse = known[w] & ~selected[w];
+        if (kind == WhereExpr::Kind::NOT) {
+            selected[w] = leftFalse;
+        } else if (kind == WhereExpr::Kind::AND) {
+            known[w] = (known[w] & rightKnown[w]) | leftFalse | (rightKnown[w] & ~rightSelected[w]);
+            selected[w] &= rightSelected[w];
+        } else {
+            known[w] = (known[w] & rightKnown[w]) | selected[w] | rightSelected[w];
+            selected[w] |= rightSelected[w];
+        }
+    }
+}
+
+}
+
 json SQLManager::findTable(const json& dbContent, const std::string& tableName) {
     auto& tables = dbContent["tables"];
     auto tableIt = std::find_if(tables.begin(), tables.end(), [&tableName](const json& table) {
@@ -14,175 +51,192 @@ json SQLManager::findTable(const json& dbContent, const std::string& tableName)
 }
 
 
-bool SQLManager::insertIntoTable(const std::string& databaseName, const std::string& tableName, const std::map<std::string, std::string>& columnValueMap) {
-    json dbContent;
-    if (!readDatabaseFile(databaseName, dbContent)) {
+// Converts each row of values to the types of the given columns and inserts them all with
+// insertTypedRows. Rows are numbered from 1 in error messages when there is more than one.
+bool SQLManager::insertRows(const std::string& databaseName, const std::string& tableName, const std::vector<std::string>& columns, const std::vector<std::vector<std::string>>& rows) {
+    json schema;
+    if (!readDatabaseSchema(databaseName, schema)) {
         std::cerr << "Error: Database '" << databaseName << "' does not exist." << std::endl;
         return false;
     }
-
-    json* targetTable = nullptr;
-    for (auto& table : dbContent["tables"]) {
-        if (table["table_name"] == tableName) {
-            targetTable = &table;
-            break;
-        }
-    }
-    if (!targetTable) {
+    const json table = findTable(schema, tableName);
+    if (table.is_null()) {
         std::cerr << "Error: Table '" << tableName << "' does not exist in database '" << databaseName << "'." << std::endl;
         return false;
     }
 
-    const json& tableColumns = (*targetTable)["columns"];
-    json& tableRows = (*targetTable)["rows"];
-
-    std::string autoIncrementColumn;
-    for (const auto& column : tableColumns) {
-        if (std::find(column["properties"].begin(), column["properties"].end(), "AUTO_INCREMENT") != column["properties"].end()) {
-            autoIncrementColumn = column["name"];
-            break;
+    std::vector<std::string> columnTypes;
+    for (const auto& columnName : columns) {
+        auto columnIt = std::find_if(table["columns"].begin(), table["columns"].end(), [&columnName](const json& column) {
+            return column["name"] == columnName;
+        });
+        if (columnIt == table["columns"].end()) {
+            std::cerr << "Error: Column '" << columnName << "' does not exist in table '" << tableName << "'." << std::endl;
+            return false;
         }
+        columnTypes.push_back((*columnIt)["type"]);
     }
 
-    json newRow;
-
-    if (!autoIncrementColumn.empty()) {
-        int nextId = 1;
-        for (const auto& row : tableRows) {
-            if (row.contains(autoIncrementColumn)) {
-                int currentId = row[autoIncrementColumn].get<int>();
-                if (currentId >= nextId) {
-                    nextId = currentId + 1;
-                }
+    json typedRows = json::array();
+    for (size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex) {
+        const auto& values = rows[rowIndex];
+        std::string rowLabel = rows.size() > 1 ? " in row " + std::to_string(rowIndex + 1) : "";
+        if (values.size() != columns.size()) {
+            std::cerr << "Error: Mismatch between number of provided columns and values" << rowLabel << "." << std::endl;
+            return false;
+        }
+        json row = json::object();
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (!convertLiteral(columnTypes[i], values[i], row[columns[i]])) {
+                std::cerr << "Error: Invalid " << columnTypes[i] << " value '" << values[i] << "' for column '" << columns[i] << "'" << rowLabel << "." << std::endl;
+                return false;
             }
         }
-        newRow[autoIncrementColumn] = nextId;
-    }
-
-    for (const auto& [columnName, value] : columnValueMap) {
-        bool columnFound = false;
-        for (const auto& column : tableColumns) {
-            if (column["name"] == columnName) {
-                columnFound = true;
-                std::string columnType = column["type"];
-                auto columnProperties = column.contains("properties") ? column["properties"] : json::array();
-
-                for (const auto& row : tableRows) {
-                    if (row.contains(columnName) && row[columnName] == value) {
-                        for (const auto& property : columnProperties) {
-                            if (property == "UNIQUE") {
-                                std::cerr << "Error: Unique constraint violation. Value '"
-                                          << value << "' already exists for column '"
-                                          << columnName << "'." << std::endl;
-                                return false;
-                            }
-                        }
-                    }
-                }
-
-                if (columnType == "int") {
-                    try {
-                        newRow[columnName] = std::stoi(value);
-                    } catch (const std::exception& e) {
-                        std::cerr << "Error: Invalid integer value '" << value << "' for column '" << columnName << "'." << std::endl;
-                        return false;
-                    }
-                } else if (columnType == "string") {
-                    newRow[columnName] = value;
-                } else {
-                    std::cerr << "Error: Unsupported column type '" << columnType << "' for column '" << columnName << "'." << std::endl;
-                    return false;
-                }
-
-                if (std::find(columnProperties.begin(), columnProperties.end(), "FOREIGN KEY") != columnProperties.end()) {
-                    auto references = std::find_if(columnProperties.begin(), columnProperties.end(), [](const json& prop) {
-                        return prop.is_object() && prop.contains("table") && prop.contains("column");
-                    });
-
-                    if (references != columnProperties.end()) {
-                        std::string referencedTable = (*references)["table"];
-                        std::string referencedColumn = (*references)["column"];
-                        bool referenceExists = false;
-
-                        for (const auto& refTable : dbContent["tables"]) {
-                            if (refTable["table_name"] == referencedTable) {
-                                for (const auto& refRow : refTable["rows"]) {
-                                    if (refRow.contains(referencedColumn) && refRow[referencedColumn] == newRow[columnName]) {
-                                        referenceExists = true;
-                                        break;
-                                    }
-                                }
-                                if (referenceExists) break;
-                            }
-                        }
+        typedRows.push_back(std::move(row));
+    }
+    return insertTypedRows(databaseName, tableName, std::move(typedRows));
+}
 
-                        if (!referenceExists) {
-                            std::cerr << "Error: Foreign key constraint violation. Value '"
-                                      << value << "' does not exist in column '"
-                                      << referencedColumn << "' of table '"
-                                      << referencedTable << "'." << std::endl;
-                            return false;
-                        }
-                    }
-                }
+// Rows are checked against the constraint index of the table, the indexes of the tables its
+// foreign keys reference and the other rows of the batch, so a foreign key may refer to a row
+// inserted with it. Nothing is written unless all rows pass; then the table is written once
+// and the new rows are added to its index.
+bool SQLManager::insertTypedRows(const std::string& databaseName, const std::string& tableName, json rows) {
+    INIT_DB_MANAGER
+    INIT_CONSTRAINT_INDEX
+    const StorageFormat format = dbManager.getStorageFormat(databaseName);
+    json schema;
+    if (!readDatabaseSchema(databaseName, schema)) {
+        std::cerr << "Error: Database '" << databaseName << "' does not exist." << std::endl;
+        return false;
+    }
+    json table = findTable(schema, tableName);
+    if (table.is_null()) {
+        std::cerr << "Error: Table '" << tableName << "' does not exist in database '" << databaseName << "'." << std::endl;
+        return false;
+    }
 
-                break;
+    struct ForeignKey {
+        std::string column;
+        std::string referencedTable;
+        std::string referencedColumn;
+        const std::unordered_set<std::string>* values;
+    };
+    std::vector<std::string> uniqueColumns;
+    std::vector<ForeignKey> foreignKeys;
+    for (const auto& column : table["columns"]) {
+        const std::string columnName = column["name"];
+        const json& properties = column["properties"];
+        for (const auto& property : properties) {
+            if (property == "UNIQUE" || property == "PRIMARY KEY") {
+                uniqueColumns.push_back(columnName);
+            } else if (property.is_object() && property.contains("table") && property.contains("column")
+                       && std::find(properties.begin(), properties.end(), "FOREIGN KEY") != properties.end()) {
+                foreignKeys.push_back({columnName, property["table"], property["column"], nullptr});
             }
         }
-
-        if (!columnFound) {
-            std::cerr << "Error: Column '" << columnName << "' does not exist in table '" << tableName << "'." << std::endl;
-            return false;
-        }
     }
 
-    tableRows.push_back(newRow);
-
-    if (!writeDatabaseFile(databaseName, dbContent)) {
-        std::cerr << "Error: Failed to write to database file for database '" << databaseName << "'." << std::endl;
+    auto lock = constraintIndex.lock();
+    // JSON and columnar tables are written whole, so their rows are read anyway; a paged
+    // table only appends, and its rows are read when its index has to be built.
+    json& tableRows = table["rows"];
+    if (format != StorageFormat::PAGED && !readTableRows(databaseName, format, tableName, tableRows)) {
         return false;
     }
+    auto loadRows = [this, &databaseName, format](const std::string& name, json& rows) -> const json* {
+        return readTableRows(databaseName, format, name, rows) ? &rows : nullptr;
+    };
+    TableIndex* index = constraintIndex.get(databaseName, tableName, format, schema, [&]() -> const json* {
+        return format == StorageFormat::PAGED ? loadRows(tableName, tableRows) : &tableRows;
+    });
+    if (!index) {
+        return false;
+    }
+    std::vector<json> referencedRows(foreignKeys.size());
+    for (size_t i = 0; i < foreignKeys.size(); ++i) {
+        ForeignKey& foreignKey = foreignKeys[i];
+        TableIndex* referenced = index;
+        if (foreignKey.referencedTable != tableName) {
+            referenced = constraintIndex.get(databaseName, foreignKey.referencedTable, format, schema, [&]() {
+                return loadRows(foreignKey.referencedTable, referencedRows[i]);
+            });
+            if (!referenced) {
+                return false;
+            }
+        }
+        foreignKey.values = &referenced->values[foreignKey.referencedColumn];
+    }
 
-    return true;
-}
-
-
-
+    long long nextId = index->nextId;
+    std::map<std::string, std::unordered_set<std::string>> batchValues;
+    for (auto& row : rows) {
+        if (!index->autoIncrementColumn.empty()) {
+            const std::string& column = index->autoIncrementColumn;
+            if (!row.contains(column)) {
+                row[column] = nextId++;
+            } else if (row[column].is_number_integer()) {
+                nextId = std::max(nextId, row[column].get<long long>() + 1);
+            }
+        }
+        for (const auto& [columnName, values] : index->values) {
+            if (!row.contains(columnName)) {
+                continue;
+            }
+            std::string value = row[columnName].dump();
+            bool repeated = !batchValues[columnName].insert(value).second;
+            bool unique = std::find(uniqueColumns.begin(), uniqueColumns.end(), columnName) != uniqueColumns.end();
+            if (unique && (repeated || values.count(value))) {
+                std::cerr << "Error: Unique constraint violation. Value '" << value << "' already exists for column '" << columnName << "'." << std::endl;
+                return false;
+            }
+        }
+    }
+    for (const auto& row : rows) {
+        for (const auto& foreignKey : foreignKeys) {
+            if (!row.contains(foreignKey.column)) {
+                continue;
+            }
+            std::string value = row[foreignKey.column].dump();
+            bool inBatch = foreignKey.referencedTable == tableName && batchValues[foreignKey.referencedColumn].count(value);
+            if (!inBatch && !foreignKey.values->count(value)) {
+                std::cerr << "Error: Foreign key constraint violation. Value '" << value
+                          << "' does not exist in column '" << foreignKey.referencedColumn
+                          << "' of table '" << foreignKey.referencedTable << "'." << std::endl;
+                return false;
+            }
+        }
+    }
 
-bool SQLManager::deleteDatabase(const std::string& databaseName) {
-    std::string dbFilePath = "data/databases/" + databaseName + ".db.json";
-    if (std::filesystem::exists(dbFilePath)) {
-        if (std::filesystem::remove(dbFilePath)) {
-            return true;
-        } else {
-            std::cerr << "Error: Unable to delete the database file: " << dbFilePath << "\n";
+    if (format == StorageFormat::PAGED) {
+        PagedTable pagedTable(databaseName, tableName);
+        if (!pagedTable.appendRows(rows)) {
             return false;
         }
     } else {
-        std::cerr << "Error: No database found at " << dbFilePath << "\n";
-        return false;
+        for (const auto& row : rows) {
+            tableRows.push_back(row);
+        }
+        if (!writeTable(databaseName, format, table)) {
+            std::cerr << "Error: Failed to write to database file for database '" << databaseName << "'." << std::endl;
+            return false;
+        }
     }
-}
-
-bool SQLManager::createDatabase(const std::string& databaseName) {
-    std::string dbFilePath = "data/databases/" + databaseName + ".db.json";
-    if (std::filesystem::exists(dbFilePath)) {
-        std::cerr << "Error: Database file '" << dbFilePath << "' already exists." << std::endl;
-        return false;
+    for (const auto& row : rows) {
+        index->add(row);
     }
-
-    nlohmann::json dbContent = {
-        {"database_name", databaseName},
-        {"tables", nlohmann::json::array()}
-    };
-
-    return writeDatabaseFile(databaseName, dbContent);
+    constraintIndex.stamp(databaseName, tableName, format);
+    return true;
 }
 
-
 bool SQLManager::createTable(const std::string& databaseName, const std::string& tableName, const json& columns) {
+    INIT_DB_MANAGER
+    if (!isValidStorageName(tableName)) {
+        std::cerr << "Error: Invalid table name '" << tableName << "'." << std::endl;
+        return false;
+    }
     json dbContent;
-    if (!readDatabaseFile(databaseName, dbContent)) {
+    if (!readDatabaseSchema(databaseName, dbContent)) {
         std::cerr << "Error: Database '" << databaseName << "' does not exist." << std::endl;
         return false;
     }
@@ -251,7 +305,9 @@ bool SQLManager::createTable(const std::string& databaseName, const std::string&
 
     dbContent["tables"].push_back(newTable);
 
-    if (!writeDatabaseFile(databaseName, dbContent)) {
+    // The empty rows file exists before the schema names the table.
+    if (!writeTable(databaseName, dbManager.getStorageFormat(databaseName), newTable) ||
+        !writeDatabaseSchema(databaseName, dbContent)) {
         std::cerr << "Error: Failed to write updated database content to file." << std::endl;
         return false;
     }
@@ -263,6 +319,7 @@ bool SQLManager::createTable(const std::string& databaseName, const std::string&
 
 
 bool SQLManager::addRow(const std::string& databaseName, const std::string& tableName, const nlohmann::json& row) {
+    INIT_DB_MANAGER
     nlohmann::json dbContent;
     if (!readDatabaseFile(databaseName, dbContent)) {
         std::cerr << "Error: Database '" << databaseName << "' does not exist." << std::endl;
@@ -280,7 +337,7 @@ bool SQLManager::addRow(const std::string& databaseName, const std::string& tabl
                     for (const auto& refTableData : dbContent["tables"]) {
                         if (refTableData["table_name"] == refTable) {
                             for (const auto& refRow : refTableData["rows"]) {
-                                if (refRow[refColumn] == row[column["name"]]) {
+                                if (refRow.is_object() && refRow[refColumn] == row[column["name"]]) {
                                     refExists = true;
                                     break;
                                 }
@@ -297,7 +354,7 @@ bool SQLManager::addRow(const std::string& databaseName, const std::string& tabl
             }
 
             table["rows"].push_back(row);
-            return writeDatabaseFile(databaseName, dbContent);
+            return writeTable(databaseName, dbManager.getStorageFormat(databaseName), table);
         }
     }
 
@@ -305,28 +362,53 @@ bool SQLManager::addRow(const std::string& databaseName, const std::string& tabl
     return false;
 }
 
-ResultTableColumns SQLManager::getTableAndColumnFromDatabase(const std::string& databaseName, const std::map<std::string, std::vector<std::string>>& tableColumnMap) {
+ResultTableColumns SQLManager::getTableAndColumnFromDatabase(const std::string& databaseName, const std::map<std::string, std::vector<std::string>>& tableColumnMap, const std::string& filterTable, const WhereExpr* where) {
+    INIT_DB_MANAGER
+    StorageFormat format = dbManager.getStorageFormat(databaseName);
+    if (format == StorageFormat::COLUMNAR) {
+        return getTableAndColumnFromColumnarFile(databaseName, tableColumnMap, filterTable, where);
+    }
+    if (format == StorageFormat::PAGED) {
+        return getTableAndColumnFromPagedFile(databaseName, tableColumnMap, filterTable, where);
+    }
+
     ResultTableColumns resultTableColumns;
     json dbContent;
+    std::set<std::string> tableNames;
+    for (const auto& [tableName, columns] : tableColumnMap) {
+        tableNames.insert(tableName);
+    }
 
-    if (!readDatabaseFile(databaseName, dbContent)) {
+    if (!readTables(databaseName, tableNames, dbContent)) {
         std::cerr << "Error: Could not read database file." << std::endl;
         return resultTableColumns;
     }
 
     for (const auto& table : dbContent["tables"]) {
         std::string tableName = table["table_name"];
-        const auto& columns = table["columns"];
         const auto& rows = table["rows"];
 
         if (tableColumnMap.find(tableName) != tableColumnMap.end()) {
+            std::unique_ptr<RowPredicate> predicate;
+            if (!compileWhere(table, tableName == filterTable ? where : nullptr, predicate)) {
+                return {};
+            }
+            SelectionBitmap selected;
+            if (predicate) {
+                selected = selectRows(rows, *predicate);
+            }
+
             auto& columnMap = resultTableColumns[tableName];
 
             for (const auto& column : tableColumnMap.at(tableName)) {
                 columnMap[column] = {};
             }
 
-            for (const auto& row : rows) {
+            for (size_t i = 0; i < rows.size(); ++i) {
+                const auto& row = rows[i];
+                if (row.is_null() || (predicate && !bitmapTest(selected, i))) {
+                    continue;
+                }
                 for (const auto& columnPair : columnMap) {
                     const std::string& columnName = columnPair.first;
                     if (row.contains(columnName)) {
@@ -342,11 +424,119 @@ ResultTableColumns SQLManager::getTableAndColumnFromDatabase(const std::string&
     return resultTableColumns;
 }
 
+// Read-only projection served straight from the mapped columnar images of the requested
+// tables: only the requested columns are touched and no JSON document is built. The WHERE
+// clause is evaluated on the mapped columns as well.
+ResultTableColumns SQLManager::getTableAndColumnFromColumnarFile(const std::string& databaseName, const std::map<std::string, std::vector<std::string>>& tableColumnMap, const std::string& filterTable, const WhereExpr* where) {
+    ResultTableColumns resultTableColumns;
+    json schema;
+    if (where && !readDatabaseSchema(databaseName, schema)) {
+        return resultTableColumns;
+    }
+
+    for (const auto& [tableName, requestedColumns] : tableColumnMap) {
+        std::unique_ptr<RowPredicate> predicate;
+        if (where && tableName == filterTable && !compileWhere(findTable(schema, tableName), where, predicate)) {
+            return {};
+        }
+        std::string tablePath = tableFilePath(databaseName, tableName, StorageFormat::COLUMNAR);
+        if (!isValidStorageName(tableName) || !std::filesystem::exists(tablePath)) {
+            continue;
+        }
+        MappedFile file;
+        ColumnarFormat::DatabaseView view;
+        if (!file.open(tablePath) || !view.open(file.data(), file.size())) {
+            std::cerr << "Error: Could not read table file '" << tablePath << "'." << std::endl;
+            continue;
+        }
+        const ColumnarFormat::TableView* table = view.findTable(tableName);
+        if (!table) {
+            continue;
+        }
+
+        SelectionBitmap selected;
+        if (predicate) {
+            selected = selectColumnRows(*table, *predicate);
+        }
+
+        auto& columnMap = resultTableColumns[tableName];
+        for (const auto& columnName : requestedColumns) {
+            auto& values = columnMap[columnName];
+            values.reserve(table->rowCount);
+            const ColumnarFormat::ColumnView* column = table->findColumn(columnName);
+            for (std::uint64_t row = 0; row < table->rowCount; ++row) {
+                if (predicate && !bitmapTest(selected, row)) {
+                    continue;
+                }
+                if (!column || column->isNull(row)) {
+                    values.push_back("NULL");
+                } else if (column->type == ColumnarFormat::ColumnType::INT) {
+                    values.push_back(std::to_string(column->intAt(row)));
+                } else {
+                    values.push_back(json(column->stringAt(row)).dump());
+                }
+            }
+        }
+    }
+
+    return resultTableColumns;
+}
+
+
+
+// Only the pages of the requested tables are read, through the buffer pool.
+ResultTableColumns SQLManager::getTableAndColumnFromPagedFile(const std::string& databaseName, const std::map<std::string, std::vector<std::string>>& tableColumnMap, const std::string& filterTable, const WhereExpr* where) {
+    ResultTableColumns resultTableColumns;
+    json schema;
+    if (where && !readDatabaseSchema(databaseName, schema)) {
+        return resultTableColumns;
+    }
+
+    for (const auto& [tableName, requestedColumns] : tableColumnMap) {
+        if (!isValidStorageName(tableName) || !std::filesystem::exists(tableFilePath(databaseName, tableName, StorageFormat::PAGED))) {
+            continue;
+        }
+        std::unique_ptr<RowPredicate> predicate;
+        if (where && tableName == filterTable && !compileWhere(findTable(schema, tableName), where, predicate)) {
+            return {};
+        }
+        PagedTable pagedTable(databaseName, tableName);
+        std::map<std::string, std::vector<std::string>> columnMap;
+        for (const auto& column : requestedColumns) {
+            columnMap[column] = {};
+        }
+
+        bool found = pagedTable.forEachPage([this, &columnMap, &predicate](SlottedPage& page) {
+            std::vector<std::uint16_t> slots;
+            json rows = json::array();
+            PagedTable::decodePage(page, slots, rows);
+            SelectionBitmap selected;
+            if (predicate) {
+                selected = selectRows(rows, *predicate);
+            }
+            for (size_t i = 0; i < rows.size(); ++i) {
+                if (predicate && !bitmapTest(selected, i)) {
+                    continue;
+                }
+                for (auto& [columnName, values] : columnMap) {
+                    auto it = rows[i].find(columnName);
+                    values.push_back(it != rows[i].end() ? it->dump() : "NULL");
+                }
+            }
+            return false;
+        });
+        if (found) {
+            resultTableColumns[tableName] = std::move(columnMap);
+        }
+    }
 
+    return resultTableColumns;
+}
 
 bool SQLManager::deleteRow(const std::string& databaseName, const std::string& tableName, const std::string& primaryKey) {
+    INIT_DB_MANAGER
     nlohmann::json dbContent;
-    if (!readDatabaseFile(databaseName, dbContent)) {
+    if (!readTables(databaseName, {tableName}, dbContent)) {
         std::cerr << "Error: Database '" << databaseName << "' does not exist." << std::endl;
         return false;
     }
@@ -354,9 +544,9 @@ bool SQLManager::deleteRow(const std::string& databaseName, const std::string& t
     for (auto& table : dbContent["tables"]) {
         if (table["table_name"] == tableName) {
             for (auto it = table["rows"].begin(); it != table["rows"].end(); ++it) {
-                if ((*it)["id"] == primaryKey) { 
+                if (it->is_object() && (*it)["id"] == primaryKey) {
                     table["rows"].erase(it);
-                    return writeDatabaseFile(databaseName, dbContent);
+                    return writeTable(databaseName, dbManager.getStorageFormat(databaseName), table);
                 }
             }
         }
@@ -366,268 +556,384 @@ bool SQLManager::deleteRow(const std::string& databaseName, const std::string& t
     return false;
 }
 
-bool SQLManager::readDatabaseFile(const std::string& databaseName, nlohmann::json& dbContent) {
-    std::string dbFilePath = "data/databases/" + databaseName + ".db.json";
-    std::ifstream inputFile(dbFilePath);
-    if (!inputFile.is_open()) {
-        std::cerr << "Error: Failed to open JSON file '" << dbFilePath << "'." << std::endl;
+SelectionBitmap SQLManager::selectRows(const json& rows, const RowPredicate& predicate) {
+    SelectionBitmap known;
+    return selectRows(rows, predicate, known);
+}
+
+SelectionBitmap SQLManager::selectRows(const json& rows, const RowPredicate& predicate, SelectionBitmap& known) {
+    const size_t rowCount = rows.size();
+
+    // AND, OR and NOT combine the bitmaps of their operands word by word. Comparisons never
+    // select or know tombstones, so NOT never selects them either.
+    if (const LogicalPredicate* logical = predicate.logical()) {
+        SelectionBitmap selected = selectRows(rows, logical->left(), known);
+        SelectionBitmap right;
+        SelectionBitmap rightKnown;
+        if (logical->operation() != WhereExpr::Kind::NOT) {
+            right = selectRows(rows, logical->right(), rightKnown);
+        }
+        combineSelections(logical->operation(), selected, known, right, rightKnown);
+        return selected;
+    }
+
+    SelectionBitmap selected(bitmapWords(rowCount), 0);
+    known.assign(selected.size(), 0);
+    const IntComparison* comparison = predicate.intComparison();
+    if (!comparison) {
+        for (size_t i = 0; i < rowCount; ++i) {
+            if (predicate.known(rows[i])) {
+                known[i / 64] |= std::uint64_t(1) << (i % 64);
+                selected[i / 64] |= std::uint64_t(predicate.matches(rows[i])) << (i % 64);
+            }
+        }
+        return selected;
+    }
+
+    // JSON rows keep no contiguous column, so each cell is compared where it is stored;
+    // rows where the column is missing or not an integer are unknown.
+    for (size_t i = 0; i < rowCount; ++i) {
+        auto it = rows[i].find(comparison->column);
+        if (it != rows[i].end() && it->is_number_integer()) {
+            known[i / 64] |= std::uint64_t(1) << (i % 64);
+            selected[i / 64] |= std::uint64_t(compareInt64(it->get<std::int64_t>(), comparison->op, comparison->literal)) << (i % 64);
+        }
+    }
+    return selected;
+}
+
+SelectionBitmap SQLManager::selectColumnRows(const ColumnarFormat::TableView& table, const RowPredicate& predicate) {
+    SelectionBitmap known;
+    return selectColumnRows(table, predicate, known);
+}
+
+// The columnar counterpart of selectRows: integer comparisons run the vectorized kernel over
+// the mapped column itself and are masked with its null bitmap, which uses the same layout
+// as a SelectionBitmap and is also what the comparison knows. Other comparisons, and all
+// of them on hosts whose byte order differs from the image's, are evaluated on the
+// decoded row.
+SelectionBitmap SQLManager::selectColumnRows(const ColumnarFormat::TableView& table, const RowPredicate& predicate, SelectionBitmap& known) {
+    const size_t rowCount = table.rowCount;
+
+    if (const LogicalPredicate* logical = predicate.logical()) {
+        SelectionBitmap selected = selectColumnRows(table, logical->left(), known);
+        SelectionBitmap right;
+        SelectionBitmap rightKnown;
+        if (logical->operation() != WhereExpr::Kind::NOT) {
+            right = selectColumnRows(table, logical->right(), rightKnown);
+        }
+        combineSelections(logical->operation(), selected, known, right, rightKnown);
+        return selected;
+    }
+
+    SelectionBitmap selected(bitmapWords(rowCount), 0);
+    known.assign(selected.size(), 0);
+    const IntComparison* comparison = predicate.intComparison();
+    const ColumnarFormat::ColumnView* column = comparison ? table.findColumn(comparison->column) : nullptr;
+    if (comparison && !column) {
+        return selected;
+    }
+    if (!column || column->type != ColumnarFormat::ColumnType::INT || !ColumnarFormat::NATIVE_BYTE_ORDER) {
+        for (size_t i = 0; i < rowCount; ++i) {
+            json row = table.rowAt(i);
+            if (predicate.known(row)) {
+                known[i / 64] |= std::uint64_t(1) << (i % 64);
+                selected[i / 64] |= std::uint64_t(predicate.matches(row)) << (i % 64);
+            }
+        }
+        return selected;
+    }
+
+    filterInt64Column(reinterpret_cast<const std::int64_t*>(column->values), rowCount, comparison->op, comparison->literal, selected.data());
+    for (size_t w = 0; w < selected.size(); ++w) {
+        known[w] = column->bitmapWord(w);
+        selected[w] &= known[w];
+    }
+    return selected;
+}
+
+// A missing WHERE clause leaves predicate empty, which selects every row.
+bool SQLManager::compileWhere(const json& table, const WhereExpr* where, std::unique_ptr<RowPredicate>& predicate) {
+    predicate.reset();
+    if (!where) {
+        return true;
+    }
+    if (table.empty()) {
         return false;
     }
+    predicate = compileWhereExpression(table["columns"], table["table_name"], *where);
+    return predicate != nullptr;
+}
 
-    try {
-        inputFile >> dbContent;
-    } catch (const std::exception& e) {
-        std::cerr << "Error: Failed to parse JSON from file '" << dbFilePath << "': " << e.what() << std::endl;
-        inputFile.close();
+bool SQLManager::compileUpdates(const json& columns, const std::vector<Assignment>& assignments, std::vector<std::pair<std::string, json>>& updates) {
+    if (assignments.empty()) {
+        std::cerr << "Error: No SET clause found." << std::endl;
         return false;
     }
 
-    inputFile.close();
+    for (const auto& [column, value] : assignments) {
+        auto columnIt = std::find_if(columns.begin(), columns.end(), [&column = column](const nlohmann::json& col) {
+            return col["name"] == column;
+        });
+        if (columnIt == columns.end()) {
+            std::cerr << "Error: Column '" << column << "' in SET clause does not exist." << std::endl;
+            return false;
+        }
+        nlohmann::json typedValue;
+        if (!convertLiteral((*columnIt)["type"], value.text, typedValue)) {
+            std::cerr << "Error: Invalid value '" << value.text << "' for column '" << column << "'." << std::endl;
+            return false;
+        }
+        updates.emplace_back(column, std::move(typedValue));
+    }
     return true;
 }
 
-bool SQLManager::writeDatabaseFile(const std::string& databaseName, const nlohmann::json& dbContent) {
-    std::string dbFilePath = "data/databases/" + databaseName + ".db.json";
-    std::ofstream outputFile(dbFilePath);
+bool SQLManager::deleteRecords(const DeleteStatement& statement, const std::string& databaseName) {
+    INIT_DB_MANAGER
+    IndexInvalidation invalidation(databaseName, statement.table);
+    const StorageFormat format = dbManager.getStorageFormat(databaseName);
+    if (format == StorageFormat::PAGED) {
+        return deletePagedRecords(statement, databaseName);
+    }
+
+    nlohmann::json dbContent;
+    if (!readTables(databaseName, {statement.table}, dbContent)) {
+        std::cerr << "Error: Failed to read the database file." << std::endl;
+        return false;
+    }
 
-    if (!outputFile.is_open()) {
-        std::cerr << "Error: Failed to open JSON file '" << dbFilePath << "' for writing." << std::endl;
+    auto tableIt = std::find_if(dbContent["tables"].begin(), dbContent["tables"].end(), [&statement](const nlohmann::json& table) {
+        return table["table_name"] == statement.table;
+    });
+    if (tableIt == dbContent["tables"].end()) {
+        std::cerr << "Error: Table '" << statement.table << "' not found in the database." << std::endl;
         return false;
     }
+    auto& table = *tableIt;
+    auto& rows = table["rows"];
 
-    try {
-        outputFile << std::setw(4) << dbContent << std::endl;
-    } catch (const std::exception& e) {
-        std::cerr << "Error: Failed to write JSON to file. Exception: " << e.what() << std::endl;
-        outputFile.close();
+    std::unique_ptr<RowPredicate> predicate;
+    if (!compileWhere(table, statement.where.get(), predicate)) {
         return false;
     }
 
-    outputFile.close();
+    if (!predicate) {
+        rows.clear();
+        if (!writeTable(databaseName, format, table)) {
+            std::cerr << "Error: Failed to write the database file." << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    std::cout << "Applying WHERE condition: " << whereToString(*statement.where) << std::endl;
+
+    // Deleted rows become null tombstones in place; surviving rows are not moved.
+    size_t tombstones = 0;
+    std::vector<std::uint64_t> deleted;
+    SelectionBitmap selected = selectRows(rows, *predicate);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (bitmapTest(selected, i)) {
+            rows[i] = nullptr;
+            deleted.push_back(i);
+        }
+        tombstones += rows[i].is_null();
+    }
+    if (deleted.empty()) {
+        return true;
+    }
+
+    // A JSON rows file only gets the indices appended to its tombstone file; columnar images
+    // drop tombstones when they are written, so they are re-encoded.
+    if (format == StorageFormat::JSON) {
+        if (!TombstoneFile::append(tableFilePath(databaseName, statement.table, format), deleted)) {
+            std::cerr << "Error: Failed to write the database file." << std::endl;
+            return false;
+        }
+        INIT_COMPACTION_MANAGER
+        compactionManager.noteTombstones(databaseName, statement.table, format, tombstones, rows.size() - tombstones);
+        return true;
+    }
+
+    if (!writeTable(databaseName, format, table)) {
+        std::cerr << "Error: Failed to write the database file." << std::endl;
+        return false;
+    }
     return true;
 }
 
-bool SQLManager::databaseFileExists(const std::string& databaseName) const {
-    std::string dbFilePath = "data/databases/" + databaseName + ".db.json";
-    return std::filesystem::exists(dbFilePath);
-}
+// Deletes matching rows page by page: each page is decoded, filtered and has its slots
+// erased in place, and only the modified pages are written back.
+bool SQLManager::deletePagedRecords(const DeleteStatement& statement, const std::string& databaseName) {
+    json schema;
+    if (!readDatabaseSchema(databaseName, schema)) {
+        std::cerr << "Error: Failed to read the database file." << std::endl;
+        return false;
+    }
 
-bool SQLManager::isNumeric(const std::string& str) {
-    try {
-        std::stod(str);
-    } catch (std::invalid_argument&) {
+    const json table = findTable(schema, statement.table);
+    if (table.empty()) {
+        std::cerr << "Error: Table '" << statement.table << "' not found in the database." << std::endl;
         return false;
-    } catch (std::out_of_range&) {
+    }
+
+    std::unique_ptr<RowPredicate> predicate;
+    if (!compileWhere(table, statement.where.get(), predicate)) {
         return false;
     }
+    if (predicate) {
+        std::cout << "Applying WHERE condition: " << whereToString(*statement.where) << std::endl;
+    }
+
+    PagedTable pagedTable(databaseName, statement.table);
+    size_t erasedSlots = 0;
+    size_t liveRows = 0;
+    bool success = pagedTable.forEachPage([this, &predicate, &erasedSlots, &liveRows](SlottedPage& page) {
+        std::vector<std::uint16_t> slots;
+        json rows = json::array();
+        PagedTable::decodePage(page, slots, rows);
+
+        SelectionBitmap selected;
+        if (predicate) {
+            selected = selectRows(rows, *predicate);
+        }
+        bool modified = false;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (!predicate || bitmapTest(selected, i)) {
+                page.erase(slots[i]);
+                modified = true;
+            }
+        }
+        erasedSlots += page.slotCount() - page.liveCount();
+        liveRows += page.liveCount();
+        return modified;
+    });
+    if (!success) {
+        return false;
+    }
+    if (!pagedTable.flush()) {
+        std::cerr << "Error: Failed to write the database file." << std::endl;
+        return false;
+    }
+    CompactionManager::getInstance().noteTombstones(databaseName, statement.table, StorageFormat::PAGED, erasedSlots, liveRows);
     return true;
 }
 
-bool SQLManager::deleteRecords(std::map<std::string, std::map<std::string, std::vector<std::string>>>& parsedArgs, std::string& currentDatabase) {
-    nlohmann::json dbContent;
+bool SQLManager::updateRecords(const UpdateStatement& statement, const std::string& databaseName) {
+    INIT_DB_MANAGER
+    IndexInvalidation invalidation(databaseName, statement.table);
+    const StorageFormat format = dbManager.getStorageFormat(databaseName);
+    if (format == StorageFormat::PAGED) {
+        return updatePagedRecords(statement, databaseName);
+    }
 
-    if (!readDatabaseFile(currentDatabase, dbContent)) {
+    nlohmann::json dbContent;
+    if (!readTables(databaseName, {statement.table}, dbContent)) {
         std::cerr << "Error: Failed to read the database file." << std::endl;
         return false;
     }
 
-    for (auto& [tableName, conditions] : parsedArgs) {
-
-        for (auto& table : dbContent["tables"]) {
-            if (table["table_name"] == tableName) {
-
-                auto& rows = table["rows"];
-
-                if (conditions.contains("WHERE")) {
-                    const auto& condition = conditions.at("WHERE");
-
-                    if (condition.size() == 3) {
-                        std::string column = condition[0];
-                        std::string op = condition[1];
-                        std::string value = condition[2];
-
-                        std::cout << "Applying WHERE condition: " << column << " " << op << " " << value << std::endl;
-
-                        std::vector<nlohmann::json> remainingRows;
-
-                        for (const auto& row : rows) {
-                            bool match = false;
-
-                            if (row.contains(column)) {
-                                auto columnValue = row[column];
-
-                                if (isNumeric(value) && columnValue.is_number()) {
-                                    double columnValueNum = columnValue.get<double>();
-                                    double compareValueNum = std::stod(value);
-
-                                    if (op == "=") {
-                                        match = (columnValueNum == compareValueNum);
-                                    } else if (op == "<") {
-                                        match = (columnValueNum < compareValueNum);
-                                    } else if (op == ">") {
-                                        match = (columnValueNum > compareValueNum);
-                                    } else if (op == "<=") {
-                                        match = (columnValueNum <= compareValueNum);
-                                    } else if (op == ">=") {
-                                        match = (columnValueNum >= compareValueNum);
-                                    }
-                                } else if (columnValue.is_string()) {
-                                    std::string columnValueStr = columnValue.get<std::string>();
-
-                                    if (op == "=") {
-                                        match = (columnValueStr == value);
-                                    } else if (op == "<") {
-                                        match = (columnValueStr < value);
-                                    } else if (op == ">") {
-                                        match = (columnValueStr > value);
-                                    } else if (op == "<=") {
-                                        match = (columnValueStr <= value);
-                                    } else if (op == ">=") {
-                                        match = (columnValueStr >= value);
-                                    }
-                                }
-                            }
+    auto tableIt = std::find_if(dbContent["tables"].begin(), dbContent["tables"].end(), [&statement](const nlohmann::json& table) {
+        return table["table_name"] == statement.table;
+    });
+    if (tableIt == dbContent["tables"].end()) {
+        std::cerr << "Error: Table '" << statement.table << "' not found in the database." << std::endl;
+        return false;
+    }
 
-                            if (!match) {
-                                remainingRows.push_back(row);  
-                            }
-                        }
+    auto& table = *tableIt;
+    auto& rows = table["rows"];
 
-                        rows = remainingRows;
+    std::vector<std::pair<std::string, nlohmann::json>> updates;
+    if (!compileUpdates(table["columns"], statement.assignments, updates)) {
+        return false;
+    }
 
-                    } else {
-                        std::cerr << "Error: Invalid WHERE clause format." << std::endl;
-                        return false;
-                    }
-                } else {
-                    rows.clear();
-                }
+    std::unique_ptr<RowPredicate> predicate;
+    if (!compileWhere(table, statement.where.get(), predicate)) {
+        return false;
+    }
 
-                break;
-            }
+    SelectionBitmap selected;
+    if (predicate) {
+        selected = selectRows(rows, *predicate);
+    }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (rows[i].is_null() || (predicate && !bitmapTest(selected, i))) {
+            continue;
+        }
+        for (const auto& [column, value] : updates) {
+            rows[i][column] = value;
         }
     }
-    if (!writeDatabaseFile(currentDatabase, dbContent)) {
-        std::cerr << "Error: Failed to write the database file." << std::endl;
+
+    if (!writeTable(databaseName, format, table)) {
+        std::cerr << "Error: Failed to write the updated database file." << std::endl;
         return false;
     }
-
     return true;
 }
 
-bool SQLManager::updateRecords(const std::map<std::string, std::map<std::string, std::vector<std::string>>>& parsedArgs, const std::string& databaseName) {
-    nlohmann::json dbContent;
-
-    if (!readDatabaseFile(databaseName, dbContent)) {
+// Updates rows in their slots; a row that grows beyond the free space of its page is
+// moved to the end of the table once the scan is done.
+bool SQLManager::updatePagedRecords(const UpdateStatement& statement, const std::string& databaseName) {
+    json schema;
+    if (!readDatabaseSchema(databaseName, schema)) {
         std::cerr << "Error: Failed to read the database file." << std::endl;
         return false;
     }
 
-    bool success = true;
+    const json table = findTable(schema, statement.table);
+    if (table.empty()) {
+        std::cerr << "Error: Table '" << statement.table << "' not found in the database." << std::endl;
+        return false;
+    }
 
-    for (auto& [tableName, conditions] : parsedArgs) {
-        auto tableIt = std::find_if(dbContent["tables"].begin(), dbContent["tables"].end(), [&tableName](const nlohmann::json& table) {
-            return table["table_name"] == tableName;
-        });
+    std::vector<std::pair<std::string, nlohmann::json>> updates;
+    if (!compileUpdates(table["columns"], statement.assignments, updates)) {
+        return false;
+    }
 
-        if (tableIt != dbContent["tables"].end()) {
-            auto& table = *tableIt;
-            auto& rows = table["rows"];
-            auto& columns = table["columns"];
-
-            std::map<std::string, std::string> updates;
-            if (conditions.contains("SET")) {
-                const auto& setConditions = conditions.at("SET");
-                if (setConditions.size() != 1 || conditions.at("VALUES").size() != 1) {
-                    std::cerr << "Error: SET clause must have exactly one column and one value." << std::endl;
-                    success = false;
-                    continue;
-                }
+    std::unique_ptr<RowPredicate> predicate;
+    if (!compileWhere(table, statement.where.get(), predicate)) {
+        return false;
+    }
+
+    std::vector<json> movedRows;
+    PagedTable pagedTable(databaseName, statement.table);
+    bool scanned = pagedTable.forEachPage([this, &predicate, &updates, &movedRows](SlottedPage& page) {
+        std::vector<std::uint16_t> slots;
+        json rows = json::array();
+        PagedTable::decodePage(page, slots, rows);
 
-                std::string column = setConditions[0];
-                std::string value = conditions.at("VALUES")[0];
-                updates[column] = value;
-            } else {
-                std::cerr << "Error: No SET clause found." << std::endl;
-                success = false;
+        SelectionBitmap selected;
+        if (predicate) {
+            selected = selectRows(rows, *predicate);
+        }
+        bool modified = false;
+        for (size_t i = 0; i < slots.size(); ++i) {
+            if (predicate && !bitmapTest(selected, i)) {
                 continue;
             }
-
-            nlohmann::json updatedRows = nlohmann::json::array();
-            if (conditions.contains("WHERE")) {
-                const auto& whereConditions = conditions.at("WHERE");
-
-                if (whereConditions.size() == 3 && whereConditions[1] == "=") {
-                    std::string whereColumn = whereConditions[0];
-                    std::string whereValue = whereConditions[2];
-
-                    for (auto& row : rows) {
-                        bool match = false;
-                        auto columnIt = std::find_if(columns.begin(), columns.end(), [&whereColumn](const nlohmann::json& col) {
-                            return col["name"] == whereColumn;
-                        });
-
-                        if (columnIt != columns.end()) {
-                            if ((*columnIt)["type"] == "int") {
-                                match = row[whereColumn] == std::stoi(whereValue);
-                            } else if ((*columnIt)["type"] == "string") {
-                                match = row[whereColumn] == whereValue;
-                            }
-                        }
-
-                        if (match) {
-                            for (const auto& [column, value] : updates) {
-                                auto columnType = std::find_if(columns.begin(), columns.end(), [&column](const nlohmann::json& col) {
-                                    return col["name"] == column;
-                                });
-
-                                if (columnType != columns.end()) {
-                                    if ((*columnType)["type"] == "int") {
-                                        row[column] = std::stoi(value);
-                                    } else if ((*columnType)["type"] == "string") {
-                                        row[column] = value;
-                                    }
-                                }
-                            }
-                        }
-                        updatedRows.push_back(row);
-                    }
-                } else {
-                    std::cerr << "Error: Invalid WHERE clause." << std::endl;
-                    success = false;
-                    continue;
-                }
-            } else {
-                for (auto& row : rows) {
-                    for (const auto& [column, value] : updates) {
-                        auto columnType = std::find_if(columns.begin(), columns.end(), [&column](const nlohmann::json& col) {
-                            return col["name"] == column;
-                        });
-
-                        if (columnType != columns.end()) {
-                            if ((*columnType)["type"] == "int") {
-                                row[column] = std::stoi(value);
-                            } else if ((*columnType)["type"] == "string") {
-                                row[column] = value;
-                            }
-                        }
-                    }
-                    updatedRows.push_back(row);
-                }
+            for (const auto& [column, value] : updates) {
+                rows[i][column] = value;
             }
-
-            table["rows"] = updatedRows;
-            *tableIt = table;
-        } else {
-            std::cerr << "Error: Table '" << tableName << "' not found in the database." << std::endl;
-            success = false;
+            if (!page.update(slots[i], PagedTable::encodeRow(rows[i]))) {
+                page.erase(slots[i]);
+                movedRows.push_back(std::move(rows[i]));
+            }
+            modified = true;
         }
-    }
+        return modified;
+    });
 
-    if (!writeDatabaseFile(databaseName, dbContent)) {
+    for (const auto& row : movedRows) {
+        scanned = scanned && pagedTable.appendRow(row);
+    }
+    if (!pagedTable.flush()) {
         std::cerr << "Error: Failed to write the updated database file." << std::endl;
-        success = false;
+        scanned = false;
     }
-
-    return success;
+    return scanned;
 }
@@ -8,44 +8,87 @@
 #include <iomanip>
 #include <filesystem>
 #include <map>
+#include <set>
 #include <vector>
-#include <regex>
+#include <functional>
 #include "utils.h"
 #include "selectVariables.h"
+#include "parser/sqlParser.h"
+#include "sqlManager/wherePredicate.h"
+#include "sqlManager/filterKernels.h"
+#include "sqlManager/compactionManager.h"
+#include "sqlManager/constraintIndex.h"
+#include "databaseManager/databaseManager.h"
+#include "storageManager/columnarFormat.h"
+#include "storageManager/mappedFile.h"
+#include "storageManager/pagedTable.h"
+#include "storageManager/jsonFileWriter.h"
+#include "storageManager/snapshotFile.h"
+#include "storageManager/tombstoneFile.h"
 
 using json = nlohmann::json;
 using ResultTableColumns = std::map<std::string, std::map<std::string, std::vector<std::string>>>;
+// Called with each row of a scan; returning false ends the scan.
+using RowVisitor = std::function<bool(const json& row)>;
 class SQLManager {
 public:
     static SQLManager& getInstance() {
         static SQLManager instance;
         return instance;
     }
-    bool deleteRecords(std::map<std::string, std::map<std::string, std::vector<std::string>>>& parsedArgs, std::string& currentDatabase);
-    bool isNumeric(const std::string& str);
+    bool deleteRecords(const DeleteStatement& statement, const std::string& databaseName);
     bool createDatabase(const std::string& databaseName);
     bool deleteDatabase(const std::string& databaseName);
     bool createTable(const std::string& databaseName, const std::string& tableName, const json& columns);
     bool addRow(const std::string& databaseName, const std::string& tableName, const nlohmann::json& row);
     bool deleteRow(const std::string& databaseName, const std::string& tableName, const std::string& primaryKey);
     bool databaseFileExists(const std::string& databaseName) const;
-    bool insertIntoTable(const std::string& databaseName, const std::string& tableName, const std::map<std::string, std::string>& columnValueMap);
+    // Each row holds the values of columns, in order; all rows are written or none.
+    bool insertRows(const std::string& databaseName, const std::string& tableName, const std::vector<std::string>& columns, const std::vector<std::vector<std::string>>& rows);
+    // Rows already converted to the column types, one JSON object per row.
+    bool insertTypedRows(const std::string& databaseName, const std::string& tableName, json rows);
     json findTable(const json& dbContent, const std::string& tableName);
     std::vector<nlohmann::json> findRecords(const nlohmann::json& rows, const std::string& column, const std::string& op, const std::string& value);
     bool readDatabaseFile(const std::string& databaseName, json& dbContent);
     bool writeDatabaseFile(const std::string& databaseName, const json& dbContent);
+    bool readDatabaseFile(const std::string& databaseName, StorageFormat format, json& dbContent);
+    bool writeDatabaseFile(const std::string& databaseName, StorageFormat format, const json& dbContent);
+    bool readDatabaseSchema(const std::string& databaseName, json& dbContent);
+    bool writeDatabaseSchema(const std::string& databaseName, const json& dbContent);
+    bool readTables(const std::string& databaseName, const std::set<std::string>& tableNames, json& dbContent);
+    bool readTableRows(const std::string& databaseName, StorageFormat format, const std::string& tableName, json& rows);
+    bool writeTable(const std::string& databaseName, StorageFormat format, const json& table);
+    // Hands the live rows of a table matching where to visitor in storage order, at most limit
+    // of them (all when negative). Only one page or row is decoded at a time.
+    bool scanTableRows(const std::string& databaseName, const std::string& tableName, const WhereExpr* where, long long limit, const RowVisitor& visitor);
+    void removeTableFiles(const std::string& databaseName, StorageFormat format, const json& dbContent);
+    bool dropTable(const std::string& databaseName, const std::string& tableName);
+    void migrateLegacyDatabaseFiles();
+    void normalizeStoredStrings();
 
     std::map<std::string, std::map<std::string, std::vector<std::string>>> getTableAndColumnFromDatabaseForJoins(const std::string& databaseName, const std::vector<Join>& joinData);
-    ResultTableColumns getTableAndColumnFromDatabase(const std::string& databaseName, const std::map<std::string, std::vector<std::string>>& tableColumnMap);
+    // where, when given, filters the rows of filterTable.
+    ResultTableColumns getTableAndColumnFromDatabase(const std::string& databaseName, const std::map<std::string, std::vector<std::string>>& tableColumnMap, const std::string& filterTable = "", const WhereExpr* where = nullptr);
 
     bool applyUpdates(nlohmann::json& rows, const std::map<std::string, std::string>& updates, const std::map<std::string, std::string>& whereConditions);
-    bool updateRecords(const std::map<std::string, std::map<std::string, std::vector<std::string>>>& parsedArgs, const std::string& databaseName);
+    bool updateRecords(const UpdateStatement& statement, const std::string& databaseName);
+    SelectionBitmap selectRows(const json& rows, const RowPredicate& predicate);
+    SelectionBitmap selectColumnRows(const ColumnarFormat::TableView& table, const RowPredicate& predicate);
 private:
     SQLManager() = default;
     SQLManager(const SQLManager&) = delete;
     SQLManager& operator=(const SQLManager&) = delete;
 
     json queryDatabase(const std::string& query);
+    bool compileWhere(const json& table, const WhereExpr* where, std::unique_ptr<RowPredicate>& predicate);
+    // known receives the rows whose result is true or false rather than unknown.
+    SelectionBitmap selectRows(const json& rows, const RowPredicate& predicate, SelectionBitmap& known);
+    SelectionBitmap selectColumnRows(const ColumnarFormat::TableView& table, const RowPredicate& predicate, SelectionBitmap& known);
+    bool compileUpdates(const json& columns, const std::vector<Assignment>& assignments, std::vector<std::pair<std::string, json>>& updates);
+    bool deletePagedRecords(const DeleteStatement& statement, const std::string& databaseName);
+    bool updatePagedRecords(const UpdateStatement& statement, const std::string& databaseName);
+    ResultTableColumns getTableAndColumnFromPagedFile(const std::string& databaseName, const std::map<std::string, std::vector<std::string>>& tableColumnMap, const std::string& filterTable, const WhereExpr* where);
+    ResultTableColumns getTableAndColumnFromColumnarFile(const std::string& databaseName, const std::map<std::string, std::vector<std::string>>& tableColumnMap, const std::string& filterTable, const WhereExpr* where);
 
     void parseWhereClause(const std::string& whereClause, std::string& whereColumn, std::string& whereValue, bool& whereIsString);
     json processJoin(const json& dbContent, const std::string& joinType, const std::string& joinTable);
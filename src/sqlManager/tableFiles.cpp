@@ -0,0 +1,547 @@
+#include "sqlManager/sqlManager.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <filesystem>
+#include <algorithm>
+
+// Storage layout of a database: data/databases/(databasename)/schema.json lists the tables
+// and their columns, and each table keeps its rows in a file of its own. Reading or writing
+// one table never touches the files of the others.
+
+namespace {
+
+// Version 2 schemas hold string values as their plain text. Earlier versions stored a
+// single-quoted INSERT literal with its quotes, as in "'abc'".
+constexpr int SCHEMA_VERSION = 2;
+
+// Removes the quotes earlier versions kept around string values. True when a value changed.
+bool unquoteStoredStrings(json& dbContent) {
+    bool changed = false;
+    for (auto& table : dbContent["tables"]) {
+        for (const auto& column : table["columns"]) {
+            if (column.value("type", "") != "string") {
+                continue;
+            }
+            const std::string& name = column["name"].get_ref<const std::string&>();
+            for (auto& row : table["rows"]) {
+                auto cell = row.find(name);
+                if (cell == row.end() || !cell->is_string()) {
+                    continue;
+                }
+                std::string& text = cell->get_ref<std::string&>();
+                if (text.size() >= 2 && text.front() == '\'' && text.back() == '\'') {
+                    text = text.substr(1, text.size() - 2);
+                    changed = true;
+                }
+            }
+        }
+    }
+    return changed;
+}
+
+bool isJsonSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Hands the text of each element of the top-level JSON array in text to visit, in order,
+// until visit returns false. Only brackets and strings are tracked to find where an element
+// ends; the caller parses the element. False when text is not an array.
+bool forEachArrayElement(std::string_view text, const std::function<bool(std::string_view)>& visit) {
+    size_t pos = 0;
+    while (pos < text.size() && isJsonSpace(text[pos])) {
+        ++pos;
+    }
+    if (pos == text.size() || text[pos++] != '[') {
+        return false;
+    }
+    for (bool first = true; pos < text.size(); first = false) {
+        size_t start = pos;
+        size_t depth = 0;
+        bool inString = false;
+        for (; pos < text.size(); ++pos) {
+            char c = text[pos];
+            if (inString) {
+                if (c == '\\') {
+                    ++pos;
+                } else if (c == '"') {
+                    inString = false;
+                }
+            } else if (c == '"') {
+                inString = true;
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if ((c == '}' || c == ']') && depth > 0) {
+                --depth;
+            } else if ((c == ',' || c == ']') && depth == 0) {
+                break;
+            }
+        }
+        if (pos >= text.size()) {
+            return false;
+        }
+        std::string_view element = text.substr(start, pos - start);
+        while (!element.empty() && isJsonSpace(element.front())) {
+            element.remove_prefix(1);
+        }
+        while (!element.empty() && isJsonSpace(element.back())) {
+            element.remove_suffix(1);
+        }
+        bool last = text[pos++] == ']';
+        if (element.empty()) {
+            // Only an empty array may have no element before its closing bracket.
+            return last && first;
+        }
+        if (!visit(element) || last) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+bool SQLManager::readDatabaseFile(const std::string& databaseName, nlohmann::json& dbContent) {
+    INIT_DB_MANAGER
+    return readDatabaseFile(databaseName, dbManager.getStorageFormat(databaseName), dbContent);
+}
+
+bool SQLManager::writeDatabaseFile(const std::string& databaseName, const nlohmann::json& dbContent) {
+    INIT_DB_MANAGER
+    return writeDatabaseFile(databaseName, dbManager.getStorageFormat(databaseName), dbContent);
+}
+
+bool SQLManager::readDatabaseFile(const std::string& databaseName, StorageFormat format, nlohmann::json& dbContent) {
+    if (!readDatabaseSchema(databaseName, dbContent)) {
+        return false;
+    }
+    for (auto& table : dbContent["tables"]) {
+        if (!readTableRows(databaseName, format, table["table_name"].get<std::string>(), table["rows"])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SQLManager::writeDatabaseFile(const std::string& databaseName, StorageFormat format, const nlohmann::json& dbContent) {
+    std::error_code error;
+    std::filesystem::create_directories(databaseDirectory(databaseName), error);
+    if (error) {
+        std::cerr << "Error: Failed to create directory for database '" << databaseName << "': " << error.message() << std::endl;
+        return false;
+    }
+    for (const auto& table : dbContent["tables"]) {
+        if (!writeTable(databaseName, format, table)) {
+            return false;
+        }
+    }
+    return writeDatabaseSchema(databaseName, dbContent);
+}
+
+// Table names and columns, each table carrying an empty "rows" array. Served from the
+// DatabaseManager schema cache, so no row data is read.
+bool SQLManager::readDatabaseSchema(const std::string& databaseName, json& dbContent) {
+    INIT_DB_MANAGER
+    std::shared_ptr<const json> schema = dbManager.getSchema(databaseName);
+    if (!schema) {
+        std::cerr << "Error: Failed to read schema file '" << schemaFilePath(databaseName) << "'." << std::endl;
+        return false;
+    }
+
+    dbContent = *schema;
+    for (auto& table : dbContent["tables"]) {
+        table["rows"] = json::array();
+    }
+    return true;
+}
+
+// schema.json is written as a snapshot, so readers that skip the database lock never see
+// a partially written file.
+bool SQLManager::writeDatabaseSchema(const std::string& databaseName, const json& dbContent) {
+    INIT_DB_MANAGER
+    json schema = {
+        {"database_name", dbContent.value("database_name", databaseName)},
+        {"version", SCHEMA_VERSION},
+        {"tables", json::array()}
+    };
+    for (const auto& table : dbContent["tables"]) {
+        schema["tables"].push_back({
+            {"table_name", table["table_name"]},
+            {"columns", table["columns"]}
+        });
+    }
+
+    if (!JsonFileWriter::writeFile(schemaFilePath(databaseName), schema)) {
+        return false;
+    }
+    dbManager.cacheSchema(databaseName, schema);
+    return true;
+}
+
+// The schema plus the rows of the named tables only; other tables keep empty rows.
+bool SQLManager::readTables(const std::string& databaseName, const std::set<std::string>& tableNames, json& dbContent) {
+    INIT_DB_MANAGER
+    if (!readDatabaseSchema(databaseName, dbContent)) {
+        return false;
+    }
+    StorageFormat format = dbManager.getStorageFormat(databaseName);
+    for (auto& table : dbContent["tables"]) {
+        std::string tableName = table["table_name"];
+        if (tableNames.count(tableName) && !readTableRows(databaseName, format, tableName, table["rows"])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SQLManager::readTableRows(const std::string& databaseName, StorageFormat format, const std::string& tableName, json& rows) {
+    if (format == StorageFormat::PAGED) {
+        PagedTable pagedTable(databaseName, tableName);
+        return pagedTable.load(rows);
+    }
+
+    std::string tablePath = tableFilePath(databaseName, tableName, format);
+    MappedFile file;
+    if (!file.open(tablePath)) {
+        std::cerr << "Error: Failed to open table file '" << tablePath << "'." << std::endl;
+        return false;
+    }
+
+    if (format == StorageFormat::COLUMNAR) {
+        json image;
+        if (!ColumnarFormat::decodeDatabase(file.data(), file.size(), image) || image["tables"].empty()) {
+            std::cerr << "Error: Failed to decode columnar file '" << tablePath << "'." << std::endl;
+            return false;
+        }
+        rows = std::move(image["tables"][0]["rows"]);
+        return true;
+    }
+
+    try {
+        std::string_view text = file.view();
+        rows = json::parse(text.begin(), text.end());
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Failed to parse JSON from file '" << tablePath << "': " << e.what() << std::endl;
+        return false;
+    }
+    std::vector<std::uint64_t> deleted;
+    if (!TombstoneFile::read(tablePath, deleted)) {
+        return false;
+    }
+    TombstoneFile::apply(rows, deleted);
+    return true;
+}
+
+// Paged tables are read page by page through the buffer pool and columnar images are read
+// in place. A JSON rows file is split into its rows and each is parsed, handed over and
+// dropped in turn, so memory does not grow with the table.
+bool SQLManager::scanTableRows(const std::string& databaseName, const std::string& tableName, const WhereExpr* where, long long limit, const RowVisitor& visitor) {
+    INIT_DB_MANAGER
+    StorageFormat format = dbManager.getStorageFormat(databaseName);
+    std::shared_ptr<const json> schema = dbManager.getSchema(databaseName);
+    if (!schema) {
+        std::cerr << "Error: Failed to read schema file '" << schemaFilePath(databaseName) << "'." << std::endl;
+        return false;
+    }
+    json table = findTable(*schema, tableName);
+    if (table.is_null()) {
+        std::cerr << "Error: Table '" << tableName << "' does not exist in database '" << databaseName << "'." << std::endl;
+        return false;
+    }
+    std::unique_ptr<RowPredicate> predicate;
+    if (!compileWhere(table, where, predicate)) {
+        return false;
+    }
+
+    long long visited = 0;
+    bool done = limit == 0;
+    auto visit = [&](const json& row) {
+        if (done || !row.is_object() || (predicate && !predicate->matches(row))) {
+            return;
+        }
+        done = !visitor(row) || (limit > 0 && ++visited >= limit);
+    };
+
+    if (format == StorageFormat::PAGED) {
+        PagedTable pagedTable(databaseName, tableName);
+        return pagedTable.forEachPage([this, &predicate, &visitor, &visited, &done, limit](SlottedPage& page) {
+            if (done) {
+                return false;
+            }
+            std::vector<std::uint16_t> slots;
+            json rows = json::array();
+            PagedTable::decodePage(page, slots, rows);
+            // A whole page is decoded at once, so it is filtered with the vectorized scan.
+            SelectionBitmap selected;
+            if (predicate) {
+                selected = selectRows(rows, *predicate);
+            }
+            for (size_t i = 0; i < rows.size() && !done; ++i) {
+                if (!predicate || bitmapTest(selected, i)) {
+                    done = !visitor(rows[i]) || (limit > 0 && ++visited >= limit);
+                }
+            }
+            return false;
+        });
+    }
+
+    std::string tablePath = tableFilePath(databaseName, tableName, format);
+    MappedFile file;
+    if (!file.open(tablePath)) {
+        std::cerr << "Error: Failed to open table file '" << tablePath << "'." << std::endl;
+        return false;
+    }
+
+    if (format == StorageFormat::COLUMNAR) {
+        ColumnarFormat::DatabaseView view;
+        const ColumnarFormat::TableView* image = nullptr;
+        if (!view.open(file.data(), file.size()) || !(image = view.findTable(tableName))) {
+            std::cerr << "Error: Failed to decode columnar file '" << tablePath << "'." << std::endl;
+            return false;
+        }
+        SelectionBitmap selected;
+        if (predicate) {
+            selected = selectColumnRows(*image, *predicate);
+        }
+        for (std::uint64_t index = 0; index < image->rowCount && !done; ++index) {
+            if (!predicate || bitmapTest(selected, index)) {
+                done = !visitor(image->rowAt(index)) || (limit > 0 && ++visited >= limit);
+            }
+        }
+        return true;
+    }
+
+    // Rows deleted through the tombstone file are skipped by their position in the array.
+    std::vector<std::uint64_t> deleted;
+    if (!TombstoneFile::read(tablePath, deleted)) {
+        return false;
+    }
+    std::sort(deleted.begin(), deleted.end());
+
+    // Each row is parsed on its own, so the scan ends as soon as the limit is reached.
+    std::uint64_t index = 0;
+    bool corrupt = false;
+    bool parsed = forEachArrayElement(file.view(), [&](std::string_view element) {
+        json row = json::parse(element.begin(), element.end(), nullptr, false);
+        if (row.is_discarded()) {
+            corrupt = true;
+            return false;
+        }
+        if (!std::binary_search(deleted.begin(), deleted.end(), index++)) {
+            visit(row);
+        }
+        return !done;
+    });
+    if (!parsed || corrupt) {
+        std::cerr << "Error: Failed to parse JSON from file '" << tablePath << "'." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Replaces the rows file of one table. JSON and columnar files are written as snapshots, so
+// readers always map a complete file; the table's columns are needed by the columnar encoder.
+bool SQLManager::writeTable(const std::string& databaseName, StorageFormat format, const json& table) {
+    std::string tableName = table["table_name"];
+    if (!isValidStorageName(tableName)) {
+        std::cerr << "Error: Invalid table name '" << tableName << "'." << std::endl;
+        return false;
+    }
+    if (format == StorageFormat::PAGED) {
+        PagedTable pagedTable(databaseName, tableName);
+        return pagedTable.store(table["rows"]);
+    }
+
+    std::string tablePath = tableFilePath(databaseName, tableName, format);
+    if (format == StorageFormat::COLUMNAR) {
+        std::string data;
+        json image = {
+            {"database_name", databaseName},
+            {"tables", json::array({table})}
+        };
+        if (!ColumnarFormat::encodeDatabase(image, data)) {
+            std::cerr << "Error: Failed to encode table '" << tableName << "' in columnar format." << std::endl;
+            return false;
+        }
+        return SnapshotFile::write(tablePath, data);
+    }
+
+    try {
+        return JsonFileWriter::writeFile(tablePath, table["rows"]);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Failed to write JSON to file. Exception: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+void SQLManager::removeTableFiles(const std::string& databaseName, StorageFormat format, const json& dbContent) {
+    for (const auto& table : dbContent["tables"]) {
+        std::string tablePath = tableFilePath(databaseName, table["table_name"].get<std::string>(), format);
+        if (format == StorageFormat::PAGED) {
+            BufferPool::getInstance().discard(tablePath);
+        }
+        if (format == StorageFormat::JSON) {
+            TombstoneFile::remove(tablePath);
+        }
+        std::error_code error;
+        std::filesystem::remove(tablePath, error);
+    }
+}
+
+bool SQLManager::dropTable(const std::string& databaseName, const std::string& tableName) {
+    INIT_DB_MANAGER
+    json dbContent;
+    if (!readDatabaseSchema(databaseName, dbContent)) {
+        std::cerr << "Error: Failed to read database file for database '" << databaseName << "'." << std::endl;
+        return false;
+    }
+
+    auto& tables = dbContent["tables"];
+    auto tableIt = std::find_if(tables.begin(), tables.end(), [&tableName](const json& table) {
+        return table["table_name"] == tableName;
+    });
+    if (tableIt == tables.end()) {
+        std::cerr << "Error: Table '" << tableName << "' does not exist in database '" << databaseName << "'." << std::endl;
+        return false;
+    }
+
+    json dropped = {{"tables", json::array({*tableIt})}};
+    tables.erase(tableIt);
+    if (!writeDatabaseSchema(databaseName, dbContent)) {
+        std::cerr << "Error: Failed to write database file for database '" << databaseName << "'." << std::endl;
+        return false;
+    }
+    removeTableFiles(databaseName, dbManager.getStorageFormat(databaseName), dropped);
+    return true;
+}
+
+bool SQLManager::createDatabase(const std::string& databaseName) {
+    std::string dbDirectory = databaseDirectory(databaseName);
+    if (std::filesystem::exists(schemaFilePath(databaseName))) {
+        std::cerr << "Error: Database directory '" << dbDirectory << "' already exists." << std::endl;
+        return false;
+    }
+
+    nlohmann::json dbContent = {
+        {"database_name", databaseName},
+        {"tables", nlohmann::json::array()}
+    };
+
+    return writeDatabaseFile(databaseName, dbContent);
+}
+
+bool SQLManager::deleteDatabase(const std::string& databaseName) {
+    std::string dbDirectory = databaseDirectory(databaseName);
+    if (!std::filesystem::exists(dbDirectory)) {
+        std::cerr << "Error: No database found at " << dbDirectory << "\n";
+        return false;
+    }
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(dbDirectory, error)) {
+        if (entry.path().extension() == ".pages") {
+            BufferPool::getInstance().discard(entry.path().string());
+        }
+    }
+    std::filesystem::remove_all(dbDirectory, error);
+    if (error) {
+        std::cerr << "Error: Unable to delete the database directory: " << dbDirectory << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool SQLManager::databaseFileExists(const std::string& databaseName) const {
+    return std::filesystem::exists(schemaFilePath(databaseName));
+}
+
+// Databases written before the per-table layout live in a single data/databases/(name).db.json,
+// (name).db.bin or (name).db.pages file; they are split into a directory the first time the
+// program starts, keeping their storage format.
+void SQLManager::migrateLegacyDatabaseFiles() {
+    const std::string dbDirectory = "data/databases";
+    std::error_code error;
+    std::vector<std::filesystem::path> legacyFiles;
+    for (const auto& entry : std::filesystem::directory_iterator(dbDirectory, error)) {
+        std::string fileName = entry.path().filename().string();
+        if (entry.is_regular_file() && (fileName.ends_with(".db.json") || fileName.ends_with(".db.bin") || fileName.ends_with(".db.pages"))) {
+            legacyFiles.push_back(entry.path());
+        }
+    }
+
+    for (const auto& legacyPath : legacyFiles) {
+        std::string fileName = legacyPath.filename().string();
+        StorageFormat format = StorageFormat::JSON;
+        std::string databaseName = fileName.substr(0, fileName.size() - 8);
+        if (fileName.ends_with(".db.bin")) {
+            format = StorageFormat::COLUMNAR;
+            databaseName = fileName.substr(0, fileName.size() - 7);
+        } else if (fileName.ends_with(".db.pages")) {
+            format = StorageFormat::PAGED;
+            databaseName = fileName.substr(0, fileName.size() - 9);
+        }
+        if (std::filesystem::exists(databaseDirectory(databaseName))) {
+            continue;
+        }
+
+        MappedFile file;
+        json dbContent;
+        bool decoded = false;
+        if (file.open(legacyPath.string())) {
+            if (format == StorageFormat::COLUMNAR) {
+                decoded = ColumnarFormat::decodeDatabase(file.data(), file.size(), dbContent);
+            } else if (format == StorageFormat::PAGED) {
+                decoded = PagedTable::readLegacyDatabase(databaseName, file.view(), dbContent);
+            } else {
+                std::string_view text = file.view();
+                dbContent = json::parse(text.begin(), text.end(), nullptr, false);
+                decoded = !dbContent.is_discarded();
+            }
+        }
+        file.close();
+
+        if (decoded) {
+            unquoteStoredStrings(dbContent);
+        }
+        if (!decoded || !writeDatabaseFile(databaseName, format, dbContent)) {
+            std::cerr << "Error: Failed to migrate database file '" << legacyPath.string() << "'." << std::endl;
+            continue;
+        }
+        std::filesystem::remove(legacyPath, error);
+        std::cout << "Database '" << databaseName << "' moved to " << databaseDirectory(databaseName) << "/." << std::endl;
+    }
+}
+
+// Databases written before schema version 2 hold single-quoted strings with their quotes.
+// Their rows are rewritten once with the quotes removed, so they compare equal to the plain
+// text INSERT, UPDATE and WHERE use; the new schema version marks them as done.
+void SQLManager::normalizeStoredStrings() {
+    INIT_DB_MANAGER
+    const std::string dbDirectory = "data/databases";
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(dbDirectory, error)) {
+        std::string databaseName = entry.path().filename().string();
+        if (!entry.is_directory() || !std::filesystem::exists(schemaFilePath(databaseName))) {
+            continue;
+        }
+        std::shared_ptr<const json> schema = dbManager.getSchema(databaseName);
+        if (!schema || schema->value("version", 1) >= SCHEMA_VERSION) {
+            continue;
+        }
+
+        json dbContent;
+        StorageFormat format = dbManager.getStorageFormat(databaseName);
+        if (!readDatabaseFile(databaseName, format, dbContent)) {
+            std::cerr << "Error: Failed to normalize strings of database '" << databaseName << "'." << std::endl;
+            continue;
+        }
+        bool changed = unquoteStoredStrings(dbContent);
+        if (changed ? !writeDatabaseFile(databaseName, format, dbContent) : !writeDatabaseSchema(databaseName, dbContent)) {
+            std::cerr << "Error: Failed to normalize strings of database '" << databaseName << "'." << std::endl;
+            continue;
+        }
+        if (changed) {
+            std::cout << "Database '" << databaseName << "' now stores strings without quotes." << std::endl;
+        }
+    }
+}
@@ -0,0 +1,145 @@
+#include "sqlManager/wherePredicate.h"
+#include <iostream>
+#include <charconv>
+#include <cctype>
+#include <algorithm>
+
+bool parseCompareOp(const std::string& op, CompareOp& result) {
+    if (op == "=") {
+        result = CompareOp::EQUAL;
+    } else if (op == "!=" || op == "<>") {
+        result = CompareOp::NOT_EQUAL;
+    } else if (op == "<") {
+        result = CompareOp::LESS;
+    } else if (op == ">") {
+        result = CompareOp::GREATER;
+    } else if (op == "<=") {
+        result = CompareOp::LESS_EQUAL;
+    } else if (op == ">=") {
+        result = CompareOp::GREATER_EQUAL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool parseDate(const std::string& str, DateValue& result) {
+    if (str.size() != 10 || str[4] != '-' || str[7] != '-') {
+        return false;
+    }
+    for (size_t i = 0; i < str.size(); ++i) {
+        if (i != 4 && i != 7 && !std::isdigit(static_cast<unsigned char>(str[i]))) {
+            return false;
+        }
+    }
+    int month = std::stoi(str.substr(5, 2));
+    int day = std::stoi(str.substr(8, 2));
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+    result.iso = str;
+    return true;
+}
+
+static bool parseInteger(const std::string& str, long long& result) {
+    const char* begin = str.data();
+    const char* end = str.data() + str.size();
+    if (begin != end && *begin == '+') {
+        ++begin;
+    }
+    auto [ptr, ec] = std::from_chars(begin, end, result);
+    return ec == std::errc() && ptr == end;
+}
+
+bool convertLiteral(const std::string& columnType, const std::string& literal, json& result) {
+    if (columnType == "int") {
+        long long value;
+        if (!parseInteger(literal, value)) {
+            return false;
+        }
+        result = value;
+    } else if (columnType == "date") {
+        DateValue value;
+        if (!parseDate(literal, value)) {
+            return false;
+        }
+        result = value.iso;
+    } else if (columnType == "string") {
+        result = literal;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+static std::unique_ptr<RowPredicate> makePredicate(const std::string& column, CompareOp op, typename ColumnTraits<T>::ValueType literal) {
+    switch (op) {
+        case CompareOp::EQUAL:
+            return std::make_unique<TypedPredicate<T, std::equal_to<>>>(column, op, std::move(literal));
+        case CompareOp::NOT_EQUAL:
+            return std::make_unique<TypedPredicate<T, std::not_equal_to<>>>(column, op, std::move(literal));
+        case CompareOp::LESS:
+            return std::make_unique<TypedPredicate<T, std::less<>>>(column, op, std::move(literal));
+        case CompareOp::GREATER:
+            return std::make_unique<TypedPredicate<T, std::greater<>>>(column, op, std::move(literal));
+        case CompareOp::LESS_EQUAL:
+            return std::make_unique<TypedPredicate<T, std::less_equal<>>>(column, op, std::move(literal));
+        case CompareOp::GREATER_EQUAL:
+            return std::make_unique<TypedPredicate<T, std::greater_equal<>>>(column, op, std::move(literal));
+    }
+    return nullptr;
+}
+
+std::unique_ptr<RowPredicate> compileWherePredicate(const json& tableColumns, const std::string& column, const std::string& op, const std::string& literal) {
+    auto columnIt = std::find_if(tableColumns.begin(), tableColumns.end(), [&column](const json& col) {
+        return col["name"] == column;
+    });
+    if (columnIt == tableColumns.end()) {
+        std::cerr << "Error: Column '" << column << "' in WHERE clause does not exist." << std::endl;
+        return nullptr;
+    }
+
+    CompareOp compareOp;
+    if (!parseCompareOp(op, compareOp)) {
+        std::cerr << "Error: Unsupported operator '" << op << "' in WHERE clause." << std::endl;
+        return nullptr;
+    }
+
+    std::string columnType = (*columnIt)["type"];
+    json value;
+    if (!convertLiteral(columnType, literal, value)) {
+        std::cerr << "Error: Invalid " << columnType << " value '" << literal << "' in WHERE clause for column '" << column << "'." << std::endl;
+        return nullptr;
+    }
+
+    if (columnType == "int") {
+        return makePredicate<int>(column, compareOp, value.get<long long>());
+    } else if (columnType == "date") {
+        return makePredicate<DateValue>(column, compareOp, value.get<std::string>());
+    }
+    return makePredicate<std::string>(column, compareOp, value.get<std::string>());
+}
+
+std::unique_ptr<RowPredicate> compileWhereExpression(const json& tableColumns, const std::string& tableName, const WhereExpr& expr) {
+    if (expr.kind == WhereExpr::Kind::COMPARISON) {
+        if (!expr.column.table.empty() && expr.column.table != tableName) {
+            std::cerr << "Error: Column '" << expr.column.table << "." << expr.column.column << "' in WHERE clause does not belong to table '" << tableName << "'." << std::endl;
+            return nullptr;
+        }
+        return compileWherePredicate(tableColumns, expr.column.column, expr.op, expr.literal.text);
+    }
+
+    std::unique_ptr<RowPredicate> left = compileWhereExpression(tableColumns, tableName, *expr.left);
+    if (!left) {
+        return nullptr;
+    }
+    if (expr.kind == WhereExpr::Kind::NOT) {
+        return std::make_unique<LogicalPredicate>(expr.kind, std::move(left));
+    }
+    std::unique_ptr<RowPredicate> right = compileWhereExpression(tableColumns, tableName, *expr.right);
+    if (!right) {
+        return nullptr;
+    }
+    return std::make_unique<LogicalPredicate>(expr.kind, std::move(left), std::move(right));
+}
@@ -0,0 +1,187 @@
+#ifndef WHERE_PREDICATE_H
+#define WHERE_PREDICATE_H
+
+#include <string>
+#include <memory>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include "parser/ast.h"
+
+using json = nlohmann::json;
+
+enum class CompareOp {
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    GREATER,
+    LESS_EQUAL,
+    GREATER_EQUAL
+};
+
+// Dates are stored as "YYYY-MM-DD" strings, which order correctly when compared lexicographically.
+struct DateValue {
+    std::string iso;
+};
+
+bool parseCompareOp(const std::string& op, CompareOp& result);
+bool parseDate(const std::string& str, DateValue& result);
+
+// `column op literal` over an int column, exposed so scans can run it as a vectorized kernel.
+struct IntComparison {
+    std::string column;
+    CompareOp op;
+    long long literal;
+};
+
+class LogicalPredicate;
+
+// A WHERE condition follows SQL's three-valued logic: a comparison on a NULL or missing
+// column is neither true nor false but unknown, and NOT of an unknown stays unknown.
+// matches() is true only for rows the condition holds on; known() tells false from unknown.
+class RowPredicate {
+public:
+    virtual ~RowPredicate() = default;
+    virtual bool matches(const json& row) const = 0;
+    virtual bool known(const json& row) const = 0;
+    virtual const IntComparison* intComparison() const { return nullptr; }
+    virtual const LogicalPredicate* logical() const { return nullptr; }
+};
+
+// AND, OR and NOT over compiled predicates. Scans combine the selection bitmaps of the
+// operands, so each comparison underneath can still run as a vectorized kernel.
+class LogicalPredicate : public RowPredicate {
+public:
+    using Kind = WhereExpr::Kind;
+
+    LogicalPredicate(Kind kind, std::unique_ptr<RowPredicate> left, std::unique_ptr<RowPredicate> right = nullptr)
+        : kind(kind), leftOperand(std::move(left)), rightOperand(std::move(right)) {}
+
+    bool matches(const json& row) const override {
+        switch (kind) {
+            case Kind::AND:
+                return leftOperand->matches(row) && rightOperand->matches(row);
+            case Kind::OR:
+                return leftOperand->matches(row) || rightOperand->matches(row);
+            default:
+                return leftOperand->known(row) && !leftOperand->matches(row);
+        }
+    }
+
+    // AND is false when either side is false and OR is true when either side is true, even
+    // if the other side is unknown.
+    bool known(const json& row) const override {
+        if (kind == Kind::NOT) {
+            return leftOperand->known(row);
+        }
+        bool leftKnown = leftOperand->known(row);
+        bool rightKnown = rightOperand->known(row);
+        bool decided = kind == Kind::OR;
+        return (leftKnown && rightKnown) ||
+               (leftKnown && leftOperand->matches(row) == decided) ||
+               (rightKnown && rightOperand->matches(row) == decided);
+    }
+
+    const LogicalPredicate* logical() const override { return this; }
+
+    Kind operation() const { return kind; }
+    const RowPredicate& left() const { return *leftOperand; }
+    const RowPredicate& right() const { return *rightOperand; }
+
+private:
+    Kind kind;
+    std::unique_ptr<RowPredicate> leftOperand;
+    std::unique_ptr<RowPredicate> rightOperand;
+};
+
+// Reads a typed value out of a JSON cell without copying; returns false when the cell has another type.
+template <typename T>
+struct ColumnTraits;
+
+template <>
+struct ColumnTraits<int> {
+    using ValueType = long long;
+    static bool read(const json& cell, ValueType& out) {
+        if (!cell.is_number_integer()) return false;
+        out = cell.get<long long>();
+        return true;
+    }
+};
+
+template <>
+struct ColumnTraits<std::string> {
+    using ValueType = std::string;
+    static bool read(const json& cell, const std::string*& out) {
+        if (!cell.is_string()) return false;
+        out = &cell.get_ref<const std::string&>();
+        return true;
+    }
+};
+
+template <>
+struct ColumnTraits<DateValue> {
+    using ValueType = std::string;
+    static bool read(const json& cell, const std::string*& out) {
+        return ColumnTraits<std::string>::read(cell, out);
+    }
+};
+
+template <typename T, typename Compare>
+class TypedPredicate : public RowPredicate {
+public:
+    using ValueType = typename ColumnTraits<T>::ValueType;
+
+    TypedPredicate(std::string column, CompareOp op, ValueType literal)
+        : column(std::move(column)), literal(std::move(literal)) {
+        if constexpr (std::is_same_v<T, int>) {
+            comparison = {this->column, op, this->literal};
+        }
+    }
+
+    bool matches(const json& row) const override {
+        auto it = row.find(column);
+        if (it == row.end()) return false;
+        if constexpr (std::is_same_v<T, int>) {
+            ValueType value;
+            return ColumnTraits<T>::read(*it, value) && Compare{}(value, literal);
+        } else {
+            const std::string* value = nullptr;
+            return ColumnTraits<T>::read(*it, value) && Compare{}(*value, literal);
+        }
+    }
+
+    // Unknown when the column is missing or holds a value of another type, such as null.
+    bool known(const json& row) const override {
+        auto it = row.find(column);
+        if (it == row.end()) return false;
+        if constexpr (std::is_same_v<T, int>) {
+            return it->is_number_integer();
+        } else {
+            return it->is_string();
+        }
+    }
+
+    const IntComparison* intComparison() const override {
+        if constexpr (std::is_same_v<T, int>) {
+            return &comparison;
+        }
+        return nullptr;
+    }
+
+private:
+    std::string column;
+    ValueType literal;
+    IntComparison comparison;
+};
+
+// Builds a predicate for `column op literal` using the column type from the table schema.
+// The literal is converted and the comparator picked once; returns nullptr on invalid input.
+std::unique_ptr<RowPredicate> compileWherePredicate(const json& tableColumns, const std::string& column, const std::string& op, const std::string& literal);
+
+// Compiles a parsed WHERE expression against the columns of tableName; columns qualified
+// with another table are rejected. Returns nullptr on invalid input.
+std::unique_ptr<RowPredicate> compileWhereExpression(const json& tableColumns, const std::string& tableName, const WhereExpr& expr);
+
+// Converts a literal into the JSON value stored for a column of the given type.
+bool convertLiteral(const std::string& columnType, const std::string& literal, json& result);
+
+#endif
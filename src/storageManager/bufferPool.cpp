@@ -0,0 +1,292 @@
+#include "storageManager/bufferPool.h"
+#include <iostream>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+BufferPool& BufferPool::getInstance() {
+    static BufferPool instance;
+    return instance;
+}
+
+BufferPool::BufferPool() {}
+
+BufferPool::~BufferPool() {
+    for (auto& [path, state] : files) {
+        for (auto& [pageNo, frameIndex] : state.frames) {
+            if (frames[frameIndex].dirty) {
+                writeFrame(frames[frameIndex]);
+            }
+        }
+        if (state.fd >= 0) {
+            ::close(state.fd);
+        }
+    }
+}
+
+void BufferPool::recordFileIdentity(FileState& state) {
+    struct stat st;
+    if (fstat(state.fd, &st) != 0) {
+        return;
+    }
+    state.inode = st.st_ino;
+    state.writeTimeNs = static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+    state.size = st.st_size;
+    // Allocated pages that are not written yet lie beyond the end of the file.
+    state.pageCount = std::max(state.pageCount, static_cast<std::uint32_t>(st.st_size / PAGE_SIZE));
+}
+
+void BufferPool::dropFrames(FileState& state) {
+    for (auto& [pageNo, frameIndex] : state.frames) {
+        Frame& frame = frames[frameIndex];
+        frame.used = false;
+        frame.dirty = false;
+        frame.pinCount = 0;
+        frame.path.clear();
+    }
+    state.frames.clear();
+}
+
+BufferPool::FileState* BufferPool::openFile(const std::string& path) {
+    auto it = files.find(path);
+    if (it != files.end()) {
+        return &it->second;
+    }
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "Error: Failed to open page file '" << path << "'." << std::endl;
+        return nullptr;
+    }
+    FileState& state = files[path];
+    state.fd = fd;
+    recordFileIdentity(state);
+    return &state;
+}
+
+void BufferPool::revalidate(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = files.find(path);
+    if (it == files.end()) {
+        return;
+    }
+
+    FileState& state = it->second;
+    bool busy = std::any_of(state.frames.begin(), state.frames.end(), [this](const auto& entry) {
+        return frames[entry.second].dirty || frames[entry.second].pinCount > 0;
+    });
+    struct stat st;
+    if (busy || (stat(path.c_str(), &st) == 0 && st.st_ino == state.inode && st.st_size == state.size &&
+                 static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec == state.writeTimeNs)) {
+        return;
+    }
+
+    // Changed on disk since it was cached (another process wrote it): start over from the current file.
+    dropFrames(state);
+    ::close(state.fd);
+    files.erase(it);
+}
+
+bool BufferPool::writeFrame(Frame& frame) {
+    auto it = files.find(frame.path);
+    if (it == files.end()) {
+        return false;
+    }
+    ssize_t written = pwrite(it->second.fd, frame.data.get(), PAGE_SIZE, static_cast<off_t>(frame.pageNo) * PAGE_SIZE);
+    if (written != static_cast<ssize_t>(PAGE_SIZE)) {
+        std::cerr << "Error: Failed to write page " << frame.pageNo << " of '" << frame.path << "'." << std::endl;
+        return false;
+    }
+    frame.dirty = false;
+    recordFileIdentity(it->second);
+    return true;
+}
+
+void BufferPool::releaseFrame(size_t frameIndex) {
+    Frame& frame = frames[frameIndex];
+    auto it = files.find(frame.path);
+    if (it != files.end()) {
+        it->second.frames.erase(frame.pageNo);
+    }
+    frame.used = false;
+    frame.path.clear();
+}
+
+bool BufferPool::findFrame(size_t& frameIndex) {
+    for (size_t i = 0; i < frames.size(); ++i) {
+        if (!frames[i].used) {
+            frameIndex = i;
+            return true;
+        }
+    }
+    if (frames.size() < capacityPages) {
+        frames.emplace_back();
+        frames.back().data = std::make_unique<char[]>(PAGE_SIZE);
+        frameIndex = frames.size() - 1;
+        return true;
+    }
+
+    // Clock sweep: a referenced frame gets a second chance, pinned frames are never evicted.
+    for (size_t step = 0; step < 2 * frames.size(); ++step) {
+        size_t candidate = clockHand;
+        clockHand = (clockHand + 1) % frames.size();
+        Frame& frame = frames[candidate];
+        if (frame.pinCount > 0) {
+            continue;
+        }
+        if (frame.referenced) {
+            frame.referenced = false;
+            continue;
+        }
+        if (frame.dirty && !writeFrame(frame)) {
+            return false;
+        }
+        releaseFrame(candidate);
+        frameIndex = candidate;
+        return true;
+    }
+
+    std::cerr << "Error: Buffer pool exhausted, all " << frames.size() << " pages are pinned." << std::endl;
+    return false;
+}
+
+char* BufferPool::pin(const std::string& path, std::uint32_t pageNo) {
+    std::lock_guard<std::mutex> lock(mutex);
+    FileState* state = openFile(path);
+    if (!state) {
+        return nullptr;
+    }
+
+    auto cached = state->frames.find(pageNo);
+    if (cached != state->frames.end()) {
+        Frame& frame = frames[cached->second];
+        ++frame.pinCount;
+        frame.referenced = true;
+        return frame.data.get();
+    }
+
+    if (pageNo >= state->pageCount) {
+        std::cerr << "Error: Page " << pageNo << " is beyond the end of '" << path << "'." << std::endl;
+        return nullptr;
+    }
+
+    size_t frameIndex;
+    if (!findFrame(frameIndex)) {
+        return nullptr;
+    }
+    Frame& frame = frames[frameIndex];
+    ssize_t bytesRead = pread(state->fd, frame.data.get(), PAGE_SIZE, static_cast<off_t>(pageNo) * PAGE_SIZE);
+    if (bytesRead != static_cast<ssize_t>(PAGE_SIZE)) {
+        std::cerr << "Error: Failed to read page " << pageNo << " of '" << path << "'." << std::endl;
+        return nullptr;
+    }
+
+    frame.path = path;
+    frame.pageNo = pageNo;
+    frame.pinCount = 1;
+    frame.dirty = false;
+    frame.referenced = true;
+    frame.used = true;
+    state->frames[pageNo] = frameIndex;
+    return frame.data.get();
+}
+
+char* BufferPool::allocate(const std::string& path, std::uint32_t& pageNo) {
+    std::lock_guard<std::mutex> lock(mutex);
+    FileState* state = openFile(path);
+    size_t frameIndex;
+    if (!state || !findFrame(frameIndex)) {
+        return nullptr;
+    }
+
+    Frame& frame = frames[frameIndex];
+    std::fill(frame.data.get(), frame.data.get() + PAGE_SIZE, 0);
+    pageNo = state->pageCount++;
+    frame.path = path;
+    frame.pageNo = pageNo;
+    frame.pinCount = 1;
+    frame.dirty = true;
+    frame.referenced = true;
+    frame.used = true;
+    state->frames[pageNo] = frameIndex;
+    return frame.data.get();
+}
+
+void BufferPool::unpin(const std::string& path, std::uint32_t pageNo, bool dirty) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto fileIt = files.find(path);
+    if (fileIt == files.end()) {
+        return;
+    }
+    auto frameIt = fileIt->second.frames.find(pageNo);
+    if (frameIt == fileIt->second.frames.end()) {
+        return;
+    }
+    Frame& frame = frames[frameIt->second];
+    if (frame.pinCount > 0) {
+        --frame.pinCount;
+    }
+    frame.dirty = frame.dirty || dirty;
+}
+
+std::uint32_t BufferPool::pageCount(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    FileState* state = openFile(path);
+    return state ? state->pageCount : 0;
+}
+
+bool BufferPool::flush(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = files.find(path);
+    if (it == files.end()) {
+        return true;
+    }
+
+    // Write pages in file order so newly allocated pages never leave a hole behind them.
+    std::vector<std::pair<std::uint32_t, size_t>> dirtyFrames;
+    for (const auto& [pageNo, frameIndex] : it->second.frames) {
+        if (frames[frameIndex].dirty) {
+            dirtyFrames.emplace_back(pageNo, frameIndex);
+        }
+    }
+    std::sort(dirtyFrames.begin(), dirtyFrames.end());
+
+    bool success = true;
+    for (const auto& [pageNo, frameIndex] : dirtyFrames) {
+        success = writeFrame(frames[frameIndex]) && success;
+    }
+    return success;
+}
+
+void BufferPool::discard(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = files.find(path);
+    if (it == files.end()) {
+        return;
+    }
+    dropFrames(it->second);
+    ::close(it->second.fd);
+    files.erase(it);
+}
+
+void BufferPool::setCapacity(size_t pages) {
+    std::lock_guard<std::mutex> lock(mutex);
+    capacityPages = std::max(pages, MIN_CAPACITY_PAGES);
+    while (frames.size() > capacityPages) {
+        Frame& frame = frames.back();
+        if (frame.used) {
+            if (frame.pinCount > 0 || (frame.dirty && !writeFrame(frame))) {
+                break;
+            }
+            releaseFrame(frames.size() - 1);
+        }
+        frames.pop_back();
+    }
+    clockHand = 0;
+}
+
+size_t BufferPool::capacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return capacityPages;
+}
@@ -0,0 +1,105 @@
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include "storageManager/slottedPage.h"
+
+// Process-wide cache of fixed-size pages from paged database files. Frames are recycled
+// with the clock algorithm once the memory budget is reached; dirty pages are written
+// back on eviction or when the owning file is flushed.
+class BufferPool {
+public:
+    static constexpr size_t DEFAULT_CAPACITY_PAGES = 256;
+    static constexpr size_t MIN_CAPACITY_PAGES = 8;
+
+    static BufferPool& getInstance();
+
+    // Pins a page in memory and returns its bytes, or nullptr on I/O failure.
+    char* pin(const std::string& path, std::uint32_t pageNo);
+    // Appends a zeroed page to the file and pins it.
+    char* allocate(const std::string& path, std::uint32_t& pageNo);
+    void unpin(const std::string& path, std::uint32_t pageNo, bool dirty);
+
+    std::uint32_t pageCount(const std::string& path);
+    // Forgets cached pages of a file that another process has modified since they were read.
+    void revalidate(const std::string& path);
+    bool flush(const std::string& path);
+    // Drops every cached page of a file without writing it back (file deleted or replaced).
+    void discard(const std::string& path);
+
+    void setCapacity(size_t pages);
+    size_t capacity() const;
+
+private:
+    struct FileState {
+        int fd = -1;
+        std::uint32_t pageCount = 0;
+        // Identity of the file when last read or written; a change means another process replaced it.
+        std::uint64_t inode = 0;
+        std::int64_t writeTimeNs = 0;
+        std::int64_t size = 0;
+        std::unordered_map<std::uint32_t, size_t> frames;
+    };
+
+    struct Frame {
+        std::unique_ptr<char[]> data;
+        std::string path;
+        std::uint32_t pageNo = 0;
+        int pinCount = 0;
+        bool dirty = false;
+        bool referenced = false;
+        bool used = false;
+    };
+
+    BufferPool();
+    ~BufferPool();
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    FileState* openFile(const std::string& path);
+    void recordFileIdentity(FileState& state);
+    void dropFrames(FileState& state);
+    bool findFrame(size_t& frameIndex);
+    bool writeFrame(Frame& frame);
+    void releaseFrame(size_t frameIndex);
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, FileState> files;
+    std::vector<Frame> frames;
+    size_t capacityPages = DEFAULT_CAPACITY_PAGES;
+    size_t clockHand = 0;
+};
+
+// Pins a page for the lifetime of the guard.
+class PageGuard {
+public:
+    PageGuard(const std::string& path, std::uint32_t pageNo)
+        : path(path), pageNo(pageNo), data(BufferPool::getInstance().pin(path, pageNo)) {}
+    PageGuard(const std::string& path, std::uint32_t pageNo, char* data)
+        : path(path), pageNo(pageNo), data(data) {}
+    ~PageGuard() {
+        if (data) {
+            BufferPool::getInstance().unpin(path, pageNo, dirty);
+        }
+    }
+    PageGuard(const PageGuard&) = delete;
+    PageGuard& operator=(const PageGuard&) = delete;
+
+    explicit operator bool() const { return data != nullptr; }
+    SlottedPage page() const { return SlottedPage(data); }
+    std::uint32_t number() const { return pageNo; }
+    void markDirty() { dirty = true; }
+
+private:
+    std::string path;
+    std::uint32_t pageNo;
+    char* data;
+    bool dirty = false;
+};
+
+#endif
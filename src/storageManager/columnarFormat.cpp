@@ -0,0 +1,375 @@
+#include "storageManager/columnarFormat.h"
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const json EMPTY_ARRAY = json::array();
+
+void appendBytes(std::string& out, const void* data, size_t size) {
+    out.append(static_cast<const char*>(data), size);
+}
+
+// Byte by byte, so the image is little endian whatever the host is.
+template <typename T>
+void appendValue(std::string& out, T value) {
+    auto bits = static_cast<std::make_unsigned_t<T>>(value);
+    for (size_t shift = 0; shift < sizeof(T) * 8; shift += 8) {
+        out.push_back(static_cast<char>((bits >> shift) & 0xFF));
+    }
+}
+
+void appendString(std::string& out, const std::string& value) {
+    appendValue<std::uint32_t>(out, static_cast<std::uint32_t>(value.size()));
+    out.append(value);
+}
+
+void padTo8(std::string& out) {
+    out.append((8 - out.size() % 8) % 8, '\0');
+}
+
+class Reader {
+public:
+    Reader(const char* data, size_t size) : data(data), size(size) {}
+
+    template <typename T>
+    bool read(T& value) {
+        if (!has(sizeof(T))) return false;
+        value = ColumnarFormat::readLittleEndian<T>(data + pos);
+        pos += sizeof(T);
+        return true;
+    }
+
+    bool readString(std::string_view& value) {
+        std::uint32_t length;
+        if (!read(length) || !has(length)) return false;
+        value = std::string_view(data + pos, length);
+        pos += length;
+        return true;
+    }
+
+    const char* take(size_t length) {
+        if (!has(length)) return nullptr;
+        const char* ptr = data + pos;
+        pos += length;
+        return ptr;
+    }
+
+    bool alignTo8() {
+        size_t padding = (8 - pos % 8) % 8;
+        if (!has(padding)) return false;
+        pos += padding;
+        return true;
+    }
+
+    size_t remaining() const { return size - pos; }
+
+private:
+    bool has(size_t length) const { return length <= size - pos; }
+
+    const char* data;
+    size_t size;
+    size_t pos = 0;
+};
+
+// liveRows holds the indices of the rows to encode, in order; deleted (null) rows are left out.
+bool encodeColumn(const json& rows, const std::vector<size_t>& liveRows, const std::string& name, ColumnarFormat::ColumnType type, std::string& out) {
+    const size_t rowCount = liveRows.size();
+    std::vector<std::uint64_t> present((rowCount + 63) / 64, 0);
+    for (size_t i = 0; i < rowCount; ++i) {
+        const json& row = rows[liveRows[i]];
+        if (row.contains(name) && !row[name].is_null()) {
+            present[i / 64] |= std::uint64_t(1) << (i % 64);
+        }
+    }
+
+    padTo8(out);
+    for (std::uint64_t word : present) {
+        appendValue(out, word);
+    }
+
+    if (type == ColumnarFormat::ColumnType::INT) {
+        for (size_t i = 0; i < rowCount; ++i) {
+            std::int64_t value = 0;
+            if ((present[i / 64] >> (i % 64)) & 1) {
+                const json& cell = rows[liveRows[i]][name];
+                if (!cell.is_number_integer()) {
+                    std::cerr << "Error: Value '" << cell.dump() << "' in column '" << name << "' is not an integer." << std::endl;
+                    return false;
+                }
+                value = cell.get<std::int64_t>();
+            }
+            appendValue(out, value);
+        }
+        return true;
+    }
+
+    std::string blob;
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(rowCount + 1);
+    offsets.push_back(0);
+    for (size_t i = 0; i < rowCount; ++i) {
+        if ((present[i / 64] >> (i % 64)) & 1) {
+            const json& cell = rows[liveRows[i]][name];
+            blob += cell.is_string() ? cell.get<std::string>() : cell.dump();
+        }
+        offsets.push_back(blob.size());
+    }
+    for (std::uint64_t offset : offsets) {
+        appendValue(out, offset);
+    }
+    out.append(blob);
+    return true;
+}
+
+}
+
+namespace ColumnarFormat {
+
+bool columnTypeFromString(const std::string& type, ColumnType& result) {
+    if (type == "int") {
+        result = ColumnType::INT;
+    } else if (type == "string") {
+        result = ColumnType::STRING;
+    } else if (type == "date") {
+        result = ColumnType::DATE;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::string columnTypeToString(ColumnType type) {
+    switch (type) {
+        case ColumnType::INT: return "int";
+        case ColumnType::DATE: return "date";
+        case ColumnType::STRING:
+        default: return "string";
+    }
+}
+
+bool encodeDatabase(const json& dbContent, std::string& out) {
+    const json& tables = dbContent.contains("tables") ? dbContent["tables"] : EMPTY_ARRAY;
+
+    out.clear();
+    appendBytes(out, MAGIC, sizeof(MAGIC));
+    appendValue<std::uint32_t>(out, VERSION);
+    appendValue<std::uint32_t>(out, static_cast<std::uint32_t>(tables.size()));
+    appendString(out, dbContent.value("database_name", ""));
+
+    for (const auto& table : tables) {
+        const json& columns = table["columns"];
+        const json& rows = table.contains("rows") ? table["rows"] : EMPTY_ARRAY;
+
+        std::vector<size_t> liveRows;
+        liveRows.reserve(rows.size());
+        for (size_t i = 0; i < rows.size(); ++i) {
+            if (rows[i].is_object()) {
+                liveRows.push_back(i);
+            }
+        }
+
+        // A table without columns has nothing to store per row.
+        if (columns.empty()) {
+            liveRows.clear();
+        }
+
+        appendString(out, table["table_name"].get<std::string>());
+        appendValue<std::uint32_t>(out, static_cast<std::uint32_t>(columns.size()));
+        appendValue<std::uint64_t>(out, liveRows.size());
+
+        std::vector<ColumnType> types;
+        for (const auto& column : columns) {
+            ColumnType type;
+            if (!columnTypeFromString(column["type"], type)) {
+                std::cerr << "Error: Column type '" << column["type"] << "' cannot be stored in columnar format." << std::endl;
+                return false;
+            }
+            types.push_back(type);
+            appendString(out, column["name"].get<std::string>());
+            appendValue<std::uint8_t>(out, static_cast<std::uint8_t>(type));
+            appendString(out, column.contains("properties") ? column["properties"].dump() : "[]");
+        }
+
+        for (size_t c = 0; c < columns.size(); ++c) {
+            if (!encodeColumn(rows, liveRows, columns[c]["name"], types[c], out)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const ColumnView* TableView::findColumn(std::string_view columnName) const {
+    for (const auto& column : columns) {
+        if (column.name == columnName) {
+            return &column;
+        }
+    }
+    return nullptr;
+}
+
+json TableView::rowAt(std::uint64_t row) const {
+    json result = json::object();
+    for (const auto& column : columns) {
+        if (column.isNull(row)) {
+            continue;
+        }
+        if (column.type == ColumnType::INT) {
+            result[std::string(column.name)] = column.intAt(row);
+        } else {
+            result[std::string(column.name)] = std::string(column.stringAt(row));
+        }
+    }
+    return result;
+}
+
+const TableView* DatabaseView::findTable(std::string_view tableName) const {
+    for (const auto& table : tableViews) {
+        if (table.name == tableName) {
+            return &table;
+        }
+    }
+    return nullptr;
+}
+
+bool DatabaseView::open(const char* data, size_t size) {
+    tableViews.clear();
+    Reader reader(data, size);
+    const char* magic = reader.take(sizeof(MAGIC));
+    std::uint32_t version, tableCount;
+    if (!magic || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !reader.read(version) || version != VERSION ||
+        !reader.read(tableCount) || !reader.readString(name)) {
+        std::cerr << "Error: Invalid columnar database header." << std::endl;
+        return false;
+    }
+
+    // Counts are checked against the bytes left before anything is allocated for them: a table
+    // header takes at least TABLE_HEADER_BYTES, a column header COLUMN_HEADER_BYTES and every
+    // row at least one u64 in each column.
+    constexpr size_t TABLE_HEADER_BYTES = 2 * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+    constexpr size_t COLUMN_HEADER_BYTES = 2 * sizeof(std::uint32_t) + sizeof(std::uint8_t);
+    if (tableCount > reader.remaining() / TABLE_HEADER_BYTES) {
+        std::cerr << "Error: Columnar table count " << tableCount << " exceeds the file size." << std::endl;
+        return false;
+    }
+
+    tableViews.resize(tableCount);
+    for (auto& table : tableViews) {
+        std::uint32_t columnCount;
+        if (!reader.readString(table.name) || !reader.read(columnCount) || !reader.read(table.rowCount)) {
+            std::cerr << "Error: Truncated columnar table header." << std::endl;
+            return false;
+        }
+        if (columnCount > reader.remaining() / COLUMN_HEADER_BYTES) {
+            std::cerr << "Error: Column count of table '" << table.name << "' exceeds the file size." << std::endl;
+            return false;
+        }
+
+        table.columns.resize(columnCount);
+        for (auto& column : table.columns) {
+            std::uint8_t type;
+            if (!reader.readString(column.name) || !reader.read(type) || !reader.readString(column.properties) ||
+                type > static_cast<std::uint8_t>(ColumnType::DATE)) {
+                std::cerr << "Error: Invalid columnar column header in table '" << table.name << "'." << std::endl;
+                return false;
+            }
+            column.type = static_cast<ColumnType>(type);
+            column.rowCount = table.rowCount;
+        }
+
+        const std::uint64_t rowCount = table.rowCount;
+        if ((columnCount == 0 && rowCount != 0) || rowCount > reader.remaining() / sizeof(std::uint64_t)) {
+            std::cerr << "Error: Row count of table '" << table.name << "' exceeds the file size." << std::endl;
+            return false;
+        }
+        const size_t bitmapBytes = ((rowCount + 63) / 64) * sizeof(std::uint64_t);
+        for (auto& column : table.columns) {
+            if (!reader.alignTo8() || !(column.bitmap = reader.take(bitmapBytes))) {
+                std::cerr << "Error: Truncated null bitmap for column '" << column.name << "'." << std::endl;
+                return false;
+            }
+
+            if (column.type == ColumnType::INT) {
+                if (!(column.values = reader.take(rowCount * sizeof(std::int64_t)))) {
+                    std::cerr << "Error: Truncated int column '" << column.name << "'." << std::endl;
+                    return false;
+                }
+                continue;
+            }
+
+            if (!(column.offsets = reader.take((rowCount + 1) * sizeof(std::uint64_t)))) {
+                std::cerr << "Error: Truncated offsets for column '" << column.name << "'." << std::endl;
+                return false;
+            }
+            std::uint64_t blobSize = readLittleEndian<std::uint64_t>(column.offsets + rowCount * sizeof(std::uint64_t));
+            if (!(column.blob = reader.take(blobSize))) {
+                std::cerr << "Error: Truncated string data for column '" << column.name << "'." << std::endl;
+                return false;
+            }
+            for (std::uint64_t r = 0; r < rowCount; ++r) {
+                std::uint64_t begin = readLittleEndian<std::uint64_t>(column.offsets + r * sizeof(std::uint64_t));
+                std::uint64_t end = readLittleEndian<std::uint64_t>(column.offsets + (r + 1) * sizeof(std::uint64_t));
+                if (begin > end || end > blobSize) {
+                    std::cerr << "Error: Corrupt offsets for column '" << column.name << "'." << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool decodeDatabase(const char* data, size_t size, json& dbContent) {
+    DatabaseView view;
+    if (!view.open(data, size)) {
+        return false;
+    }
+
+    dbContent = {
+        {"database_name", view.databaseName()},
+        {"tables", json::array()}
+    };
+
+    for (const auto& tableView : view.tables()) {
+        json table = {
+            {"table_name", tableView.name},
+            {"columns", json::array()},
+            {"rows", json::array()}
+        };
+        for (const auto& column : tableView.columns) {
+            json properties = json::parse(column.properties, nullptr, false);
+            if (properties.is_discarded()) {
+                std::cerr << "Error: Invalid properties for column '" << column.name << "'." << std::endl;
+                return false;
+            }
+            table["columns"].push_back({
+                {"name", column.name},
+                {"type", columnTypeToString(column.type)},
+                {"properties", std::move(properties)}
+            });
+        }
+
+        json& rows = table["rows"];
+        for (std::uint64_t r = 0; r < tableView.rowCount; ++r) {
+            json row = json::object();
+            for (const auto& column : tableView.columns) {
+                if (column.isNull(r)) {
+                    continue;
+                }
+                if (column.type == ColumnType::INT) {
+                    row[std::string(column.name)] = column.intAt(r);
+                } else {
+                    row[std::string(column.name)] = column.stringAt(r);
+                }
+            }
+            rows.push_back(std::move(row));
+        }
+
+        dbContent["tables"].push_back(std::move(table));
+    }
+    return true;
+}
+
+}
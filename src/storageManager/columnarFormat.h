@@ -0,0 +1,111 @@
+#ifndef COLUMNAR_FORMAT_H
+#define COLUMNAR_FORMAT_H
+
+#include <bit>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+// Binary columnar database image. All integers are little endian and every column
+// block starts on an 8 byte boundary, so on little endian hosts int columns can be read
+// in place.
+//
+//   header   : magic "CJDBCOL1", u32 version, u32 table count, str database name
+//   table    : str name, u32 column count, u64 row count, then per column
+//              str name, u8 type, str properties (compact JSON)
+//   column   : null bitmap of ceil(rows / 64) u64 words (bit set = value present), then
+//              int         -> rows * i64
+//              string/date -> (rows + 1) * u64 offsets, blob of concatenated bytes
+//
+// str is a u32 length followed by the bytes.
+namespace ColumnarFormat {
+    constexpr char MAGIC[8] = {'C', 'J', 'D', 'B', 'C', 'O', 'L', '1'};
+    constexpr std::uint32_t VERSION = 1;
+
+    enum class ColumnType : std::uint8_t {
+        INT = 0,
+        STRING = 1,
+        DATE = 2
+    };
+
+    // Int columns are handed to the filter kernels in place only when the host stores
+    // integers in the image's byte order.
+    constexpr bool NATIVE_BYTE_ORDER = std::endian::native == std::endian::little;
+
+    // Reads the little endian integer at data byte by byte, whatever the host is.
+    template <typename T>
+    T readLittleEndian(const char* data) {
+        std::make_unsigned_t<T> bits = 0;
+        for (size_t i = sizeof(T); i-- > 0;) {
+            bits = static_cast<std::make_unsigned_t<T>>((bits << 8) | static_cast<unsigned char>(data[i]));
+        }
+        return static_cast<T>(bits);
+    }
+
+    bool columnTypeFromString(const std::string& type, ColumnType& result);
+    std::string columnTypeToString(ColumnType type);
+
+    // Zero-copy accessors over one column block; the pointers refer into the image.
+    struct ColumnView {
+        std::string_view name;
+        ColumnType type;
+        std::string_view properties;
+        std::uint64_t rowCount = 0;
+        const char* bitmap = nullptr;
+        const char* values = nullptr;   // int columns
+        const char* offsets = nullptr;  // string/date columns
+        const char* blob = nullptr;
+
+        // Word of the null bitmap holding rows word * 64 to word * 64 + 63.
+        std::uint64_t bitmapWord(std::uint64_t word) const {
+            return readLittleEndian<std::uint64_t>(bitmap + word * sizeof(std::uint64_t));
+        }
+        bool isNull(std::uint64_t row) const {
+            return ((bitmapWord(row / 64) >> (row % 64)) & 1) == 0;
+        }
+        std::int64_t intAt(std::uint64_t row) const {
+            return readLittleEndian<std::int64_t>(values + row * sizeof(std::int64_t));
+        }
+        std::string_view stringAt(std::uint64_t row) const {
+            std::uint64_t begin = readLittleEndian<std::uint64_t>(offsets + row * sizeof(std::uint64_t));
+            std::uint64_t end = readLittleEndian<std::uint64_t>(offsets + (row + 1) * sizeof(std::uint64_t));
+            return {blob + begin, end - begin};
+        }
+    };
+
+    struct TableView {
+        std::string_view name;
+        std::uint64_t rowCount = 0;
+        std::vector<ColumnView> columns;
+
+        const ColumnView* findColumn(std::string_view columnName) const;
+        // Decodes one row into a JSON object; null cells are left out.
+        json rowAt(std::uint64_t row) const;
+    };
+
+    // Validates an image once and indexes its tables and columns without copying any data.
+    // The image (usually a MappedFile) must outlive the view.
+    class DatabaseView {
+    public:
+        bool open(const char* data, size_t size);
+        std::string_view databaseName() const { return name; }
+        const std::vector<TableView>& tables() const { return tableViews; }
+        const TableView* findTable(std::string_view tableName) const;
+
+    private:
+        std::string_view name;
+        std::vector<TableView> tableViews;
+    };
+
+    // Null rows are tombstones of deleted rows and are not encoded, so images never hold them.
+    bool encodeDatabase(const json& dbContent, std::string& out);
+    bool decodeDatabase(const char* data, size_t size, json& dbContent);
+}
+
+#endif
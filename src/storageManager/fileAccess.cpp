@@ -0,0 +1,44 @@
+#include "storageManager/fileAccess.h"
+#include <iostream>
+#include <filesystem>
+#include <algorithm>
+
+namespace {
+
+bool restricted = false;
+std::filesystem::path root;
+
+}
+
+void FileAccess::restrictTo(const std::string& directory) {
+    restricted = true;
+    root.clear();
+    std::error_code ec;
+    if (!directory.empty()) {
+        root = std::filesystem::weakly_canonical(std::filesystem::absolute(directory, ec), ec);
+        if (!root.has_filename()) {
+            root = root.parent_path();
+        }
+    }
+}
+
+// Symbolic links are followed before the check, so a link in the directory cannot lead out of it.
+bool FileAccess::resolve(const std::string& path, std::string& resolved) {
+    if (!restricted) {
+        resolved = path;
+        return true;
+    }
+    if (root.empty()) {
+        std::cerr << "Error: File import and export are disabled on this server. Start it with --file-dir <directory> to allow them." << std::endl;
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::path target = std::filesystem::weakly_canonical(root / path, ec);
+    auto [rootEnd, targetIt] = std::mismatch(root.begin(), root.end(), target.begin(), target.end());
+    if (ec || rootEnd != root.end() || targetIt == target.end()) {
+        std::cerr << "Error: '" << path << "' is outside the file directory of this server." << std::endl;
+        return false;
+    }
+    resolved = target.string();
+    return true;
+}
@@ -0,0 +1,17 @@
+#ifndef FILE_ACCESS_H
+#define FILE_ACCESS_H
+
+#include <string>
+
+// Where .import, .export and SELECT ... INTO OUTFILE may read and write. The REPL and the
+// library run as their user and may use any path. A server runs them for its clients, so it
+// confines them to the directory given with --file-dir and refuses them without one.
+namespace FileAccess {
+    // Called once at server start, before any session runs; an empty directory refuses all paths.
+    void restrictTo(const std::string& directory);
+    // The path to open for path: relative paths are taken from the allowed directory. False,
+    // with the reason printed, when path lies outside it.
+    bool resolve(const std::string& path, std::string& resolved);
+}
+
+#endif
@@ -0,0 +1,137 @@
+#include "storageManager/jsonFileWriter.h"
+#include "storageManager/snapshotFile.h"
+#include <iostream>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <ostream>
+#include <streambuf>
+#include <unistd.h>
+
+namespace {
+
+// Set when the catalog is reloaded, possibly from another thread than the one writing.
+std::atomic<JsonStyle> currentDefaultStyle{JsonStyle::PRETTY};
+
+// Stream buffer without storage of its own: json's operator<< hands its characters through
+// it straight to the writer's buffer.
+class WriterStreamBuffer : public std::streambuf {
+public:
+    explicit WriterStreamBuffer(JsonFileWriter& writer) : writer(writer) {}
+
+protected:
+    int_type overflow(int_type c) override {
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            writer.put(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize count) override {
+        writer.write(std::string_view(s, static_cast<size_t>(count)));
+        return count;
+    }
+
+private:
+    JsonFileWriter& writer;
+};
+
+}
+
+JsonFileWriter::JsonFileWriter(const std::string& path)
+    : path(path), buffer(std::make_unique<char[]>(BUFFER_SIZE)) {
+    fd = SnapshotFile::open(path, tempPath);
+}
+
+// A writer that is never closed leaves the old file in place.
+JsonFileWriter::~JsonFileWriter() {
+    if (fd >= 0) {
+        SnapshotFile::abort(fd, tempPath);
+    }
+}
+
+void JsonFileWriter::write(std::string_view text) {
+    if (text.size() > BUFFER_SIZE - used) {
+        flushBuffer();
+        if (text.size() > BUFFER_SIZE) {
+            // Too large to stage; written directly so the buffer never grows.
+            while (!failed && !text.empty()) {
+                ssize_t written = ::write(fd, text.data(), text.size());
+                if (written < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (written <= 0) {
+                    failed = true;
+                    break;
+                }
+                text.remove_prefix(static_cast<size_t>(written));
+            }
+            return;
+        }
+    }
+    std::memcpy(buffer.get() + used, text.data(), text.size());
+    used += text.size();
+}
+
+void JsonFileWriter::flushBuffer() {
+    size_t offset = 0;
+    while (!failed && offset < used) {
+        ssize_t written = ::write(fd, buffer.get() + offset, used - offset);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            failed = true;
+            break;
+        }
+        offset += static_cast<size_t>(written);
+    }
+    used = 0;
+}
+
+// A stream width of 4 is how operator<< is asked for pretty output.
+void JsonFileWriter::writeJson(const json& value, JsonStyle style) {
+    if (!isOpen()) {
+        return;
+    }
+    WriterStreamBuffer streamBuffer(*this);
+    std::ostream stream(&streamBuffer);
+    if (style == JsonStyle::PRETTY) {
+        stream << std::setw(4);
+    }
+    stream << value;
+}
+
+bool JsonFileWriter::close() {
+    if (fd < 0) {
+        return false;
+    }
+    flushBuffer();
+    int closingFd = fd;
+    fd = -1;
+    if (failed) {
+        std::cerr << "Error: Failed to write file '" << path << "'." << std::endl;
+        SnapshotFile::abort(closingFd, tempPath);
+        return false;
+    }
+    return SnapshotFile::commit(closingFd, tempPath, path);
+}
+
+JsonStyle JsonFileWriter::defaultStyle() {
+    return currentDefaultStyle.load(std::memory_order_relaxed);
+}
+
+void JsonFileWriter::setDefaultStyle(JsonStyle style) {
+    currentDefaultStyle.store(style, std::memory_order_relaxed);
+}
+
+bool JsonFileWriter::writeFile(const std::string& path, const json& value, JsonStyle style) {
+    JsonFileWriter writer(path);
+    if (!writer.isOpen()) {
+        return false;
+    }
+    writer.writeJson(value, style);
+    writer.put('\n');
+    return writer.close();
+}
@@ -0,0 +1,72 @@
+#ifndef JSON_FILE_WRITER_H
+#define JSON_FILE_WRITER_H
+
+#include <string>
+#include <string_view>
+#include <memory>
+#include <stdexcept>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+enum class JsonStyle {
+    PRETTY,     // four space indentation, the historical on-disk layout
+    COMPACT     // no whitespace between tokens
+};
+
+inline std::string jsonStyleToString(JsonStyle style) {
+    return style == JsonStyle::COMPACT ? "compact" : "pretty";
+}
+
+inline JsonStyle stringToJsonStyle(const std::string& styleString) {
+    if (styleString == "pretty") {
+        return JsonStyle::PRETTY;
+    } else if (styleString == "compact") {
+        return JsonStyle::COMPACT;
+    }
+    throw std::invalid_argument("Unknown JSON style: " + styleString);
+}
+
+// Serializes JSON documents straight into a file descriptor through a fixed size buffer.
+// json's public operator<< writes token by token through a stream buffer that forwards
+// into this buffer, so no string holding the whole document is built.
+// The file is written as a snapshot (see SnapshotFile): nothing is visible at the path
+// until close() commits it, and a writer destroyed without close() leaves the old file.
+class JsonFileWriter {
+public:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    explicit JsonFileWriter(const std::string& path);
+    ~JsonFileWriter();
+    JsonFileWriter(const JsonFileWriter&) = delete;
+    JsonFileWriter& operator=(const JsonFileWriter&) = delete;
+
+    bool isOpen() const { return fd >= 0; }
+    void write(std::string_view text);
+    void put(char c) {
+        if (used == BUFFER_SIZE) {
+            flushBuffer();
+        }
+        buffer[used++] = c;
+    }
+    void writeJson(const json& value, JsonStyle style);
+    // Flushes, syncs and renames the file into place; false when any step failed.
+    bool close();
+
+    // Style used for every JSON file the program writes, set from the catalog.
+    static JsonStyle defaultStyle();
+    static void setDefaultStyle(JsonStyle style);
+    static bool writeFile(const std::string& path, const json& value, JsonStyle style = defaultStyle());
+
+private:
+    void flushBuffer();
+
+    std::string path;
+    std::string tempPath;
+    int fd = -1;
+    std::unique_ptr<char[]> buffer;
+    size_t used = 0;
+    bool failed = false;
+};
+
+#endif
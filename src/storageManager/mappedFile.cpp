@@ -0,0 +1,57 @@
+#include "storageManager/mappedFile.h"
+#include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Error: Failed to open file '" << path << "' for mapping." << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        std::cerr << "Error: Failed to stat file '" << path << "'." << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) {
+        // mmap rejects zero-length mappings; an empty view is still a valid result.
+        ::close(fd);
+        data_ = "";
+        return true;
+    }
+
+    void* addr = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        std::cerr << "Error: Failed to map file '" << path << "'." << std::endl;
+        size_ = 0;
+        return false;
+    }
+    madvise(addr, size_, MADV_SEQUENTIAL);
+
+    data_ = static_cast<const char*>(addr);
+    mapped = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped) {
+        munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapped = false;
+}
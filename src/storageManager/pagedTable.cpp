@@ -0,0 +1,278 @@
+#include "storageManager/pagedTable.h"
+#include "storageManager/snapshotFile.h"
+#include <iostream>
+#include <cstring>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+
+PagedTable::PagedTable(const std::string& databaseName, const std::string& tableName)
+    : tableName(tableName), filePath(tableFilePath(databaseName, tableName, StorageFormat::PAGED)) {}
+
+std::string PagedTable::encodeRow(const json& row) {
+    std::string record;
+    json::to_msgpack(row, record);
+    return record;
+}
+
+bool PagedTable::decodeRow(std::string_view record, json& row) {
+    try {
+        row = json::from_msgpack(record.begin(), record.end());
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Corrupt row record: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void PagedTable::decodePage(const SlottedPage& page, std::vector<std::uint16_t>& slots, json& rows) {
+    for (std::uint16_t slot = 0; slot < page.slotCount(); ++slot) {
+        std::string_view record;
+        json row;
+        if (page.get(slot, record) && decodeRow(record, row)) {
+            slots.push_back(slot);
+            rows.push_back(std::move(row));
+        }
+    }
+}
+
+// In the single-file layout the first u32 of every page header links the page to the next one
+// of its chain. Page 0 starts the directory chain, whose records are a table's first and last
+// data page followed by its MessagePack {table_name, columns}; each table owns a data chain.
+bool PagedTable::readLegacyDatabase(const std::string& databaseName, std::string_view image, json& dbContent) {
+    constexpr std::uint32_t NO_PAGE = 0xFFFFFFFFu;
+    const size_t pageCount = image.size() / PAGE_SIZE;
+    if (pageCount == 0 || image.size() % PAGE_SIZE != 0) {
+        std::cerr << "Error: Page file size " << image.size() << " is not a multiple of the page size." << std::endl;
+        return false;
+    }
+
+    // Copies each page so a SlottedPage can wrap it, and checks that its slots stay inside it.
+    std::vector<char> buffer(PAGE_SIZE);
+    auto loadPage = [&](std::uint32_t pageNo, std::uint32_t& nextPage) -> bool {
+        if (pageNo >= pageCount) {
+            std::cerr << "Error: Page " << pageNo << " is past the end of the page file." << std::endl;
+            return false;
+        }
+        std::memcpy(buffer.data(), image.data() + static_cast<size_t>(pageNo) * PAGE_SIZE, PAGE_SIZE);
+        std::memcpy(&nextPage, buffer.data(), sizeof(nextPage));
+        SlottedPage page(buffer.data());
+        if (SlottedPage::HEADER_SIZE + static_cast<size_t>(page.slotCount()) * SlottedPage::SLOT_SIZE > PAGE_SIZE) {
+            std::cerr << "Error: Corrupt slot directory in page " << pageNo << "." << std::endl;
+            return false;
+        }
+        for (std::uint16_t slot = 0; slot < page.slotCount(); ++slot) {
+            std::string_view record;
+            if (page.get(slot, record) && record.data() + record.size() > buffer.data() + PAGE_SIZE) {
+                std::cerr << "Error: Corrupt record in page " << pageNo << "." << std::endl;
+                return false;
+            }
+        }
+        return true;
+    };
+
+    dbContent = {
+        {"database_name", databaseName},
+        {"tables", json::array()}
+    };
+    std::vector<std::uint32_t> firstPages;
+    size_t visited = 0;
+    for (std::uint32_t pageNo = 0, nextPage = NO_PAGE; pageNo != NO_PAGE; pageNo = nextPage) {
+        if (++visited > pageCount || !loadPage(pageNo, nextPage)) {
+            std::cerr << "Error: Invalid table directory in page file." << std::endl;
+            return false;
+        }
+        SlottedPage page(buffer.data());
+        for (std::uint16_t slot = 0; slot < page.slotCount(); ++slot) {
+            std::string_view record;
+            if (!page.get(slot, record)) {
+                continue;
+            }
+            std::uint32_t firstPage;
+            json schema;
+            if (record.size() < 2 * sizeof(std::uint32_t) || !decodeRow(record.substr(2 * sizeof(std::uint32_t)), schema) ||
+                !schema.contains("table_name") || !schema["table_name"].is_string()) {
+                std::cerr << "Error: Corrupt table directory record in page " << pageNo << "." << std::endl;
+                return false;
+            }
+            std::memcpy(&firstPage, record.data(), sizeof(firstPage));
+            firstPages.push_back(firstPage);
+            dbContent["tables"].push_back({
+                {"table_name", schema["table_name"]},
+                {"columns", schema.value("columns", json::array())},
+                {"rows", json::array()}
+            });
+        }
+    }
+
+    for (size_t t = 0; t < firstPages.size(); ++t) {
+        json& rows = dbContent["tables"][t]["rows"];
+        visited = 0;
+        for (std::uint32_t pageNo = firstPages[t], nextPage = NO_PAGE; pageNo != NO_PAGE; pageNo = nextPage) {
+            if (++visited > pageCount || !loadPage(pageNo, nextPage)) {
+                std::cerr << "Error: Invalid page chain for table '" << dbContent["tables"][t]["table_name"].get<std::string>() << "'." << std::endl;
+                return false;
+            }
+            std::vector<std::uint16_t> slots;
+            decodePage(SlottedPage(buffer.data()), slots, rows);
+        }
+    }
+    return true;
+}
+
+bool PagedTable::open(std::uint32_t& pageCount) {
+    if (!std::filesystem::exists(filePath)) {
+        std::cerr << "Error: Page file '" << filePath << "' for table '" << tableName << "' does not exist." << std::endl;
+        return false;
+    }
+    BufferPool& bufferPool = BufferPool::getInstance();
+    bufferPool.revalidate(filePath);
+    pageCount = bufferPool.pageCount(filePath);
+    return true;
+}
+
+// Rebuilds the whole file as a snapshot; in-place page updates go through forEachPage.
+bool PagedTable::store(const json& rows) {
+    std::string image;
+    size_t lastPage = 0;
+    for (const auto& row : rows) {
+        if (row.is_null()) {
+            continue;
+        }
+        std::string record = encodeRow(row);
+        if (record.size() > SlottedPage::MAX_RECORD_SIZE) {
+            std::cerr << "Error: Row in table '" << tableName << "' does not fit in a page." << std::endl;
+            return false;
+        }
+        if (image.empty() || SlottedPage(image.data() + lastPage).insert(record) < 0) {
+            lastPage = image.size();
+            image.resize(image.size() + PAGE_SIZE);
+            SlottedPage page(image.data() + lastPage);
+            page.init();
+            page.insert(record);
+        }
+    }
+
+    BufferPool::getInstance().discard(filePath);
+    return SnapshotFile::write(filePath, image);
+}
+
+bool PagedTable::load(json& rows) {
+    rows = json::array();
+    return forEachPage([&rows](SlottedPage& page) {
+        std::vector<std::uint16_t> slots;
+        decodePage(page, slots, rows);
+        return false;
+    });
+}
+
+bool PagedTable::forEachPage(const PageVisitor& visitor) {
+    std::uint32_t pageCount;
+    if (!open(pageCount)) {
+        return false;
+    }
+
+    for (std::uint32_t pageNo = 0; pageNo < pageCount; ++pageNo) {
+        PageGuard guard(filePath, pageNo);
+        if (!guard) {
+            return false;
+        }
+        SlottedPage page = guard.page();
+        if (visitor(page)) {
+            guard.markDirty();
+        }
+    }
+    return true;
+}
+
+bool PagedTable::appendRow(const json& row) {
+    std::string record = encodeRow(row);
+    if (record.size() > SlottedPage::MAX_RECORD_SIZE) {
+        std::cerr << "Error: Row does not fit in a page." << std::endl;
+        return false;
+    }
+
+    std::uint32_t pageCount;
+    if (!open(pageCount)) {
+        return false;
+    }
+
+    if (pageCount > 0) {
+        PageGuard guard(filePath, pageCount - 1);
+        if (!guard) {
+            return false;
+        }
+        SlottedPage page = guard.page();
+        if (page.insert(record) >= 0) {
+            guard.markDirty();
+            return true;
+        }
+    }
+
+    std::uint32_t newPageNo;
+    char* data = BufferPool::getInstance().allocate(filePath, newPageNo);
+    if (!data) {
+        return false;
+    }
+    PageGuard guard(filePath, newPageNo, data);
+    SlottedPage page = guard.page();
+    page.init();
+    page.insert(record);
+    guard.markDirty();
+    return true;
+}
+
+// Appending only changes the last page and adds pages after it, so a copy of the last page
+// and the page count are enough to undo a batch, including pages the buffer pool already
+// wrote back to make room.
+bool PagedTable::appendRows(const json& rows) {
+    std::uint32_t pageCount;
+    if (!open(pageCount) || !flush()) {
+        return false;
+    }
+    std::string lastPage;
+    if (pageCount > 0) {
+        BufferPool& bufferPool = BufferPool::getInstance();
+        const char* data = bufferPool.pin(filePath, pageCount - 1);
+        if (!data) {
+            return false;
+        }
+        lastPage.assign(data, PAGE_SIZE);
+        bufferPool.unpin(filePath, pageCount - 1, false);
+    }
+
+    for (const auto& row : rows) {
+        if (!appendRow(row)) {
+            restore(pageCount, lastPage);
+            return false;
+        }
+    }
+    if (!flush()) {
+        restore(pageCount, lastPage);
+        return false;
+    }
+    return true;
+}
+
+bool PagedTable::restore(std::uint32_t pageCount, const std::string& lastPage) {
+    BufferPool::getInstance().discard(filePath);
+    int fd = ::open(filePath.c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Error: Failed to restore page file '" << filePath << "'." << std::endl;
+        return false;
+    }
+    bool restored = ::ftruncate(fd, static_cast<off_t>(pageCount) * PAGE_SIZE) == 0;
+    if (restored && !lastPage.empty()) {
+        off_t offset = static_cast<off_t>(pageCount - 1) * PAGE_SIZE;
+        restored = ::pwrite(fd, lastPage.data(), PAGE_SIZE, offset) == static_cast<ssize_t>(PAGE_SIZE);
+    }
+    ::close(fd);
+    if (!restored) {
+        std::cerr << "Error: Failed to restore page file '" << filePath << "'." << std::endl;
+    }
+    return restored;
+}
+
+bool PagedTable::flush() {
+    return BufferPool::getInstance().flush(filePath);
+}
@@ -0,0 +1,48 @@
+#ifndef PAGED_TABLE_H
+#define PAGED_TABLE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include "storageManager/bufferPool.h"
+#include "storageManager/storageFormat.h"
+
+using json = nlohmann::json;
+
+// Rows file of one table made of PAGE_SIZE slotted pages, read and written through the
+// BufferPool. Every page of the file belongs to the table and holds one MessagePack encoded
+// row per slot; new rows go to the last page, or to a fresh page appended after it.
+class PagedTable {
+public:
+    // Called for every page of the table; returns true when it modified the page.
+    using PageVisitor = std::function<bool(SlottedPage& page)>;
+
+    PagedTable(const std::string& databaseName, const std::string& tableName);
+
+    bool store(const json& rows);
+    bool load(json& rows);
+    bool forEachPage(const PageVisitor& visitor);
+    bool appendRow(const json& row);
+    // Appends and writes all rows or none: on a failure the file is put back as it was.
+    bool appendRows(const json& rows);
+    bool flush();
+
+    static std::string encodeRow(const json& row);
+    static bool decodeRow(std::string_view record, json& row);
+    // Decodes the live rows of a page; slots[i] is the slot holding rows[i].
+    static void decodePage(const SlottedPage& page, std::vector<std::uint16_t>& slots, json& rows);
+    // Reads a whole database from the single-file data/databases/(name).db.pages layout that
+    // preceded the per-table files, for migration. The image is only read, never modified.
+    static bool readLegacyDatabase(const std::string& databaseName, std::string_view image, json& dbContent);
+
+private:
+    bool open(std::uint32_t& pageCount);
+    bool restore(std::uint32_t pageCount, const std::string& lastPage);
+
+    std::string tableName;
+    std::string filePath;
+};
+
+#endif
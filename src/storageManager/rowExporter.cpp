@@ -0,0 +1,147 @@
+#include "storageManager/rowExporter.h"
+#include <iostream>
+
+bool stringToExportFormat(const std::string& formatString, ExportFormat& format) {
+    if (formatString == "csv") {
+        format = ExportFormat::CSV;
+    } else if (formatString == "jsonl") {
+        format = ExportFormat::JSONL;
+    } else if (formatString == "binary") {
+        format = ExportFormat::BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool exportFormatFromPath(const std::string& path, ExportFormat& format) {
+    if (path.ends_with(".csv")) {
+        format = ExportFormat::CSV;
+    } else if (path.ends_with(".jsonl") || path.ends_with(".ndjson")) {
+        format = ExportFormat::JSONL;
+    } else if (path.ends_with(".bin")) {
+        format = ExportFormat::BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+RowExporter::RowExporter(const std::string& path, ExportFormat format, std::vector<Column> columns)
+    : writer(path), format(format), columns(std::move(columns)) {
+    if (writer.isOpen()) {
+        writeHeader();
+    }
+}
+
+template <typename T>
+void RowExporter::writeInteger(T value) {
+    writer.write(std::string_view(reinterpret_cast<const char*>(&value), sizeof(T)));
+}
+
+void RowExporter::writeHeader() {
+    if (format == ExportFormat::CSV) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (i > 0) {
+                writer.put(',');
+            }
+            writeCsvField(columns[i].name);
+        }
+        writer.put('\n');
+    } else if (format == ExportFormat::BINARY) {
+        writer.write(std::string_view(MAGIC, sizeof(MAGIC)));
+        writeInteger<std::uint32_t>(VERSION);
+        writeInteger<std::uint32_t>(static_cast<std::uint32_t>(columns.size()));
+        for (const auto& column : columns) {
+            writeInteger<std::uint32_t>(static_cast<std::uint32_t>(column.name.size()));
+            writer.write(column.name);
+            writeInteger<std::uint8_t>(static_cast<std::uint8_t>(column.type));
+        }
+    }
+}
+
+void RowExporter::writeCsvField(std::string_view text) {
+    if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+        writer.write(text);
+        return;
+    }
+    writer.put('"');
+    for (char c : text) {
+        if (c == '"') {
+            writer.put('"');
+        }
+        writer.put(c);
+    }
+    writer.put('"');
+}
+
+bool RowExporter::writeRow(const json& row) {
+    if (format == ExportFormat::JSONL) {
+        json object = json::object();
+        for (const auto& column : columns) {
+            auto it = row.find(column.name);
+            object[column.name] = it != row.end() ? *it : json();
+        }
+        writer.writeJson(object, JsonStyle::COMPACT);
+        writer.put('\n');
+        ++rows;
+        return true;
+    }
+
+    if (format == ExportFormat::CSV) {
+        for (size_t i = 0; i < columns.size(); ++i) {
+            if (i > 0) {
+                writer.put(',');
+            }
+            auto it = row.find(columns[i].name);
+            if (it == row.end() || it->is_null()) {
+                continue;
+            }
+            if (!it->is_string()) {
+                writeCsvField(it->dump());
+            } else if (it->get_ref<const std::string&>().empty()) {
+                writer.write("\"\"");
+            } else {
+                writeCsvField(it->get_ref<const std::string&>());
+            }
+        }
+        writer.put('\n');
+        ++rows;
+        return true;
+    }
+
+    std::vector<json::const_iterator> values(columns.size(), row.end());
+    std::string presence((columns.size() + 7) / 8, '\0');
+    for (size_t i = 0; i < columns.size(); ++i) {
+        auto it = row.find(columns[i].name);
+        if (it == row.end() || it->is_null()) {
+            continue;
+        }
+        if (columns[i].type == ColumnarFormat::ColumnType::INT && !it->is_number_integer()) {
+            std::cerr << "Error: Value " << it->dump() << " of column '" << columns[i].name << "' is not an int." << std::endl;
+            return false;
+        }
+        values[i] = it;
+        presence[i / 8] = static_cast<char>(presence[i / 8] | (1 << (i % 8)));
+    }
+    writer.write(presence);
+    for (size_t i = 0; i < columns.size(); ++i) {
+        if (values[i] == row.end()) {
+            continue;
+        }
+        const json& value = *values[i];
+        if (columns[i].type == ColumnarFormat::ColumnType::INT) {
+            writeInteger<std::int64_t>(value.get<std::int64_t>());
+            continue;
+        }
+        std::string text = value.is_string() ? value.get<std::string>() : value.dump();
+        writeInteger<std::uint32_t>(static_cast<std::uint32_t>(text.size()));
+        writer.write(text);
+    }
+    ++rows;
+    return true;
+}
+
+bool RowExporter::close() {
+    return writer.close();
+}
@@ -0,0 +1,67 @@
+#ifndef ROW_EXPORTER_H
+#define ROW_EXPORTER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "storageManager/columnarFormat.h"
+#include "storageManager/jsonFileWriter.h"
+
+using json = nlohmann::json;
+
+enum class ExportFormat {
+    CSV,        // header line of column names, then one record per row
+    JSONL,      // one JSON object per line
+    BINARY      // see RowExporter
+};
+
+bool stringToExportFormat(const std::string& formatString, ExportFormat& format);
+// From the extension of path: .csv, .jsonl or .ndjson, .bin.
+bool exportFormatFromPath(const std::string& path, ExportFormat& format);
+
+// Writes rows to a file one at a time through the JsonFileWriter buffer, so memory use does
+// not depend on the number of rows. Like every file the writer produces, the export only
+// appears at its path once close() succeeds.
+//
+// CSV fields holding a comma, quote or line break are quoted with doubled quotes inside. A
+// missing value is an empty field and an empty string is "", as .import reads them back.
+//
+// The binary format is little endian, like the columnar format:
+//   header : magic "CJDBEXP1", u32 version, u32 column count, then per column
+//            str name, u8 type (ColumnarFormat::ColumnType)
+//   row    : presence bitmap of ceil(columns / 8) bytes (bit set = value present), then
+//            per present value  int -> i64, string/date -> str
+// str is a u32 length followed by the bytes. Rows follow the header up to the end of file.
+class RowExporter {
+public:
+    static constexpr char MAGIC[8] = {'C', 'J', 'D', 'B', 'E', 'X', 'P', '1'};
+    static constexpr std::uint32_t VERSION = 1;
+
+    struct Column {
+        std::string name;
+        ColumnarFormat::ColumnType type;
+    };
+
+    RowExporter(const std::string& path, ExportFormat format, std::vector<Column> columns);
+
+    bool isOpen() const { return writer.isOpen(); }
+    // Writes the values row holds for the columns; other members are ignored. False when a
+    // value does not fit the column type of the binary format.
+    bool writeRow(const json& row);
+    bool close();
+    size_t rowCount() const { return rows; }
+
+private:
+    void writeHeader();
+    void writeCsvField(std::string_view text);
+    template <typename T>
+    void writeInteger(T value);
+
+    JsonFileWriter writer;
+    ExportFormat format;
+    std::vector<Column> columns;
+    size_t rows = 0;
+};
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef SLOTTED_PAGE_H
+#define SLOTTED_PAGE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+constexpr size_t PAGE_SIZE = 4096;
+
+// Slotted page: a fixed header, a slot directory growing up from the header and
+// record bytes growing down from the end of the page.
+//
+//   header : u32 reserved, u16 slot count, u16 free start, u16 free end, u16 live records, u32 reserved
+//   slot   : u16 record offset (0 = empty slot), u16 record length
+//
+// Slot numbers stay stable while a record lives, so (page, slot) identifies a row.
+class SlottedPage {
+public:
+    static constexpr size_t HEADER_SIZE = 16;
+    static constexpr size_t SLOT_SIZE = 4;
+    static constexpr size_t MAX_RECORD_SIZE = PAGE_SIZE - HEADER_SIZE - SLOT_SIZE;
+
+    explicit SlottedPage(char* data) : data(data) {}
+
+    void init() {
+        std::memset(data, 0, PAGE_SIZE);
+        setU16(6, HEADER_SIZE);
+        setU16(8, PAGE_SIZE);
+    }
+
+    std::uint16_t slotCount() const { return getU16(4); }
+    std::uint16_t liveCount() const { return getU16(10); }
+
+    // Bytes available to a new record, counting space reclaimable by compaction.
+    size_t freeSpace() const {
+        size_t used = HEADER_SIZE + slotCount() * SLOT_SIZE;
+        for (std::uint16_t slot = 0; slot < slotCount(); ++slot) {
+            used += slotLength(slot);
+        }
+        return PAGE_SIZE - used;
+    }
+
+    bool get(std::uint16_t slot, std::string_view& record) const {
+        if (slot >= slotCount() || slotOffset(slot) == 0) {
+            return false;
+        }
+        record = std::string_view(data + slotOffset(slot), slotLength(slot));
+        return true;
+    }
+
+    // Returns the slot used, or -1 when the record does not fit.
+    int insert(std::string_view record) {
+        int slot = -1;
+        for (std::uint16_t i = 0; i < slotCount(); ++i) {
+            if (slotOffset(i) == 0) {
+                slot = i;
+                break;
+            }
+        }
+        size_t needed = record.size() + (slot < 0 ? SLOT_SIZE : 0);
+        if (record.empty() || needed > freeSpace()) {
+            return -1;
+        }
+        if (needed > contiguousFree()) {
+            compact();
+        }
+        if (slot < 0) {
+            slot = slotCount();
+            setU16(4, slotCount() + 1);
+            setU16(6, HEADER_SIZE + slotCount() * SLOT_SIZE);
+            setSlot(slot, 0, 0);
+        }
+        place(slot, record);
+        setU16(10, liveCount() + 1);
+        return slot;
+    }
+
+    // Replaces a record, keeping its slot. Leaves the page untouched and returns false when it does not fit.
+    bool update(std::uint16_t slot, std::string_view record) {
+        if (slot >= slotCount() || slotOffset(slot) == 0 || record.empty()) {
+            return false;
+        }
+        if (record.size() <= slotLength(slot)) {
+            std::memcpy(data + slotOffset(slot), record.data(), record.size());
+            setSlot(slot, slotOffset(slot), record.size());
+            return true;
+        }
+        if (record.size() > freeSpace() + slotLength(slot)) {
+            return false;
+        }
+        setSlot(slot, 0, 0);
+        if (record.size() > contiguousFree()) {
+            compact();
+        }
+        place(slot, record);
+        return true;
+    }
+
+    void erase(std::uint16_t slot) {
+        if (slot >= slotCount() || slotOffset(slot) == 0) {
+            return;
+        }
+        setSlot(slot, 0, 0);
+        setU16(10, liveCount() - 1);
+    }
+
+private:
+    size_t contiguousFree() const { return getU16(8) - getU16(6); }
+
+    std::uint16_t slotOffset(std::uint16_t slot) const { return getU16(HEADER_SIZE + slot * SLOT_SIZE); }
+    std::uint16_t slotLength(std::uint16_t slot) const { return getU16(HEADER_SIZE + slot * SLOT_SIZE + 2); }
+    void setSlot(std::uint16_t slot, size_t offset, size_t length) {
+        setU16(HEADER_SIZE + slot * SLOT_SIZE, offset);
+        setU16(HEADER_SIZE + slot * SLOT_SIZE + 2, length);
+    }
+
+    void place(std::uint16_t slot, std::string_view record) {
+        size_t offset = getU16(8) - record.size();
+        std::memcpy(data + offset, record.data(), record.size());
+        setU16(8, offset);
+        setSlot(slot, offset, record.size());
+    }
+
+    // Slides live records to the end of the page so all free space is contiguous.
+    void compact() {
+        char copy[PAGE_SIZE];
+        std::memcpy(copy, data, PAGE_SIZE);
+        size_t freeEnd = PAGE_SIZE;
+        for (std::uint16_t slot = 0; slot < slotCount(); ++slot) {
+            if (slotOffset(slot) == 0) {
+                continue;
+            }
+            size_t length = slotLength(slot);
+            freeEnd -= length;
+            std::memcpy(data + freeEnd, copy + slotOffset(slot), length);
+            setSlot(slot, freeEnd, length);
+        }
+        setU16(8, freeEnd);
+    }
+
+    std::uint16_t getU16(size_t offset) const {
+        std::uint16_t value;
+        std::memcpy(&value, data + offset, sizeof(value));
+        return value;
+    }
+    void setU16(size_t offset, size_t value) {
+        std::uint16_t v = static_cast<std::uint16_t>(value);
+        std::memcpy(data + offset, &v, sizeof(v));
+    }
+
+    char* data;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "storageManager/snapshotFile.h"
+#include <iostream>
+#include <filesystem>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <cstdlib>
+#include <unistd.h>
+
+int SnapshotFile::open(const std::string& path, std::string& tempPath) {
+    std::string name = path + ".XXXXXX";
+    int fd = ::mkostemp(name.data(), O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Error: Failed to create a temporary file for '" << path << "': " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    // mkostemp creates the file readable by its owner only.
+    ::fchmod(fd, 0644);
+    tempPath = std::move(name);
+    return fd;
+}
+
+bool SnapshotFile::commit(int fd, const std::string& tempPath, const std::string& path) {
+    if (::fsync(fd) != 0) {
+        std::cerr << "Error: Failed to sync file '" << tempPath << "': " << std::strerror(errno) << std::endl;
+        abort(fd, tempPath);
+        return false;
+    }
+    if (::close(fd) != 0) {
+        std::cerr << "Error: Failed to close file '" << tempPath << "': " << std::strerror(errno) << std::endl;
+        ::unlink(tempPath.c_str());
+        return false;
+    }
+    if (::rename(tempPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: Failed to replace file '" << path << "': " << std::strerror(errno) << std::endl;
+        ::unlink(tempPath.c_str());
+        return false;
+    }
+
+    std::string directory = std::filesystem::path(path).parent_path().string();
+    int directoryFd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (directoryFd >= 0) {
+        ::fsync(directoryFd);
+        ::close(directoryFd);
+    }
+    return true;
+}
+
+void SnapshotFile::abort(int fd, const std::string& tempPath) {
+    ::close(fd);
+    ::unlink(tempPath.c_str());
+}
+
+bool SnapshotFile::write(const std::string& path, std::string_view data) {
+    std::string tempPath;
+    int fd = open(path, tempPath);
+    if (fd < 0) {
+        return false;
+    }
+    while (!data.empty()) {
+        ssize_t written = ::write(fd, data.data(), data.size());
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            std::cerr << "Error: Failed to write file '" << tempPath << "': " << std::strerror(errno) << std::endl;
+            abort(fd, tempPath);
+            return false;
+        }
+        data.remove_prefix(static_cast<size_t>(written));
+    }
+    return commit(fd, tempPath, path);
+}
@@ -0,0 +1,22 @@
+#ifndef SNAPSHOT_FILE_H
+#define SNAPSHOT_FILE_H
+
+#include <string>
+#include <string_view>
+
+// Durable whole-file replacement. The new content is written to a temporary file with a
+// unique name next to the target, fsynced and renamed over the old file, then the directory
+// is fsynced so the rename itself survives a crash. Readers opening the path always see
+// either the previous or the new version, and concurrent writers of one path never share a
+// temporary file.
+namespace SnapshotFile {
+    // Creates (path).XXXXXX and stores its name in tempPath; returns -1 on failure.
+    int open(const std::string& path, std::string& tempPath);
+    // Syncs and closes fd, then renames the temporary file into place.
+    bool commit(int fd, const std::string& tempPath, const std::string& path);
+    // Closes fd and removes the temporary file.
+    void abort(int fd, const std::string& tempPath);
+    bool write(const std::string& path, std::string_view data);
+}
+
+#endif
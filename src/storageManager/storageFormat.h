@@ -0,0 +1,72 @@
+#ifndef STORAGE_FORMAT_H
+#define STORAGE_FORMAT_H
+
+#include <string>
+#include <stdexcept>
+
+// Each database is a directory holding schema.json and one rows file per table,
+// data/databases/(databasename)/(tablename).(extension), in the format chosen for the database.
+enum class StorageFormat {
+    JSON,       // (tablename).rows.json
+    COLUMNAR,   // (tablename).bin
+    PAGED       // (tablename).pages
+};
+
+inline std::string storageFormatToString(StorageFormat format) {
+    switch (format) {
+        case StorageFormat::JSON:
+            return "json";
+        case StorageFormat::COLUMNAR:
+            return "columnar";
+        case StorageFormat::PAGED:
+            return "paged";
+        default:
+            throw std::invalid_argument("Unknown storage format value");
+    }
+}
+
+inline StorageFormat stringToStorageFormat(const std::string& formatString) {
+    if (formatString == "json") {
+        return StorageFormat::JSON;
+    } else if (formatString == "columnar") {
+        return StorageFormat::COLUMNAR;
+    } else if (formatString == "paged") {
+        return StorageFormat::PAGED;
+    }
+    throw std::invalid_argument("Unknown storage format: " + formatString);
+}
+
+// JSON and columnar table files are only ever replaced whole, as snapshots, so they can be
+// read without the database lock. Paged tables are updated page by page in place.
+inline bool usesSnapshotWrites(StorageFormat format) {
+    return format != StorageFormat::PAGED;
+}
+
+// Database and table names become directory and file names, so a name holding a path
+// separator or ".." could reach outside data/databases and is rejected.
+inline bool isValidStorageName(const std::string& name) {
+    return !name.empty() && name.find('/') == std::string::npos && name.find('\\') == std::string::npos &&
+           name.find("..") == std::string::npos && name.find('\0') == std::string::npos;
+}
+
+inline std::string databaseDirectory(const std::string& databaseName) {
+    return "data/databases/" + databaseName;
+}
+
+inline std::string schemaFilePath(const std::string& databaseName) {
+    return databaseDirectory(databaseName) + "/schema.json";
+}
+
+inline std::string tableFilePath(const std::string& databaseName, const std::string& tableName, StorageFormat format) {
+    switch (format) {
+        case StorageFormat::COLUMNAR:
+            return databaseDirectory(databaseName) + "/" + tableName + ".bin";
+        case StorageFormat::PAGED:
+            return databaseDirectory(databaseName) + "/" + tableName + ".pages";
+        case StorageFormat::JSON:
+        default:
+            return databaseDirectory(databaseName) + "/" + tableName + ".rows.json";
+    }
+}
+
+#endif
@@ -0,0 +1,163 @@
+#include "storageManager/tombstoneFile.h"
+#include "storageManager/snapshotFile.h"
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace {
+
+constexpr char MAGIC[8] = {'C', 'J', 'D', 'B', 'T', 'M', 'B', '1'};
+constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 3 * sizeof(std::uint64_t);
+
+void appendU64(std::string& out, std::uint64_t value) {
+    for (int shift = 0; shift < 64; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+std::uint64_t readU64(const char* data) {
+    std::uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | static_cast<unsigned char>(data[i]);
+    }
+    return value;
+}
+
+// The header a tombstone file for the rows file must carry to be current.
+bool expectedHeader(const std::string& rowsPath, std::string& header) {
+    struct stat info;
+    if (::stat(rowsPath.c_str(), &info) != 0) {
+        return false;
+    }
+    header.assign(MAGIC, sizeof(MAGIC));
+    appendU64(header, static_cast<std::uint64_t>(info.st_ino));
+    appendU64(header, static_cast<std::uint64_t>(info.st_size));
+    appendU64(header, static_cast<std::uint64_t>(info.st_mtim.tv_sec) * 1000000000ull + static_cast<std::uint64_t>(info.st_mtim.tv_nsec));
+    return true;
+}
+
+bool readAll(int fd, std::string& content) {
+    char chunk[4096];
+    for (;;) {
+        ssize_t count = ::read(fd, chunk, sizeof(chunk));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            return false;
+        }
+        if (count == 0) {
+            return true;
+        }
+        content.append(chunk, static_cast<size_t>(count));
+    }
+}
+
+bool writeAll(int fd, const std::string& data) {
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ssize_t written = ::write(fd, data.data() + offset, data.size() - offset);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        offset += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+}
+
+std::string TombstoneFile::path(const std::string& rowsPath) {
+    return rowsPath + ".tomb";
+}
+
+// A record cut short by a crash during append is ignored.
+bool TombstoneFile::read(const std::string& rowsPath, std::vector<std::uint64_t>& deleted) {
+    deleted.clear();
+    int fd = ::open(path(rowsPath).c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return errno == ENOENT;
+    }
+    std::string content;
+    bool success = readAll(fd, content);
+    ::close(fd);
+    if (!success) {
+        std::cerr << "Error: Failed to read tombstone file '" << path(rowsPath) << "'." << std::endl;
+        return false;
+    }
+
+    std::string header;
+    if (!expectedHeader(rowsPath, header) || content.compare(0, HEADER_SIZE, header) != 0) {
+        return true;
+    }
+    for (size_t offset = HEADER_SIZE; offset + sizeof(std::uint64_t) <= content.size(); offset += sizeof(std::uint64_t)) {
+        deleted.push_back(readU64(content.data() + offset));
+    }
+    return true;
+}
+
+bool TombstoneFile::append(const std::string& rowsPath, const std::vector<std::uint64_t>& deleted) {
+    std::string header;
+    if (!expectedHeader(rowsPath, header)) {
+        std::cerr << "Error: Failed to stat rows file '" << rowsPath << "'." << std::endl;
+        return false;
+    }
+    std::string records;
+    for (std::uint64_t index : deleted) {
+        appendU64(records, index);
+    }
+
+    const std::string tombPath = path(rowsPath);
+    std::string current;
+    int fd = ::open(tombPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        current.resize(HEADER_SIZE);
+        ssize_t count = ::pread(fd, current.data(), HEADER_SIZE, 0);
+        current.resize(count > 0 ? static_cast<size_t>(count) : 0);
+        ::close(fd);
+    }
+
+    // A missing or stale file is replaced whole, so readers never see a header without records.
+    if (current != header) {
+        return SnapshotFile::write(tombPath, header + records);
+    }
+
+    fd = ::open(tombPath.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Error: Failed to open tombstone file '" << tombPath << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    // Drop a partial record left by an interrupted append, so new records stay aligned.
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && (static_cast<size_t>(info.st_size) - HEADER_SIZE) % sizeof(std::uint64_t) != 0) {
+        off_t aligned = static_cast<off_t>(HEADER_SIZE + (static_cast<size_t>(info.st_size) - HEADER_SIZE) / sizeof(std::uint64_t) * sizeof(std::uint64_t));
+        if (::ftruncate(fd, aligned) != 0) {
+            ::close(fd);
+            return false;
+        }
+    }
+    bool success = writeAll(fd, records) && ::fsync(fd) == 0;
+    ::close(fd);
+    if (!success) {
+        std::cerr << "Error: Failed to write tombstone file '" << tombPath << "'." << std::endl;
+    }
+    return success;
+}
+
+void TombstoneFile::apply(json& rows, const std::vector<std::uint64_t>& deleted) {
+    for (std::uint64_t index : deleted) {
+        if (index < rows.size()) {
+            rows[index] = nullptr;
+        }
+    }
+}
+
+void TombstoneFile::remove(const std::string& rowsPath) {
+    ::unlink(path(rowsPath).c_str());
+}
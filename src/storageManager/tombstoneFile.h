@@ -0,0 +1,32 @@
+#ifndef TOMBSTONE_FILE_H
+#define TOMBSTONE_FILE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+// Rows deleted from a JSON rows file since it was last written, kept in (rows file).tomb so a
+// DELETE appends a few bytes instead of rewriting the table. Readers null those rows after
+// parsing; the next full write of the table (INSERT, UPDATE, compaction) folds them in.
+//
+//   header : magic "CJDBTMB1", then the u64 inode, u64 size and i64 mtime in nanoseconds
+//            of the rows file the tombstones belong to
+//   record : u64 row index
+//
+// All integers are little endian. Rewriting the rows file changes its stamp, which makes an
+// older tombstone file stale: it is ignored and replaced by the next DELETE.
+namespace TombstoneFile {
+    std::string path(const std::string& rowsPath);
+    // Indices deleted from rowsPath as it is now; empty when there is no current tombstone file.
+    bool read(const std::string& rowsPath, std::vector<std::uint64_t>& deleted);
+    // Records deleted rows of rowsPath and syncs them to disk.
+    bool append(const std::string& rowsPath, const std::vector<std::uint64_t>& deleted);
+    // Replaces the listed rows with null, ignoring indices past the end.
+    void apply(json& rows, const std::vector<std::uint64_t>& deleted);
+    void remove(const std::string& rowsPath);
+}
+
+#endif
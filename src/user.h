@@ -6,6 +6,8 @@
 struct User {
     std::string username;
     std::string encryptedPassword;
+    // Administrators may change process-wide settings such as the log, the buffer pool and compaction.
+    bool admin = false;
 };
 
 #endif
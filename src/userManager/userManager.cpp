@@ -20,7 +20,7 @@ bool UserManager::createUser(const std::string& username, const std::string& pas
         return false;
     }
 
-    users[username] = { username, encryptedPassword };
+    users[username] = { username, encryptedPassword, false };
     saveToFile();
     return true;
 }
@@ -39,12 +39,20 @@ bool UserManager::login(const std::string& username, const std::string& password
     
 }
 
+bool UserManager::isAdmin(const std::string& username) const {
+    auto it = users.find(username);
+    return it != users.end() && it->second.admin;
+}
+
 void UserManager::saveToFile() {
     json j;
     for (const auto& pair : users) {
         json userJson;
         userJson["username"] = pair.second.username;
         userJson["encryptedPassword"] = pair.second.encryptedPassword;
+        if (pair.second.admin) {
+            userJson["admin"] = true;
+        }
         j[pair.first] = userJson;
     }
 
@@ -73,7 +81,8 @@ bool UserManager::loadFromFile() {
     for (json::iterator it = j.begin(); it != j.end(); ++it) {
         std::string username = it.key();
         std::string encryptedPassword = it.value()["encryptedPassword"];
-        users[username] = { username, encryptedPassword };
+        bool admin = it.value().value("admin", false);
+        users[username] = { username, encryptedPassword, admin };
     }
 
     return true;
@@ -23,6 +23,7 @@ public:
     UserManager& operator=(const UserManager&) = delete;
     bool createUser(const std::string& username, const std::string& password);
     bool login(const std::string& username, const std::string& password);
+    bool isAdmin(const std::string& username) const;
 private:
     UserManager();
     std::unordered_map<std::string, User> users;
@@ -0,0 +1,81 @@
+// Drives libcppjsondb for the library scenario: opens sessions, runs statements and prints
+// what the ResultSets hold, one check per line. Run in a directory holding a data/ copy.
+#include "library/database.h"
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+void printRows(const cppjsondb::ResultSet& result) {
+    std::cout << "rows " << result.rowCount() << ":";
+    for (const auto& column : result.columns()) {
+        std::cout << ' ' << column.name;
+    }
+    std::cout << std::endl;
+    auto cursor = result.cursor();
+    while (cursor.next()) {
+        for (size_t column = 0; column < result.columns().size(); ++column) {
+            long long number = 0;
+            std::string text;
+            if (cursor.isNull(column)) {
+                std::cout << "  NULL";
+            } else if (cursor.getInt(column, number)) {
+                std::cout << "  " << number;
+            } else if (cursor.getString(column, text)) {
+                std::cout << "  " << text;
+            }
+        }
+        std::cout << std::endl;
+    }
+}
+
+}
+
+int main() {
+    std::streambuf* original = std::cout.rdbuf();
+    std::string error;
+    {
+        auto refused = cppjsondb::Database::open("krzysztof", "wrong", "baza", error);
+        std::cout << "wrong password: " << (refused ? "opened" : error) << std::endl;
+        auto missing = cppjsondb::Database::open("krzysztof", "password", "nope", error);
+        std::cout << "missing database: " << (missing ? "opened" : error) << std::endl;
+
+        auto db = cppjsondb::Database::open("krzysztof", "password", "baza", error);
+        if (!db) {
+            std::cout << "open failed: " << error << std::endl;
+            return 1;
+        }
+        std::cout << "session: " << db->user() << " on " << db->database() << std::endl;
+
+        cppjsondb::ResultSet all = db->execute("SELECT id, name, email FROM users");
+        std::cout << "select succeeded: " << all.succeeded() << std::endl;
+        printRows(all);
+        size_t id = 0;
+        std::string text;
+        auto cursor = all.cursor();
+        cursor.next();
+        std::cout << "int read as string: " << (all.columnIndex("id", id) && cursor.getString(id, text)) << std::endl;
+
+        cppjsondb::ResultSet batch = db->execute("INSERT INTO users (name, email) values ('Lib', 'lib@x'); SELECT name FROM users WHERE id = 4");
+        std::cout << "batch succeeded: " << batch.succeeded() << std::endl;
+        printRows(batch);
+
+        cppjsondb::ResultSet empty = db->execute("SELECT name FROM users WHERE id > 100");
+        std::cout << "empty select: " << empty.hasRows() << ' ' << empty.rowCount() << std::endl;
+
+        cppjsondb::ResultSet failed = db->execute("SELECT name FROM missing");
+        std::cout << "failed select: " << failed.succeeded() << ' ' << failed.output();
+        cppjsondb::ResultSet exit = db->execute(".exit");
+        std::cout << "exit: " << exit.succeeded() << ' ' << exit.output();
+
+        std::thread other([&error] {
+            auto second = cppjsondb::Database::open("krzysztof", "password", "baza", error);
+            std::cout << "other thread sees: " << (second ? second->execute("SELECT id FROM users").rowCount() : 0) << " rows" << std::endl;
+        });
+        other.join();
+        std::cout << "stream routed while open: " << (std::cout.rdbuf() != original) << std::endl;
+    }
+    std::cout << "stream restored after close: " << (std::cout.rdbuf() == original) << std::endl;
+    return 0;
+}
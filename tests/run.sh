@@ -0,0 +1,60 @@
+#!/bin/bash
+# Runs the scenarios in tests/. Every <name>.cfg is a tests.cfg script that dbms runs in a
+# scratch copy of data/. The loader skips lines starting with '[', so those carry the checks:
+#   [setup] <shell>   runs in the scratch directory before dbms
+#   [run] <shell>     runs in the scratch directory after dbms; its output is checked too
+#   [expect] <text>   the output must contain text
+#   [reject] <text>   the output must not contain text
+# Colors are stripped from the output before it is checked. Shell lines see $DBMS, the
+# binary under test, and $TESTS, this directory.
+#
+# Usage: tests/run.sh [scenario.cfg...]   (DBMS defaults to ./dbms)
+
+TESTS=$(cd "$(dirname "$0")" && pwd)
+ROOT=$(dirname "$TESTS")
+DBMS=$(realpath "${DBMS:-$ROOT/dbms}")
+export TESTS DBMS
+
+scenarios=("$@")
+if [ ${#scenarios[@]} -eq 0 ]; then
+    scenarios=("$TESTS"/*.cfg)
+fi
+
+failures=0
+for scenario in "${scenarios[@]}"; do
+    scenario=$(realpath "$scenario")
+    name=$(basename "$scenario" .cfg)
+    scratch=$(mktemp -d "${TMPDIR:-/tmp}/dbms-$name.XXXXXX")
+    cp -r "$ROOT/data" "$scratch/"
+    cp "$scenario" "$scratch/tests.cfg"
+
+    (
+        cd "$scratch" || exit 1
+        bash -c "$(sed -n 's/^\[setup\] //p' "$scenario")"
+        timeout 60 "$DBMS"
+        bash -c "$(sed -n 's/^\[run\] //p' "$scenario")"
+    ) 2>&1 | sed 's/\x1b\[[0-9;]*m//g' > "$scratch/output"
+
+    problems=()
+    while IFS= read -r text; do
+        grep -qF -- "$text" "$scratch/output" || problems+=("missing: $text")
+    done < <(sed -n 's/^\[expect\] //p' "$scenario")
+    while IFS= read -r text; do
+        grep -qF -- "$text" "$scratch/output" && problems+=("unexpected: $text")
+    done < <(sed -n 's/^\[reject\] //p' "$scenario")
+
+    if [ ${#problems[@]} -eq 0 ]; then
+        echo "PASS $name"
+        rm -rf "$scratch"
+    else
+        echo "FAIL $name (output in $scratch/output)"
+        printf '    %s\n' "${problems[@]}"
+        failures=$((failures + 1))
+    fi
+done
+
+if [ $failures -gt 0 ]; then
+    echo "$failures of ${#scenarios[@]} scenarios failed"
+    exit 1
+fi
+echo "All ${#scenarios[@]} scenarios passed"
@@ -0,0 +1,253 @@
+// Client for the server scenarios. Connects to unix:<path> or tcp:<host>:<port>, sends its
+// standard input, closes its side of the connection and prints what the server sends back
+// until the server closes it too. With --binary every input line is sent as a QUERY frame
+// of the binary protocol, and each response frame is printed as a line: COLUMNS with
+// name:type pairs, BATCH with its row count followed by a tab-separated line per row, and
+// DONE with its status and text. Usage: serverClient <address> [--binary]
+#include "server/wireProtocol.h"
+#include "storageManager/columnarFormat.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+int connectTo(const std::string& address) {
+    if (address.starts_with("unix:")) {
+        std::string path = address.substr(5);
+        sockaddr_un socketAddress{};
+        if (path.empty() || path.size() >= sizeof(socketAddress.sun_path)) {
+            return -1;
+        }
+        socketAddress.sun_family = AF_UNIX;
+        std::memcpy(socketAddress.sun_path, path.c_str(), path.size() + 1);
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) < 0) {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+    if (!address.starts_with("tcp:") || address.rfind(':') == 3) {
+        return -1;
+    }
+    size_t colon = address.rfind(':');
+    std::string host = address.substr(4, colon - 4);
+    std::string port = address.substr(colon + 1);
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+        return -1;
+    }
+    int fd = -1;
+    for (addrinfo* candidate = addresses; candidate && fd < 0; candidate = candidate->ai_next) {
+        fd = socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+        if (fd >= 0 && connect(fd, candidate->ai_addr, candidate->ai_addrlen) < 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    return fd;
+}
+
+bool writeAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t count = write(fd, data.data() + sent, data.size() - sent);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+std::string readAll(int fd) {
+    std::string received;
+    char buffer[64 * 1024];
+    for (;;) {
+        ssize_t count = read(fd, buffer, sizeof(buffer));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return received;
+        }
+        received.append(buffer, static_cast<size_t>(count));
+    }
+}
+
+void appendU32(std::string& out, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xFF));
+    }
+}
+
+// Reads a little endian integer of size bytes at offset and moves past it; false at the end
+// of data.
+bool readInteger(std::string_view data, size_t& offset, size_t size, std::uint64_t& value) {
+    if (data.size() - offset < size) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = size; i-- > 0;) {
+        value = (value << 8) | static_cast<unsigned char>(data[offset + i]);
+    }
+    offset += size;
+    return true;
+}
+
+bool readString(std::string_view data, size_t& offset, std::string& value) {
+    std::uint64_t length = 0;
+    if (!readInteger(data, offset, 4, length) || data.size() - offset < length) {
+        return false;
+    }
+    value.assign(data.substr(offset, length));
+    offset += length;
+    return true;
+}
+
+std::string encodeQueries(const std::string& input) {
+    std::string frames;
+    size_t start = 0;
+    while (start < input.size()) {
+        size_t end = input.find('\n', start);
+        if (end == std::string::npos) {
+            end = input.size();
+        }
+        appendU32(frames, static_cast<std::uint32_t>(end - start + 1));
+        frames.push_back(static_cast<char>(WireProtocol::RequestType::QUERY));
+        frames.append(input, start, end - start);
+        start = end + 1;
+    }
+    return frames;
+}
+
+// Prints the response frames in data as text; false when a frame is cut short or malformed.
+bool printResponses(std::string_view data, std::ostream& out) {
+    using ColumnType = ColumnarFormat::ColumnType;
+    std::vector<ColumnType> types;
+    size_t offset = 0;
+    while (offset < data.size()) {
+        std::uint64_t length = 0;
+        if (!readInteger(data, offset, 4, length) || length == 0 || data.size() - offset < length) {
+            return false;
+        }
+        std::string_view frame = data.substr(offset + 1, length - 1);
+        auto type = static_cast<WireProtocol::ResponseType>(data[offset]);
+        offset += length;
+        size_t at = 0;
+        std::uint64_t count = 0;
+        if (type == WireProtocol::ResponseType::COLUMNS) {
+            if (!readInteger(frame, at, 4, count)) {
+                return false;
+            }
+            types.clear();
+            out << "COLUMNS";
+            for (std::uint64_t i = 0; i < count; ++i) {
+                std::string name;
+                std::uint64_t columnType = 0;
+                if (!readString(frame, at, name) || !readInteger(frame, at, 1, columnType)) {
+                    return false;
+                }
+                types.push_back(static_cast<ColumnType>(columnType));
+                out << ' ' << name << ':' << (types.back() == ColumnType::INT ? "int" : types.back() == ColumnType::DATE ? "date" : "string");
+            }
+            out << '\n';
+        } else if (type == WireProtocol::ResponseType::BATCH) {
+            if (!readInteger(frame, at, 4, count)) {
+                return false;
+            }
+            std::vector<std::vector<std::string>> cells(count, std::vector<std::string>(types.size(), "NULL"));
+            size_t bitmapSize = (count + 7) / 8;
+            for (size_t column = 0; column < types.size(); ++column) {
+                if (frame.size() - at < bitmapSize) {
+                    return false;
+                }
+                std::string_view presence = frame.substr(at, bitmapSize);
+                at += bitmapSize;
+                for (size_t row = 0; row < count; ++row) {
+                    if (!(static_cast<unsigned char>(presence[row / 8]) & (1u << (row % 8)))) {
+                        continue;
+                    }
+                    std::uint64_t number = 0;
+                    if (types[column] == ColumnType::INT) {
+                        if (!readInteger(frame, at, 8, number)) {
+                            return false;
+                        }
+                        cells[row][column] = std::to_string(static_cast<std::int64_t>(number));
+                    } else if (!readString(frame, at, cells[row][column])) {
+                        return false;
+                    }
+                }
+            }
+            out << "BATCH " << count << '\n';
+            for (const auto& row : cells) {
+                for (size_t column = 0; column < row.size(); ++column) {
+                    out << (column > 0 ? "\t" : "") << row[column];
+                }
+                out << '\n';
+            }
+        } else if (type == WireProtocol::ResponseType::DONE && !frame.empty()) {
+            out << "DONE " << static_cast<int>(static_cast<unsigned char>(frame[0])) << ' ' << frame.substr(1);
+            if (frame.size() == 1 || frame.back() != '\n') {
+                out << '\n';
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    bool binary = argc == 3 && std::string(argv[2]) == "--binary";
+    if (argc != 2 && !binary) {
+        std::cerr << "Usage: " << argv[0] << " <unix:path | tcp:host:port> [--binary]" << std::endl;
+        return 1;
+    }
+    int fd = connectTo(argv[1]);
+    if (fd < 0) {
+        std::cerr << "Error: Failed to connect to '" << argv[1] << "'." << std::endl;
+        return 1;
+    }
+
+    std::string request(std::istreambuf_iterator<char>(std::cin), {});
+    if (binary) {
+        request = encodeQueries(request);
+    }
+    if (!writeAll(fd, request)) {
+        std::cerr << "Error: Failed to send the request." << std::endl;
+        close(fd);
+        return 1;
+    }
+    shutdown(fd, SHUT_WR);
+    std::string response = readAll(fd);
+    close(fd);
+    if (!binary) {
+        std::cout << response;
+        return 0;
+    }
+    if (!printResponses(response, std::cout)) {
+        std::cerr << "Error: Malformed response frame." << std::endl;
+        return 1;
+    }
+    return 0;
+}